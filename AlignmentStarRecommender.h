@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoordsUtils.h"
+#include "Visibility.h"
+#include "CelestialObjects/Stars/Stars.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace coords {
+
+struct StarPair {
+	uint16_t first;
+	uint16_t second;
+	float score;
+};
+
+// Scores pairs of `STARS` for two star alignment. Single star score combines altitude (away from horizon
+// refraction and from zenith where AZ axis turns fast) with brightness. Pair score adds separation and how
+// well conditioned the pair is for the alignment model: it uses line through both stars in RA/Dec plane,
+// so stars need to differ in RA and stay away from the pole.
+// Only CANDIDATES best single stars are paired and pairs that cannot beat the current worst result are
+// skipped, so the cost does not grow with N^2.
+class AlignmentStarRecommender {
+public:
+	static constexpr const std::size_t N = STARS.size();
+	static constexpr const std::size_t CANDIDATES = 24;
+	static constexpr const std::size_t PAIRS = 5;
+	static constexpr const float MIN_ALTITUDE_DEG = 20;
+	static constexpr const float BEST_ALTITUDE_DEG = 50;
+	static constexpr const float FAINTEST_MAGNITUDE = 3;
+
+	AlignmentStarRecommender() {
+		for (std::size_t i = 0; i < N; ++i) {
+			// brightest star (about -1.5 mag) scores 1, FAINTEST_MAGNITUDE scores 0.5
+			brightness_[i] = std::max(0.0f, 1 - (STARS.magnitude_[i] + 1.5f) / (2 * (FAINTEST_MAGNITUDE + 1.5f)));
+		}
+	}
+
+	// Returns number of pairs found, best first in `pairs_`
+	std::size_t update(const Site& site, double unixSeconds, const HorizonMask& mask) {
+		HorizonFrame frame(site, unixSeconds);
+		for (std::size_t i = 0; i < N; ++i) {
+			auto v = STARS.vector(i);
+			auto altitude = std::asin(dot(frame.zenith, v));
+			auto azimuth = std::atan2(dot(frame.east, v), dot(frame.north, v));
+			auto visible = std::sin(altitude) >= mask.minAltitudeSin(azimuth < 0 ? azimuth + static_cast<float>(TWO_PI) : azimuth);
+			singleScore_[i] = visible ? altitudeScore(altitude) * (0.5f + 0.5f * brightness_[i]) : 0;
+		}
+
+		std::array<uint16_t, N> order;
+		for (std::size_t i = 0; i < N; ++i) {
+			order[i] = i;
+		}
+		std::partial_sort(order.begin(), order.begin() + CANDIDATES, order.end(),
+				[this](uint16_t a, uint16_t b) { return singleScore_[a] > singleScore_[b]; });
+		candidateCount_ = 0;
+		while (candidateCount_ < CANDIDATES && singleScore_[order[candidateCount_]] > 0) {
+			candidates_[candidateCount_] = order[candidateCount_];
+			++candidateCount_;
+		}
+
+		pairCount_ = 0;
+		for (std::size_t a = 0; a < candidateCount_; ++a) {
+			for (std::size_t b = a + 1; b < candidateCount_; ++b) {
+				auto first = candidates_[a];
+				auto second = candidates_[b];
+				// candidates are sorted and pair factor is at most 1, nothing better is left for this `a`
+				if (pairCount_ == PAIRS && singleScore_[first] * singleScore_[second] <= pairs_[PAIRS - 1].score) {
+					break;
+				}
+				insertPair({first, second, singleScore_[first] * singleScore_[second] * pairScore(first, second)});
+			}
+		}
+		return pairCount_;
+	}
+
+	// Best partners for already chosen `first` star, returns number of written indices
+	template<std::size_t K>
+	std::size_t bestPartners(uint16_t first, std::array<uint16_t, K>& result) const {
+		std::array<float, N> scores;
+		std::array<uint16_t, N> order;
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			scores[i] = i == first ? 0 : singleScore_[i] * pairScore(first, i);
+			if (scores[i] > 0) {
+				order[count++] = i;
+			}
+		}
+		auto resultCount = std::min(count, K);
+		std::partial_sort(order.begin(), order.begin() + resultCount, order.begin() + count,
+				[&scores](uint16_t a, uint16_t b) { return scores[a] > scores[b]; });
+		std::copy(order.begin(), order.begin() + resultCount, result.begin());
+		return resultCount;
+	}
+
+	std::size_t pairCount() const { return pairCount_; }
+	const StarPair& pair(std::size_t i) const { return pairs_[i]; }
+
+private:
+	static float dot(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	static float altitudeScore(float altitudeRad) {
+		static constexpr const float minAltitude = MIN_ALTITUDE_DEG * DEG_TO_RAD;
+		static constexpr const float bestAltitude = BEST_ALTITUDE_DEG * DEG_TO_RAD;
+		if (altitudeRad < minAltitude) {
+			return 0;
+		}
+		if (altitudeRad < bestAltitude) {
+			return 0.2f + 0.8f * (altitudeRad - minAltitude) / (bestAltitude - minAltitude);
+		}
+		return 1 - 0.8f * (altitudeRad - bestAltitude) / (static_cast<float>(HALF_PI) - bestAltitude);
+	}
+
+	float pairScore(std::size_t first, std::size_t second) const {
+		auto a = STARS.vector(first);
+		auto b = STARS.vector(second);
+		// separation: best at 90 degrees
+		auto cosSeparation = dot(a, b);
+		auto separationScore = std::sqrt(std::max(0.0f, 1 - cosSeparation * cosSeparation));
+		// conditioning: RA difference (slope of the line between stars) and distance from the pole
+		auto raScore = std::fabs(std::sin(STARS.ra_[first] - STARS.ra_[second]));
+		auto poleScore = std::sqrt(std::max(0.0f, 1 - std::max(a[2] * a[2], b[2] * b[2])));
+		return separationScore * raScore * poleScore;
+	}
+
+	void insertPair(StarPair pair) {
+		if (pair.score <= 0 || (pairCount_ == PAIRS && pair.score <= pairs_[PAIRS - 1].score)) {
+			return;
+		}
+		std::size_t slot = pairCount_ < PAIRS ? pairCount_++ : PAIRS - 1;
+		while (slot > 0 && pairs_[slot - 1].score < pair.score) {
+			pairs_[slot] = pairs_[slot - 1];
+			--slot;
+		}
+		pairs_[slot] = pair;
+	}
+
+	std::array<float, N> brightness_;
+	std::array<float, N> singleScore_{};
+	std::array<uint16_t, CANDIDATES> candidates_;
+	std::size_t candidateCount_ = 0;
+	std::array<StarPair, PAIRS> pairs_;
+	std::size_t pairCount_ = 0;
+};
+
+}
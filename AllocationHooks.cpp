@@ -0,0 +1,50 @@
+// Replaces the global operator new and delete to count allocations per region, see HeapTracker.h
+
+#include "HeapTracker.h"
+
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t size) {
+	auto* pointer = std::malloc(size == 0 ? 1 : size);
+	if (pointer == nullptr) {
+		throw std::bad_alloc();
+	}
+	heap::tracker().allocated(size);
+	return pointer;
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	auto* pointer = std::malloc(size == 0 ? 1 : size);
+	if (pointer != nullptr) {
+		heap::tracker().allocated(size);
+	}
+	return pointer;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+	return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept {
+	if (pointer != nullptr) {
+		heap::tracker().freed();
+		std::free(pointer);
+	}
+}
+
+void operator delete[](void* pointer) noexcept {
+	operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+	operator delete(pointer);
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Print.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+namespace bench {
+
+// Keeps the compiler from dropping a computation whose result is not used
+template<typename T>
+inline void keep(const T& value) {
+	asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Times code with a free running counter: ESP32 cycle counter on the board, steady clock on the host. A batch of
+// iterations is grown until it takes `sampleNs`, then `samples` batches are timed and reported per iteration as
+// one JSON object per line, bench_compare.py compares two runs:
+//   {"benchmark":"coords.rotatePoint","platform":"esp32","iterations":2048,"samples":21,"min_ns":..,
+//    "median_ns":..,"mean_ns":..,"max_ns":..,"stddev_ns":..}
+class Runner {
+public:
+	static constexpr const std::size_t MAX_SAMPLES = 63;
+	static constexpr const uint32_t MAX_ITERATIONS = 1u << 24;
+
+	// counter ticks, differences are taken modulo 2^32
+	using Clock = uint32_t (*)();
+
+	struct Options {
+		const char* platform;
+		Clock clock;
+		double nsPerTick;
+		uint32_t sampleNs = 1000000;
+		std::size_t samples = 21;
+		// runs only benchmarks whose name starts with it
+		const char* filter = nullptr;
+		// between benchmarks, eg. to let lower priority tasks run
+		void (*pause)() = nullptr;
+	};
+
+	Runner(Print& out, const Options& options) : out_(out), options_(options) {
+		options_.samples = std::max<std::size_t>(1, std::min(options_.samples, MAX_SAMPLES));
+	}
+
+	bool selected(const char* name) const {
+		return options_.filter == nullptr || std::strncmp(name, options_.filter, std::strlen(options_.filter)) == 0;
+	}
+
+	// `body(i)` is one iteration, `i` counts iterations of the batch so inputs can vary
+	template<typename Body>
+	void run(const char* name, Body&& body) {
+		if (!selected(name)) {
+			return;
+		}
+		if (options_.pause != nullptr) {
+			options_.pause();
+		}
+		uint32_t iterations = 1;
+		auto sampleTicks = options_.sampleNs / options_.nsPerTick;
+		while (batchTicks(body, iterations) < sampleTicks && iterations < MAX_ITERATIONS) {
+			iterations *= 2;
+		}
+		std::array<double, MAX_SAMPLES> samples;
+		double sum = 0;
+		for (std::size_t i = 0; i < options_.samples; ++i) {
+			samples[i] = batchTicks(body, iterations) * options_.nsPerTick / iterations;
+			sum += samples[i];
+		}
+		auto count = options_.samples;
+		auto mean = sum / count;
+		double variance = 0;
+		for (std::size_t i = 0; i < count; ++i) {
+			variance += (samples[i] - mean) * (samples[i] - mean);
+		}
+		std::sort(samples.begin(), samples.begin() + count);
+		auto median = count % 2 == 1 ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+		out_.printf("{\"benchmark\":\"%s\",\"platform\":\"%s\",\"iterations\":%lu,\"samples\":%u,"
+			"\"min_ns\":%.2f,\"median_ns\":%.2f,\"mean_ns\":%.2f,\"max_ns\":%.2f,\"stddev_ns\":%.2f}\n",
+			name, options_.platform, static_cast<unsigned long>(iterations), static_cast<unsigned>(count),
+			samples[0], median, mean, samples[count - 1], count > 1 ? std::sqrt(variance / (count - 1)) : 0.0);
+		++completed_;
+	}
+
+	std::size_t completed() const { return completed_; }
+
+private:
+	template<typename Body>
+	uint32_t batchTicks(Body& body, uint32_t iterations) {
+		auto start = options_.clock();
+		for (uint32_t i = 0; i < iterations; ++i) {
+			body(i);
+		}
+		return options_.clock() - start;
+	}
+
+	Print& out_;
+	Options options_;
+	std::size_t completed_ = 0;
+};
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "CoordsUtils.h"
+#include "Dashboard.h"
+#include "ItemsList.h"
+#include "Menu.h"
+#include "Mount.h"
+#include "Sky.h"
+
+#include <U8g2lib.h>
+
+#include <cmath>
+
+namespace bench {
+
+// Objects the benchmarks work on. `mount` must not be the running one, benchmarks change its state directly
+// and move its steppers; build it on steppers that drive no pins.
+struct Fixture {
+	U8G2& u8g2;
+	scope::Mount& mount;
+	scope::Sky& sky;
+	ui::ActionDispatcher& dispatcher;
+};
+
+// Coordinate math, parsing and formatting, the motion task's hot paths and the two most drawn screens. Names are
+// what bench_compare.py matches runs by, keep them when a benchmark changes.
+inline void runSuite(Runner& runner, Fixture& fixture) {
+	// angles vary with `i`, so the sin() and cos() of them are not hoisted out of the loop
+	runner.run("coords.rotatePoint", [](uint32_t i) {
+		keep(coords::rotatePoint({i * 1e-4, 0.5}, 0.3 + i * 1e-6, {0.1, 0.2}));
+	});
+	runner.run("coords.translatePoint", [](uint32_t i) {
+		keep(coords::translatePoint({i * 1e-4, 0.5}, {0.1, -0.2}));
+	});
+	runner.run("coords.deltaXdeltaYFrom2Points", [](uint32_t i) {
+		keep(coords::deltaXdeltaYFrom2Points({i * 1e-4, 0.5}, {1.2, -0.3}, 0.4 + i * 1e-6));
+	});
+
+	static constexpr const std::string_view RA_TEXTS[] = {"05h 34m 31.94s", "12:30.5", "6h 45m 08,92s", "23:59:59"};
+	static constexpr const std::string_view DEC_TEXTS[] = {"−00° 49′ 23.7″", "+45*30'10", "-12,30,15.5", "89:15:50.8"};
+	runner.run("coords.parseRA", [](uint32_t i) {
+		keep(coords::parseRA(RA_TEXTS[i % 4]));
+	});
+	runner.run("coords.parseDec", [](uint32_t i) {
+		keep(coords::parseDec(DEC_TEXTS[i % 4]));
+	});
+	runner.run("coords.formatRA", [](uint32_t i) {
+		char text[24];
+		coords::RA(i % 24, 34, 31.94).format(text, sizeof(text));
+		keep(text);
+	});
+	runner.run("coords.formatDec", [](uint32_t i) {
+		char text[24];
+		coords::Dec(static_cast<int>(i % 180) - 90, 49, 23.7).format(text, sizeof(text));
+		keep(text);
+	});
+
+	auto& mount = fixture.mount;
+	runner.run("mount.normalizeTargetSteps", [&mount](uint32_t i) {
+		// half of the targets are beyond the X limits
+		std::pair<double, double> position = {(i % 64) * scope::Mount::X_AXIS_STEPS_PER_REV / 32, 1000.0};
+		mount.normalizeTargetSteps(position);
+		keep(position);
+	});
+
+	double now = 0;
+	scope::Mount::getTimeOfDaySeconds(now);
+	mount.mountType_ = scope::Mount::MountType::EQ;
+	mount.trackingMode_ = scope::Mount::TrackingMode::AUTO_TRACKING;
+	// an hour into tracking
+	mount.autoTrackStartTimeStamp_ = now - 3600;
+	mount.autoTrackStartCoords_ = {0, 0};
+	runner.run("mount.computeAutoTrackCoords.eq", [&mount](uint32_t) {
+		mount.computeAutoTrackCoords();
+	});
+	mount.mountType_ = scope::Mount::MountType::AZ;
+	mount.autoTrackPivotSet_ = true;
+	mount.autoTrackPivot_ = {1000, 2000};
+	runner.run("mount.computeAutoTrackCoords.az", [&mount](uint32_t) {
+		mount.computeAutoTrackCoords();
+	});
+	mount.trackingMode_ = scope::Mount::TrackingMode::MANUAL_CONTROL;
+
+	mount.alignmentTimestamp_ = now - 600;
+	mount.mountType_ = scope::Mount::MountType::EQ;
+	runner.run("mount.safeMoveToPositionRADec.eq", [&mount](uint32_t i) {
+		mount.safeMoveToPositionRADec({(i % 360) * DEG_TO_RAD, 0.5});
+	});
+	mount.mountType_ = scope::Mount::MountType::AZ;
+	mount.skyPivotSet_ = true;
+	mount.skyPivotRad_ = {0.3, 0.8};
+	mount.alignmentAngle_ = 0.2;
+	runner.run("mount.safeMoveToPositionRADec.az", [&mount](uint32_t i) {
+		mount.safeMoveToPositionRADec({(i % 360) * DEG_TO_RAD, 0.5});
+	});
+
+	// draws into the display buffer, the caller redraws the screen afterwards
+	ui::MenuList menu(fixture.u8g2, fixture.dispatcher);
+	menu.open(ui::MenuId::GOTO_OBJECTS);
+	runner.run("ui.ItemsList.draw", [&menu](uint32_t) {
+		menu.draw();
+	});
+	ui::Dashboard dashboard(fixture.u8g2, mount, fixture.sky, fixture.dispatcher);
+	runner.run("ui.Dashboard.draw", [&dashboard](uint32_t) {
+		dashboard.draw();
+	});
+	fixture.u8g2.clearBuffer();
+}
+
+}
@@ -1,36 +1,30 @@
 #pragma once
 
-#include <functional>
+#include <cstdint>
 
+// Auto repeat of a held button: an action on press, then every REPEAT_INTERVAL_MS once held for REPEAT_DELAY_MS
 struct ButtonProcessor {
-	static constexpr const int PS4_READ_INTERVAL_MS = 50;
-	static constexpr const int BUTTON_PRESSED_UNTIL_SCROLL_TIME_MS = 1000;
-	static constexpr const int BUTTON_PRESSED_UNTIL_SCROLL_TICKS = BUTTON_PRESSED_UNTIL_SCROLL_TIME_MS / PS4_READ_INTERVAL_MS;
-	using ButtonPressedFn = std::function<bool()>;
+	static constexpr const uint32_t REPEAT_DELAY_MS = 1000;
+	static constexpr const uint32_t REPEAT_INTERVAL_MS = 50;
 
-	ButtonProcessor(ButtonPressedFn buttonPressedFn) : buttonPressedFn_(std::move(buttonPressedFn)) {}
+	void press(uint32_t nowMs) {
+		pressed_ = true;
+		nextRepeatMs_ = nowMs + REPEAT_DELAY_MS;
+	}
 
-	bool operator()() {
-		bool result = false;
-		auto pressed = buttonPressedFn_();
-		if (pressed) {
-			++buttonPressedTicksCount_;
-		} else {
-			buttonPressedTicksCount_ = 0;
-		}
+	void release() {
+		pressed_ = false;
+	}
 
-		if ((!prevButtonPressed_ && pressed) || buttonPressedTicksCount_ >= BUTTON_PRESSED_UNTIL_SCROLL_TICKS) {
-			prevButtonPressed_ = pressed;
-			return true;
-		} else {
-			prevButtonPressed_ = pressed;
+	// true when a repeat is due at `nowMs`
+	bool repeat(uint32_t nowMs) {
+		if (!pressed_ || static_cast<int32_t>(nowMs - nextRepeatMs_) < 0) {
 			return false;
 		}
+		nextRepeatMs_ += REPEAT_INTERVAL_MS;
+		return true;
 	}
 
-	ButtonPressedFn buttonPressedFn_;
-	bool prevButtonPressed_ = false;
-	int buttonPressedTicksCount_ = 0;
-
-
+	bool pressed_ = false;
+	uint32_t nextRepeatMs_ = 0;
 };
\ No newline at end of file
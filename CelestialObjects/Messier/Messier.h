@@ -2,7 +2,7 @@
 
 #include "../../CoordsUtils.h"
 
-#include <array>
+#include <cstdint>
 
 namespace coords {
 
@@ -120,119 +120,334 @@ enum class Messier : unsigned int {
 	last=M99_
 };
 
-// TODO print all available stars on startup
-using MessierObject = CelestialObject<Messier>;
-constexpr const std::array<MessierObject, static_cast<unsigned int>(Messier::last) + 1> MESSIER = {{
-	MessierObject(Messier::M1_Crab_Nebula, "M1 Crab Nebula", RA{5.0, 34.0, 31.94}, Dec{22.0, 0.0, 52.2}),
-	MessierObject(Messier::M10_, "M10 ", RA{16.0, 57.0, 8.92}, Dec{-4.0, 5.0, 58.07}),
-	MessierObject(Messier::M100_, "M100 ", RA{12.0, 22.0, 54.9}, Dec{15.0, 49.0, 21.0}),
-	MessierObject(Messier::M101_Pinwheel_Galaxy, "M101 Pinwheel Galaxy", RA{14.0, 3.0, 12.6}, Dec{54.0, 20.0, 57.0}),
-	MessierObject(Messier::M102_Spindle_Galaxy, "M102 Spindle Galaxy", RA{15.0, 6.0, 29.5}, Dec{55.0, 45.0, 48.0}),
-	MessierObject(Messier::M103_, "M103 ", RA{1.0, 33.2, 0.0}, Dec{60.0, 42.0, 0.0}),
-	MessierObject(Messier::M104_Sombrero_Galaxy, "M104 Sombrero Galaxy", RA{12.0, 39.0, 59.4}, Dec{-11.0, 37.0, 23.0}),
-	MessierObject(Messier::M105_, "M105 ", RA{10.0, 47.0, 49.6}, Dec{12.0, 34.0, 54.0}),
-	MessierObject(Messier::M106_, "M106 ", RA{12.0, 18.0, 57.5}, Dec{47.0, 18.0, 14.0}),
-	MessierObject(Messier::M107_, "M107 ", RA{16.0, 32.0, 31.86}, Dec{-13.0, 3.0, 13.6}),
-	MessierObject(Messier::M108_, "M108 ", RA{11.0, 11.0, 31.0}, Dec{55.0, 40.0, 27.0}),
-	MessierObject(Messier::M109_, "M109 ", RA{11.0, 57.0, 36.0}, Dec{53.0, 22.0, 28.0}),
-	MessierObject(Messier::M11_Wild_Duck_Cluste, "M11 Wild Duck Cluste", RA{18.0, 51.1, 0.0}, Dec{-6.0, 16.0, 0.0}),
-	MessierObject(Messier::M110_, "M110 ", RA{0.0, 40.0, 22.1}, Dec{41.0, 41.0, 7.0}),
-	MessierObject(Messier::M12_, "M12 ", RA{16.0, 47.0, 14.18}, Dec{-1.0, 56.0, 54.7}),
-	MessierObject(Messier::M13_Great_Globular_C, "M13 Great Globular C", RA{16.0, 41.0, 41.24}, Dec{36.0, 27.0, 35.5}),
-	MessierObject(Messier::M14_, "M14 ", RA{17.0, 37.0, 36.15}, Dec{-3.0, 14.0, 45.3}),
-	MessierObject(Messier::M15_, "M15 ", RA{21.0, 29.0, 58.33}, Dec{12.0, 10.0, 1.2}),
-	MessierObject(Messier::M16_Eagle_Nebula, "M16 Eagle Nebula", RA{18.0, 18.0, 48.0}, Dec{-13.0, 49.0, 0.0}),
-	MessierObject(Messier::M17_Omega__Swan__Hor, "M17 Omega, Swan, Hor", RA{18.0, 20.0, 26.0}, Dec{-16.0, 10.0, 36.0}),
-	MessierObject(Messier::M18_, "M18 ", RA{18.0, 19.9, 0.0}, Dec{-17.0, 8.0, 0.0}),
-	MessierObject(Messier::M19_, "M19 ", RA{17.0, 2.0, 37.69}, Dec{-26.0, 16.0, 4.6}),
-	MessierObject(Messier::M2_, "M2 ", RA{21.0, 33.0, 27.02}, Dec{-0.0, 49.0, 23.7}),
-	MessierObject(Messier::M20_Trifid_Nebula, "M20 Trifid Nebula", RA{18.0, 2.0, 23.0}, Dec{-23.0, 1.0, 48.0}),
-	MessierObject(Messier::M21_, "M21 ", RA{18.0, 4.6, 0.0}, Dec{-22.0, 30.0, 0.0}),
-	MessierObject(Messier::M22_Sagittarius_Clus, "M22 Sagittarius Clus", RA{18.0, 36.0, 23.94}, Dec{-23.0, 54.0, 17.1}),
-	MessierObject(Messier::M23_, "M23 ", RA{17.0, 56.8, 0.0}, Dec{-19.0, 1.0, 0.0}),
-	MessierObject(Messier::M24_Small_Sagittariu, "M24 Small Sagittariu", RA{18.0, 17.0, 0.0}, Dec{-18.0, 33.0, 0.0}),
-	MessierObject(Messier::M25_, "M25 ", RA{18.0, 31.6, 0.0}, Dec{-19.0, 15.0, 0.0}),
-	MessierObject(Messier::M26_, "M26 ", RA{18.0, 45.2, 0.0}, Dec{-9.0, 24.0, 0.0}),
-	MessierObject(Messier::M27_Dumbbell_Nebula, "M27 Dumbbell Nebula", RA{19.0, 59.0, 36.34}, Dec{22.0, 43.0, 16.09}),
-	MessierObject(Messier::M28_, "M28 ", RA{18.0, 24.0, 32.89}, Dec{-24.0, 52.0, 11.4}),
-	MessierObject(Messier::M29_Cooling_Tower, "M29 Cooling Tower", RA{20.0, 23.0, 56.0}, Dec{38.0, 31.0, 24.0}),
-	MessierObject(Messier::M3_, "M3 ", RA{13.0, 42.0, 11.62}, Dec{28.0, 22.0, 38.2}),
-	MessierObject(Messier::M30_, "M30 ", RA{21.0, 40.0, 22.12}, Dec{-23.0, 10.0, 47.5}),
-	MessierObject(Messier::M31_Andromeda_Galaxy, "M31 Andromeda Galaxy", RA{0.0, 42.0, 44.3}, Dec{41.0, 16.0, 9.0}),
-	MessierObject(Messier::M32_Small_Andromeda_, "M32 Small Andromeda ", RA{0.0, 42.0, 41.8}, Dec{40.0, 51.0, 55.0}),
-	MessierObject(Messier::M33_Triangulum_Pinwh, "M33 Triangulum/Pinwh", RA{1.0, 33.0, 50.02}, Dec{30.0, 39.0, 36.7}),
-	MessierObject(Messier::M34_, "M34 ", RA{2.0, 42.1, 0.0}, Dec{42.0, 46.0, 0.0}),
-	MessierObject(Messier::M35_, "M35 ", RA{6.0, 9.1, 0.0}, Dec{24.0, 21.0, 0.0}),
-	MessierObject(Messier::M36_, "M36 ", RA{5.0, 36.0, 12.0}, Dec{34.0, 8.0, 4.0}),
-	MessierObject(Messier::M37_, "M37 ", RA{5.0, 52.0, 18.0}, Dec{32.0, 33.0, 2.0}),
-	MessierObject(Messier::M38_Starfish_Cluster, "M38 Starfish Cluster", RA{5.0, 28.0, 42.0}, Dec{35.0, 51.0, 18.0}),
-	MessierObject(Messier::M39_, "M39 ", RA{21.0, 31.0, 42.0}, Dec{48.0, 26.0, 0.0}),
-	MessierObject(Messier::M4_, "M4 ", RA{16.0, 23.0, 35.22}, Dec{-26.0, 31.0, 32.7}),
-	MessierObject(Messier::M40_Winnecke_4, "M40 Winnecke-4", RA{12.0, 22.0, 12.5}, Dec{58.0, 4.0, 59.0}),
-	MessierObject(Messier::M41_, "M41 ", RA{6.0, 46.0, 0.0}, Dec{-20.0, 46.0, 0.0}),
-	MessierObject(Messier::M42_Orion_Nebula, "M42 Orion Nebula", RA{5.0, 35.0, 17.3}, Dec{-5.0, 23.0, 28.0}),
-	MessierObject(Messier::M43_De_Mairan_s_Nebu, "M43 De Mairan's Nebu", RA{5.0, 35.6, 0.0}, Dec{-5.0, 16.0, 0.0}),
-	MessierObject(Messier::M44_Beehive_Cluster_, "M44 Beehive Cluster ", RA{8.0, 40.4, 0.0}, Dec{19.0, 59.0, 0.0}),
-	MessierObject(Messier::M45_Pleiades, "M45 Pleiades", RA{3.0, 47.0, 24.0}, Dec{24.0, 7.0, 0.0}),
-	MessierObject(Messier::M46_, "M46 ", RA{7.0, 41.8, 0.0}, Dec{-14.0, 49.0, 0.0}),
-	MessierObject(Messier::M47_, "M47 ", RA{7.0, 36.6, 0.0}, Dec{-14.0, 30.0, 0.0}),
-	MessierObject(Messier::M48_, "M48 ", RA{8.0, 13.7, 0.0}, Dec{-5.0, 45.0, 0.0}),
-	MessierObject(Messier::M49_, "M49 ", RA{12.0, 29.0, 46.7}, Dec{8.0, 0.0, 2.0}),
-	MessierObject(Messier::M5_, "M5 ", RA{15.0, 18.0, 33.22}, Dec{2.0, 4.0, 51.7}),
-	MessierObject(Messier::M50_, "M50 ", RA{7.0, 3.2, 0.0}, Dec{-8.0, 20.0, 0.0}),
-	MessierObject(Messier::M51_Whirlpool_Galaxy, "M51 Whirlpool Galaxy", RA{13.0, 29.0, 52.7}, Dec{47.0, 11.0, 43.0}),
-	MessierObject(Messier::M52_, "M52 ", RA{23.0, 24.2, 0.0}, Dec{61.0, 35.0, 0.0}),
-	MessierObject(Messier::M53_, "M53 ", RA{13.0, 12.0, 55.25}, Dec{18.0, 10.0, 5.4}),
-	MessierObject(Messier::M54_, "M54 ", RA{18.0, 55.0, 3.33}, Dec{-30.0, 28.0, 47.5}),
-	MessierObject(Messier::M55_, "M55 ", RA{19.0, 39.0, 59.71}, Dec{-30.0, 57.0, 53.1}),
-	MessierObject(Messier::M56_, "M56 ", RA{19.0, 16.0, 35.57}, Dec{30.0, 11.0, 0.5}),
-	MessierObject(Messier::M57_Ring_Nebula, "M57 Ring Nebula", RA{18.0, 53.0, 35.079}, Dec{33.0, 1.0, 45.03}),
-	MessierObject(Messier::M58_, "M58 ", RA{12.0, 37.0, 43.5}, Dec{11.0, 49.0, 5.0}),
-	MessierObject(Messier::M59_, "M59 ", RA{12.0, 42.0, 2.3}, Dec{11.0, 38.0, 49.0}),
-	MessierObject(Messier::M6_Butterfly_Cluste, "M6 Butterfly Cluste", RA{17.0, 40.1, 0.0}, Dec{-32.0, 13.0, 0.0}),
-	MessierObject(Messier::M60_, "M60 ", RA{12.0, 43.0, 39.6}, Dec{11.0, 33.0, 9.0}),
-	MessierObject(Messier::M61_, "M61 ", RA{12.0, 21.0, 54.9}, Dec{4.0, 28.0, 25.0}),
-	MessierObject(Messier::M62_, "M62 ", RA{17.0, 1.0, 12.6}, Dec{-30.0, 6.0, 44.5}),
-	MessierObject(Messier::M63_Sunflower_Galaxy, "M63 Sunflower Galaxy", RA{13.0, 15.0, 49.3}, Dec{42.0, 1.0, 45.0}),
-	MessierObject(Messier::M64_Black_Eye_Galaxy, "M64 Black Eye Galaxy", RA{12.0, 56.0, 43.7}, Dec{21.0, 40.0, 58.0}),
-	MessierObject(Messier::M65_Leo_Triplet, "M65 Leo Triplet", RA{11.0, 18.0, 55.9}, Dec{13.0, 5.0, 32.0}),
-	MessierObject(Messier::M66_Leo_Triplet, "M66 Leo Triplet", RA{11.0, 20.0, 15.0}, Dec{12.0, 59.0, 30.0}),
-	MessierObject(Messier::M67_, "M67 ", RA{8.0, 51.3, 0.0}, Dec{11.0, 49.0, 0.0}),
-	MessierObject(Messier::M68_, "M68 ", RA{12.0, 39.0, 27.98}, Dec{-26.0, 44.0, 38.6}),
-	MessierObject(Messier::M69_, "M69 ", RA{18.0, 31.0, 23.1}, Dec{-32.0, 20.0, 53.1}),
-	MessierObject(Messier::M7_Ptolemy_Cluster, "M7 Ptolemy Cluster", RA{17.0, 53.0, 51.2}, Dec{-34.0, 47.0, 34.0}),
-	MessierObject(Messier::M70_, "M70 ", RA{18.0, 43.0, 12.76}, Dec{-32.0, 17.0, 31.6}),
-	MessierObject(Messier::M71_, "M71 ", RA{19.0, 53.0, 46.49}, Dec{18.0, 46.0, 45.1}),
-	MessierObject(Messier::M72_, "M72 ", RA{20.0, 53.0, 27.7}, Dec{-12.0, 32.0, 14.3}),
-	MessierObject(Messier::M73_, "M73 ", RA{20.0, 58.0, 54.0}, Dec{-12.0, 38.0, 0.0}),
-	MessierObject(Messier::M74_Phantom_Galaxy_9, "M74 Phantom Galaxy[9", RA{1.0, 36.0, 41.8}, Dec{15.0, 47.0, 1.0}),
-	MessierObject(Messier::M75_, "M75 ", RA{20.0, 6.0, 4.75}, Dec{-21.0, 55.0, 16.2}),
-	MessierObject(Messier::M76_Little_Dumbbell_, "M76 Little Dumbbell ", RA{1.0, 42.4, 0.0}, Dec{51.0, 34.0, 31.0}),
-	MessierObject(Messier::M77_Cetus_A, "M77 Cetus A", RA{2.0, 42.0, 40.7}, Dec{-0.0, 0.0, 48.0}),
-	MessierObject(Messier::M78_, "M78 ", RA{5.0, 46.0, 46.7}, Dec{0.0, 0.0, 50.0}),
-	MessierObject(Messier::M79_, "M79 ", RA{5.0, 24.0, 10.59}, Dec{-24.0, 31.0, 27.3}),
-	MessierObject(Messier::M8_Lagoon_Nebula, "M8 Lagoon Nebula", RA{18.0, 3.0, 37.0}, Dec{-24.0, 23.0, 12.0}),
-	MessierObject(Messier::M80_, "M80 ", RA{16.0, 17.0, 2.41}, Dec{-22.0, 58.0, 33.9}),
-	MessierObject(Messier::M81_Bode_s_Galaxy, "M81 Bode's Galaxy", RA{9.0, 55.0, 33.2}, Dec{69.0, 3.0, 55.0}),
-	MessierObject(Messier::M82_Cigar_Galaxy, "M82 Cigar Galaxy", RA{9.0, 55.0, 52.2}, Dec{69.0, 40.0, 47.0}),
-	MessierObject(Messier::M83_Southern_Pinwhee, "M83 Southern Pinwhee", RA{13.0, 37.0, 0.9}, Dec{-29.0, 51.0, 57.0}),
-	MessierObject(Messier::M84_, "M84 ", RA{12.0, 25.0, 3.7}, Dec{12.0, 53.0, 13.0}),
-	MessierObject(Messier::M85_, "M85 ", RA{12.0, 25.0, 24.0}, Dec{18.0, 11.0, 28.0}),
-	MessierObject(Messier::M86_, "M86 ", RA{12.0, 26.0, 11.7}, Dec{12.0, 56.0, 46.0}),
-	MessierObject(Messier::M87_Virgo_A, "M87 Virgo A", RA{12.0, 30.0, 49.42338}, Dec{12.0, 23.0, 28.0439}),
-	MessierObject(Messier::M88_, "M88 ", RA{12.0, 31.0, 59.2}, Dec{14.0, 25.0, 14.0}),
-	MessierObject(Messier::M89_, "M89 ", RA{12.0, 35.0, 39.8}, Dec{12.0, 33.0, 23.0}),
-	MessierObject(Messier::M9_, "M9 ", RA{17.0, 19.0, 11.78}, Dec{-18.0, 30.0, 58.5}),
-	MessierObject(Messier::M90_, "M90 ", RA{12.0, 36.0, 49.8}, Dec{13.0, 9.0, 46.0}),
-	MessierObject(Messier::M91_, "M91 ", RA{12.0, 35.0, 26.4}, Dec{14.0, 29.0, 47.0}),
-	MessierObject(Messier::M92_, "M92 ", RA{17.0, 17.0, 7.39}, Dec{43.0, 8.0, 9.4}),
-	MessierObject(Messier::M93_, "M93 ", RA{7.0, 44.6, 0.0}, Dec{-23.0, 52.0, 0.0}),
-	MessierObject(Messier::M94_Croc_s_Eye_or_Ca, "M94 Croc's Eye or Ca", RA{12.0, 50.0, 53.1}, Dec{41.0, 7.0, 14.0}),
-	MessierObject(Messier::M95_, "M95 ", RA{10.0, 43.0, 57.7}, Dec{11.0, 42.0, 14.0}),
-	MessierObject(Messier::M96_, "M96 ", RA{10.0, 46.0, 45.7}, Dec{11.0, 49.0, 12.0}),
-	MessierObject(Messier::M97_Owl_Nebula, "M97 Owl Nebula", RA{11.0, 14.0, 47.734}, Dec{55.0, 1.0, 8.5}),
-	MessierObject(Messier::M98_, "M98 ", RA{12.0, 13.0, 48.292}, Dec{14.0, 54.0, 1.69}),
-	MessierObject(Messier::M99_, "M99 ", RA{12.0, 18.0, 49.6}, Dec{14.0, 24.0, 59.0})
-}};
+// Structure of arrays indexed by `Messier`. RA and Dec are J2000 radians, x, y, z is the equatorial unit vector.
+constexpr const char MESSIER_NAMES[] =
+	"M17 Omega, Swan, Horseshoe, or Lobster Nebula\0"
+	"M13 Great Globular Cluster in Hercules\0"
+	"M24 Small Sagittarius Star Cloud\0"
+	"M44 Beehive Cluster or Praesepe\0"
+	"M33 Triangulum/Pinwheel Galaxy\0"
+	"M83 Southern Pinwheel Galaxy\0"
+	"M94 Croc's Eye or Cat's Eye\0"
+	"M32 Small Andromeda Galaxy\0"
+	"M76 Little Dumbbell Nebula\0"
+	"M22 Sagittarius Cluster\0"
+	"M43 De Mairan's Nebula\0"
+	"M74 Phantom Galaxy[91]\0"
+	"M11 Wild Duck Cluster\0"
+	"M101 Pinwheel Galaxy\0"
+	"M104 Sombrero Galaxy\0"
+	"M31 Andromeda Galaxy\0"
+	"M38 Starfish Cluster\0"
+	"M51 Whirlpool Galaxy\0"
+	"M6 Butterfly Cluster\0"
+	"M63 Sunflower Galaxy\0"
+	"M64 Black Eye Galaxy\0"
+	"M102 Spindle Galaxy\0"
+	"M27 Dumbbell Nebula\0"
+	"M7 Ptolemy Cluster\0"
+	"M20 Trifid Nebula\0"
+	"M29 Cooling Tower\0"
+	"M81 Bode's Galaxy\0"
+	"M16 Eagle Nebula\0"
+	"M42 Orion Nebula\0"
+	"M8 Lagoon Nebula\0"
+	"M82 Cigar Galaxy\0"
+	"M57 Ring Nebula\0"
+	"M65 Leo Triplet\0"
+	"M66 Leo Triplet\0"
+	"M1 Crab Nebula\0"
+	"M40 Winnecke-4\0"
+	"M97 Owl Nebula\0"
+	"M45 Pleiades\0"
+	"M77 Cetus A\0"
+	"M87 Virgo A\0"
+	"M100\0"
+	"M103\0"
+	"M105\0"
+	"M106\0"
+	"M107\0"
+	"M108\0"
+	"M109\0"
+	"M110\0"
+	"M10\0"
+	"M12\0"
+	"M14\0"
+	"M15\0"
+	"M18\0"
+	"M19\0"
+	"M21\0"
+	"M23\0"
+	"M25\0"
+	"M26\0"
+	"M28\0"
+	"M30\0"
+	"M34\0"
+	"M35\0"
+	"M36\0"
+	"M37\0"
+	"M39\0"
+	"M41\0"
+	"M46\0"
+	"M47\0"
+	"M48\0"
+	"M49\0"
+	"M50\0"
+	"M52\0"
+	"M53\0"
+	"M54\0"
+	"M55\0"
+	"M56\0"
+	"M58\0"
+	"M59\0"
+	"M60\0"
+	"M61\0"
+	"M62\0"
+	"M67\0"
+	"M68\0"
+	"M69\0"
+	"M70\0"
+	"M71\0"
+	"M72\0"
+	"M73\0"
+	"M75\0"
+	"M78\0"
+	"M79\0"
+	"M80\0"
+	"M84\0"
+	"M85\0"
+	"M86\0"
+	"M88\0"
+	"M89\0"
+	"M90\0"
+	"M91\0"
+	"M92\0"
+	"M93\0"
+	"M95\0"
+	"M96\0"
+	"M98\0"
+	"M99\0"
+	"M2\0"
+	"M3\0"
+	"M4\0"
+	"M5\0"
+	"M9\0";
+
+constexpr const uint16_t MESSIER_NAME_OFFSETS[] = {
+	781, 903, 863, 384, 552, 868, 405, 873, 878, 883, 888, 893, 362, 898, 907, 46,
+	911, 915, 665, 0, 919, 923, 1131, 611, 927, 292, 931, 85, 935, 939, 572, 943,
+	629, 1134, 947, 426, 238, 150, 951, 955, 959, 963, 447, 967, 1137, 796, 971, 682,
+	316, 118, 826, 975, 979, 983, 987, 1140, 991, 468, 995, 999, 1003, 1007, 1011, 733,
+	1015, 1019, 489, 1023, 1027, 1031, 510, 531, 749, 765, 1035, 1039, 1043, 592, 1047, 1051,
+	1055, 1059, 339, 1063, 265, 839, 1067, 1071, 699, 1075, 647, 716, 181, 1079, 1083, 1087,
+	851, 1091, 1095, 1143, 1099, 1103, 1107, 1111, 210, 1115, 1119, 811, 1123, 1127
+};
+
+constexpr const float MESSIER_RA[] = {
+	1.45967267f, 4.4381483f, 3.2415782f, 3.6791977f, 3.95531606f, 0.406661716f, 3.31608195f, 2.82667708f,
+	3.22431399f, 4.33073347f, 2.9300442f, 3.13112068f, 4.93535479f, 0.176140083f, 4.39489759f, 4.37068551f,
+	4.61466145f, 5.62856539f, 4.79441946f, 4.80154622f, 4.79921911f, 4.46205713f, 5.64374176f, 4.72278823f,
+	4.73246027f, 4.87120958f, 4.69842635f, 4.78656547f, 4.85026999f, 4.90961119f, 5.23426715f, 4.81950056f,
+	5.34041662f, 3.58749664f, 5.67392868f, 0.186481158f, 0.186299353f, 0.409426608f, 0.707294679f, 1.61050257f,
+	1.46694924f, 1.53719874f, 1.43422431f, 5.63610449f, 4.29170791f, 3.23849479f, 1.77150919f, 1.46297134f,
+	1.46433124f, 2.27067336f, 0.99221968f, 2.01498262f, 1.99229334f, 2.15417263f, 3.27152514f, 4.00794646f,
+	1.84655835f, 3.53376086f, 6.12697834f, 3.45976981f, 4.95261392f, 5.1487002f, 5.04658826f, 4.94619612f,
+	3.30619902f, 3.32501949f, 4.62555885f, 3.33209534f, 3.23721488f, 4.45586921f, 3.47242709f, 3.3891167f,
+	2.96239824f, 2.96815056f, 2.31823358f, 3.31379702f, 4.84933188f, 4.68556909f, 4.90093981f, 5.20882534f,
+	5.46925828f, 5.49298749f, 0.421918802f, 5.26251312f, 0.446804289f, 0.709818135f, 1.51310592f, 1.41448682f,
+	4.72816967f, 4.26314196f, 2.59859163f, 2.59997335f, 3.56490045f, 3.2509448f, 3.25242106f, 3.2558899f,
+	3.27608652f, 3.28116082f, 3.2972033f, 4.5343494f, 3.30229384f, 3.29622883f, 4.5253035f, 2.02719993f,
+	3.36362035f, 2.80981283f, 2.82203014f, 2.9443511f, 3.20182775f, 3.22373948f
+};
+
+constexpr const float MESSIER_DEC[] = {
+	0.384225508f, -0.0715491424f, 0.276154721f, 0.948571904f, 0.973253769f, 1.05941486f, -0.202860589f, 0.219591509f,
+	0.82560861f, -0.227831402f, 0.971697517f, 0.931559792f, -0.109373966f, 0.727545347f, -0.0340082253f, 0.636344621f,
+	-0.0566519331f, 0.21235421f, -0.241146325f, -0.282336095f, -0.299033079f, -0.458462118f, -0.0143684231f, -0.401949327f,
+	-0.392699082f, -0.417216594f, -0.331903446f, -0.323758576f, -0.335975881f, -0.16406095f, 0.396558635f, -0.434060476f,
+	0.672359006f, 0.49527693f, -0.404564897f, 0.720282838f, 0.713233647f, 0.535121342f, 0.746419143f, 0.424987673f,
+	0.595758444f, 0.568114368f, 0.625787803f, 0.845321134f, -0.462961674f, 1.01374056f, -0.362446708f, -0.0940926392f,
+	-0.0919206739f, 0.348774962f, 0.420915238f, -0.258599618f, -0.253072742f, -0.100356432f, 0.139636036f, 0.0363207865f,
+	-0.145444104f, 0.823712989f, 1.07483193f, 0.317094327f, -0.531973932f, -0.54043684f, 0.52680097f, 0.576467853f,
+	0.206263981f, 0.203277528f, -0.562286907f, 0.201629162f, 0.0780792433f, -0.525559847f, 0.73354734f, 0.378435863f,
+	0.228502384f, 0.226747359f, 0.20623974f, -0.466771825f, -0.564580561f, -0.607248528f, -0.563603661f, 0.327758774f,
+	-0.218817261f, -0.220493262f, 0.275475982f, -0.382596534f, 0.90015841f, -0.000232710567f, 0.000242406841f, -0.428028909f,
+	-0.425627627f, -0.401008303f, 1.2054165f, 1.21614057f, -0.521257126f, 0.224919611f, 0.317494783f, 0.225952264f,
+	0.2162659f, 0.251686174f, 0.219150328f, -0.323169528f, 0.229733811f, 0.253009716f, 0.752864257f, -0.416551915f,
+	0.717689085f, 0.204271396f, 0.206297918f, 0.960263186f, 0.260062252f, 0.251613452f
+};
+
+// messier_objects.txt text the arrays were generated from, never used at run time
+constexpr const std::string_view MESSIER_RA_TEXT[] = {
+	"05h 34m 31.94s", "16h 57m 8.92s", "12h 22m 54.9s", "14h 03m 12.6s",
+	"15h 06m 29.5s", "01h 33.2m", "12h 39m 59.4s", "10h 47m 49.6s",
+	"12h 18m 57.5s", "16h 32m 31.86s", "11h 11m 31.0s", "11h 57m 36.0s",
+	"18h 51.1m", "00h 40m 22.1s", "16h 47m 14.18s", "16h 41m 41.24s",
+	"17h 37m 36.15s", "21h 29m 58.33s", "18h 18m 48s", "18h 20m 26s",
+	"18h 19.9m", "17h 02m 37.69s", "21h 33m 27.02s", "18h 02m 23s",
+	"18h 04.6m", "18h 36m 23.94s", "17h 56.8m", "18h 17m",
+	"18h 31.6m", "18h 45.2m", "19h 59m 36.340s", "18h 24m 32.89s",
+	"20h 23m 56s", "13h 42m 11.62s", "21h 40m 22.12", "00h 42m 44.3s",
+	"00h 42m 41.8s", "01h 33m 50.02s", "02h 42.1m", "06h 09.1m",
+	"05h 36m 12s", "05h 52m 18s", "05h 28m 42s", "21h 31m 42s",
+	"16h 23m 35.22s", "12h 22m 12.5s", "06h 46.0m", "05h 35m 17.3",
+	"05h 35.6m", "08h 40.4m", "03h 47m 24s", "07h 41.8m",
+	"07h 36.6m", "08h 13.7m", "12h 29m 46.7s", "15h 18m 33.22s",
+	"07h 03.2m", "13h 29m 52.7s", "23h 24.2m", "13h 12m 55.25s",
+	"18h 55m 03.33s", "19h 39m 59.71s", "19h 16m 35.57s", "18h 53m 35.079s",
+	"12h 37m 43.5s", "12h 42m 02.3s", "17h 40.1m", "12h 43m 39.6s",
+	"12h 21m 54.9s", "17h 01m 12.60s", "13h 15m 49.3s", "12h 56m 43.7s",
+	"11h 18m 55.9s", "11h 20m 15.0s", "08h 51.3m", "12h 39m 27.98s",
+	"18h 31m 23.10s", "17h 53m 51.2s", "18h 43m 12.76s", "19h 53m 46.49s",
+	"20h 53m 27.70s", "20h 58m 54s", "01h 36m 41.8s", "20h 06m 04.75s",
+	"01h 42.4m", "02h 42m 40.7s", "05h 46m 46.7s", "05h 24m 10.59s",
+	"18h 03m 37s", "16h 17m 02.41s", "09h 55m 33.2s", "09h 55m 52.2s",
+	"13h 37m 00.9s", "12h 25m 03.7s", "12h 25m 24.0s", "12h 26m 11.7s",
+	"12h 30m 49.42338s", "12h 31m 59.2s", "12h 35m 39.8s", "17h 19m 11.78s",
+	"12h 36m 49.8s", "12h 35m 26.4s", "17h 17m 07.39s", "07h 44.6m",
+	"12h 50m 53.1s", "10h 43m 57.7s", "10h 46m 45.7s", "11h 14m 47.734s",
+	"12h 13m 48.292s", "12h 18m 49.6s"
+};
+
+constexpr const std::string_view MESSIER_DEC_TEXT[] = {
+	"+22° 00′ 52.2″", "−04° 05′ 58.07″", "+15° 49′ 21″", "+54° 20′ 57″",
+	"+55° 45′ 48″", "+60° 42′", "−11° 37′ 23″", "+12° 34′ 54″",
+	"+47° 18′ 14″", "−13° 03′ 13.6″", "+55° 40′ 27″", "+53° 22′ 28″",
+	"−06° 16′", "+41° 41′ 07″", "−01° 56′ 54.7″", "+36° 27′ 35.5″",
+	"−03° 14′ 45.3″", "+12° 10′ 01.2″", "−13° 49′", "−16° 10′ 36″",
+	"−17° 08′", "−26° 16′ 04.6″", "−00° 49′ 23.7″", "−23° 01′ 48″",
+	"−22° 30′", "−23° 54′ 17.1″", "−19° 01′", "−18° 33′",
+	"−19° 15′", "−09° 24′", "+22° 43′ 16.09″", "−24° 52′ 11.4″",
+	"+38° 31′ 24″", "+28° 22′ 38.2″", "−23° 10′ 47.5″", "+41° 16′ 9″",
+	"+40° 51′ 55″", "+30° 39′ 36.7″", "+42° 46′", "+24° 21′",
+	"+34° 08′ 4″", "+32° 33′ 02″", "+35° 51′ 18″", "+48° 26′ 00″",
+	"−26° 31′ 32.7″", "+58° 4′ 59″", "−20° 46′", "−05° 23′ 28″",
+	"−05° 16′", "+19° 59′", "+24° 07′ 00″", "−14° 49′",
+	"−14° 30′", "−05° 45′", "+08° 00′ 02″", "+02° 04′ 51.7″",
+	"−08° 20′", "+47° 11′ 43″", "+61° 35′", "+18° 10′ 05.4″",
+	"−30° 28′ 47.5″", "−30° 57′ 53.1″", "+30° 11′ 00.5″", "+33° 01′ 45.03″",
+	"+11° 49′ 05″", "+11° 38′ 49″", "−32° 13′", "+11° 33′ 09″",
+	"+04° 28′ 25″", "−30° 06′ 44.5″", "+42° 01′ 45″", "+21° 40′ 58″",
+	"+13° 05′ 32″", "+12° 59′ 30″", "+11° 49′", "−26° 44′ 38.6″",
+	"−32° 20′ 53.1″", "−34° 47′ 34″", "−32° 17′ 31.6″", "+18° 46′ 45.1″",
+	"−12° 32′ 14.3″", "−12° 38′", "+15° 47′ 01″", "−21° 55′ 16.2″",
+	"+51° 34′ 31″", "−00° 00′ 48″", "+00° 00′ 50″", "−24° 31′ 27.3″",
+	"−24° 23′ 12″", "−22° 58′ 33.9″", "+69° 3′ 55″", "+69° 40′ 47″",
+	"−29° 51′ 57″", "+12° 53′ 13″", "+18° 11′ 28″", "+12° 56′ 46″",
+	"+12° 23′ 28.0439″", "+14° 25′ 14″", "+12° 33′ 23″", "−18° 30′ 58.5″",
+	"+13° 09′ 46″", "+14° 29′ 47″", "+43° 08′ 09.4″", "−23° 52′",
+	"+41° 07′ 14″", "+11° 42′ 14″", "+11° 49′ 12″", "+55° 01′ 08.50″",
+	"+14° 54′ 01.69″", "+14° 24′ 59″"
+};
+
+static_assert(matchesSource(MESSIER_RA_TEXT, MESSIER_DEC_TEXT, MESSIER_RA, MESSIER_DEC), "MESSIER_RA or MESSIER_DEC does not match messier_objects.txt");
+
+constexpr const float MESSIER_X[] = {
+	0.102809629f, -0.270123171f, -0.957305836f, -0.500626713f, -0.38640053f, 0.449471542f, -0.964620959f, -0.927989967f,
+	-0.675791018f, -0.362832516f, -0.551327445f, -0.596550184f, 0.219801695f, 0.735254012f, -0.312003799f, -0.269506024f,
+	-0.0974155095f, 0.775460322f, 0.0795676058f, 0.0855138565f, 0.0828725368f, -0.222143902f, 0.802345113f, 0.00957026193f,
+	0.0185422057f, 0.144587387f, -0.013200178f, 0.0702582869f, 0.129759887f, 0.193315011f, 0.459822703f, 0.096992938f,
+	0.459672349f, -0.793807678f, 0.753872175f, 0.738588167f, 0.743164272f, 0.789110008f, 0.558024961f, -0.0361646203f,
+	0.0858022279f, 0.0283146514f, 0.110348099f, 0.529364378f, -0.365393368f, -0.526209122f, -0.186415421f, 0.107140141f,
+	0.105815453f, -0.60534228f, 0.499102696f, -0.415434568f, -0.396095246f, -0.548073392f, -0.981919408f, -0.64718203f,
+	-0.269405414f, -0.627915738f, 0.470085981f, -0.902455021f, 0.205042197f, 0.36237201f, 0.283540831f, 0.194241225f,
+	-0.965572355f, -0.96297999f, -0.073369325f, -0.962017278f, -0.99239896f, -0.219475076f, -0.702523044f, -0.900922192f,
+	-0.958410539f, -0.959783406f, -0.665355792f, -0.879817281f, 0.115329892f, -0.0220224227f, 0.158445951f, 0.450940125f,
+	0.670275603f, 0.686667867f, 0.877907158f, 0.484994285f, 0.560476176f, 0.758480389f, 0.0576584069f, 0.141629769f,
+	0.0143721324f, -0.399834452f, -0.305910134f, -0.297564898f, -0.790651127f, -0.968989496f, -0.944191945f, -0.968222239f,
+	-0.967885225f, -0.959076402f, -0.964288588f, -0.167932636f, -0.961180892f, -0.956610938f, -0.135727527f, -0.403036264f,
+	-0.734835527f, -0.925807005f, -0.929242391f, -0.562188492f, -0.964621371f, -0.965246015f
+};
+
+constexpr const float MESSIER_Y[] = {
+	0.921370846f, -0.960168174f, -0.0960369943f, -0.298463023f, -0.408934615f, 0.193573028f, -0.170045303f, 0.302298353f,
+	-0.0560301946f, -0.904067111f, 0.118404061f, 0.00624728729f, -0.969418473f, 0.130863875f, -0.94947223f, -0.757774476f,
+	-0.993631828f, -0.595181274f, -0.967799537f, -0.956592607f, -0.952021609f, -0.868783213f, -0.596687424f, -0.920250379f,
+	-0.923693443f, -0.902714441f, -0.945331676f, -0.945439441f, -0.935129109f, -0.967447123f, -0.799610437f, -0.902066061f,
+	-0.633071888f, -0.379450573f, -0.526061755f, 0.139351865f, 0.140075338f, 0.342434025f, 0.477019593f, 0.910325741f,
+	0.823263982f, 0.842441329f, 0.802954961f, -0.39999216f, -0.816722812f, -0.0511509905f, 0.916261065f, 0.989794758f,
+	0.990140117f, 0.718867067f, 0.764163482f, 0.872936326f, 0.883412933f, 0.830408278f, -0.128306089f, -0.761470157f,
+	0.952058548f, -0.259700766f, -0.0740338447f, -0.297239445f, -0.837060253f, -0.777152073f, -0.816594335f, -0.815581624f,
+	-0.160390587f, -0.178644398f, -0.842850786f, -0.185516536f, -0.0951856886f, -0.836737973f, -0.241286783f, -0.227668624f,
+	0.173603978f, 0.168156405f, 0.717890312f, -0.153023984f, -0.836903932f, -0.820925805f, -0.830353429f, -0.832477795f,
+	-0.70965411f, -0.693291246f, 0.394071441f, -0.790825431f, 0.268535189f, 0.651695823f, 0.998336341f, 0.898694042f,
+	-0.910666367f, -0.829314021f, 0.184621758f, 0.179024834f, -0.356224613f, -0.106385472f, -0.105073847f, -0.111149575f,
+	-0.130965236f, -0.1347325f, -0.151276585f, -0.933244682f, -0.155806456f, -0.149117133f, -0.716999995f, 0.820885388f,
+	-0.165888741f, 0.318954137f, 0.307489973f, 0.112347655f, -0.0581744335f, -0.0794707398f
+};
+
+constexpr const float MESSIER_Z[] = {
+	0.374841226f, -0.0714881114f, 0.272658088f, 0.812583976f, 0.826720697f, 0.872069272f, -0.201472081f, 0.217830959f,
+	0.734960623f, -0.225865498f, 0.82584413f, 0.802551462f, -0.10915603f, 0.665038483f, -0.0340016702f, 0.594259494f,
+	-0.0566216344f, 0.21076181f, -0.238815939f, -0.27860001f, -0.294596333f, -0.44256956f, -0.0143679287f, -0.39121305f,
+	-0.382683432f, -0.40521738f, -0.325843181f, -0.318132104f, -0.329690645f, -0.163325962f, 0.386246335f, -0.420558189f,
+	0.622833297f, 0.475275323f, -0.393618818f, 0.659597285f, 0.654282633f, 0.509945423f, 0.679014323f, 0.412309551f,
+	0.561136697f, 0.538043575f, 0.585735971f, 0.748184221f, -0.446599971f, 0.848815372f, -0.354563043f, -0.0939538603f,
+	-0.0917912827f, 0.341746783f, 0.408595976f, -0.255726985f, -0.250380004f, -0.100188062f, 0.139182703f, 0.0363128013f,
+	-0.144931859f, 0.733673864f, 0.879510182f, 0.311807069f, -0.507235478f, -0.514510624f, 0.502770613f, 0.545066015f,
+	0.204804511f, 0.201880454f, -0.533122401f, 0.200265754f, 0.0779999342f, -0.501697375f, 0.669508821f, 0.369467458f,
+	0.22651909f, 0.224809336f, 0.204780784f, -0.450005792f, -0.535061515f, -0.570610056f, -0.534235963f, 0.321921922f,
+	-0.217075239f, -0.21871097f, 0.272005003f, -0.373330526f, 0.783425369f, -0.000232710565f, 0.000242406838f, -0.41507834f,
+	-0.412892493f, -0.390346853f, 0.933988113f, 0.93776609f, -0.497970703f, 0.223027999f, 0.312187536f, 0.224034522f,
+	0.214584011f, 0.249037362f, 0.217400352f, -0.317573603f, 0.227718336f, 0.250318985f, 0.683731706f, -0.404609627f,
+	0.657645553f, 0.202853759f, 0.204837729f, 0.819342482f, 0.257140711f, 0.248966931f
+};
+
+constexpr const float MESSIER_MAGNITUDE[] = {
+	8.4f, 6.4f, 10.1f, 7.9f, 10.7f, 7.4f, 9.0f, 10.2f,
+	9.1f, 8.9f, 10.7f, 10.6f, 6.3f, 9.0f, 7.7f, 5.8f,
+	8.3f, 6.2f, 6.0f, 6.0f, 7.5f, 7.5f, 6.3f, 6.3f,
+	6.5f, 5.1f, 6.9f, 2.5f, 4.6f, 8.0f, 7.5f, 7.7f,
+	7.1f, 6.2f, 7.7f, 3.4f, 8.1f, 5.7f, 5.5f, 5.3f,
+	6.3f, 6.2f, 7.4f, 5.5f, 5.9f, 9.7f, 4.5f, 4.0f,
+	9.0f, 3.7f, 1.6f, 6.1f, 4.2f, 5.5f, 9.4f, 6.7f,
+	5.9f, 8.4f, 5.0f, 8.3f, 8.4f, 7.4f, 8.3f, 8.8f,
+	10.5f, 10.6f, 4.2f, 9.8f, 10.2f, 7.4f, 9.3f, 9.4f,
+	10.3f, 8.9f, 6.1f, 9.7f, 8.3f, 3.3f, 9.1f, 6.1f,
+	9.4f, 9.0f, 10.0f, 9.2f, 10.1f, 9.6f, 8.3f, 8.6f,
+	6.0f, 7.9f, 6.9f, 8.4f, 7.5f, 10.1f, 10.0f, 9.8f,
+	9.6f, 10.4f, 10.7f, 8.4f, 10.3f, 11.0f, 6.3f, 6.0f,
+	9.0f, 11.4f, 10.1f, 9.9f, 11.0f, 10.4f
+};
+
+constexpr const ObjectType MESSIER_TYPE[] = {
+	ObjectType::SUPERNOVA_REMNANT, ObjectType::GLOBULAR_CLUSTER, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::OPEN_CLUSTER, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::OPEN_CLUSTER, ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::NEBULA, ObjectType::NEBULA,
+	ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::NEBULA,
+	ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::OTHER,
+	ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::PLANETARY_NEBULA, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER,
+	ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER,
+	ObjectType::GLOBULAR_CLUSTER, ObjectType::OTHER, ObjectType::OPEN_CLUSTER, ObjectType::NEBULA,
+	ObjectType::NEBULA, ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER,
+	ObjectType::OPEN_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::OPEN_CLUSTER, ObjectType::GALAXY, ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::PLANETARY_NEBULA,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::OPEN_CLUSTER, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::GLOBULAR_CLUSTER, ObjectType::OPEN_CLUSTER, ObjectType::GLOBULAR_CLUSTER, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::GLOBULAR_CLUSTER, ObjectType::OTHER, ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::PLANETARY_NEBULA, ObjectType::GALAXY, ObjectType::NEBULA, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::NEBULA, ObjectType::GLOBULAR_CLUSTER, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GALAXY,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GLOBULAR_CLUSTER, ObjectType::OPEN_CLUSTER,
+	ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::GALAXY, ObjectType::PLANETARY_NEBULA,
+	ObjectType::GALAXY, ObjectType::GALAXY
+};
+
+// TODO print all available objects on startup
+constexpr const Catalog MESSIER{
+	static_cast<unsigned int>(Messier::last) + 1,
+	MESSIER_NAMES, MESSIER_NAME_OFFSETS,
+	MESSIER_RA, MESSIER_DEC,
+	MESSIER_X, MESSIER_Y, MESSIER_Z,
+	MESSIER_MAGNITUDE, MESSIER_TYPE
+};
 
 }
\ No newline at end of file
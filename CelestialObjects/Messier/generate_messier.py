@@ -1,8 +1,13 @@
+import math
+import unicodedata
+
 MESSIER_OBJECTS_FILE = "messier_objects.txt"
 MESSIER_TEMPLATE_FILE = "Messier.h.template"
 MESSIER_FILE = "Messier.h"
 NUMBER_INDEX = 0
 NAME_INDEX = 2
+TYPE_INDEX = 4
+MAGNITUDE_INDEX = 7
 RA_INDEX = 8
 DEC_INDEX = 9
 
@@ -19,46 +24,115 @@ def parse_ra(ra: str):
 def parse_dec(dec: str):
     dms = dec.split()
     dec_split = [
-        dms[0][:-2] if len(dms) > 0 else "0",
-        dms[1][:-3] if len(dms) > 1 else "0",
-        dms[2][:-3] if len(dms) > 2 else "0"
+        dms[0][:-1] if len(dms) > 0 else "0",
+        dms[1][:-1] if len(dms) > 1 else "0",
+        dms[2][:-1] if len(dms) > 2 else "0"
     ]
     return [float(e.replace(',','.')) for e in dec_split]
 
+def parse_magnitude(magnitude: str):
+    return float(magnitude.replace(',','.'))
+
+def parse_type(object_type: str):
+    object_type = object_type.lower()
+    if "globular" in object_type:
+        return "GLOBULAR_CLUSTER"
+    if "open cluster" in object_type:
+        return "OPEN_CLUSTER"
+    if "planetary" in object_type:
+        return "PLANETARY_NEBULA"
+    if "supernova" in object_type:
+        return "SUPERNOVA_REMNANT"
+    if "galaxy" in object_type:
+        return "GALAXY"
+    if "nebula" in object_type:
+        return "NEBULA"
+    return "OTHER"
+
+def parse_name(name: str):
+    # display font has ASCII glyphs only
+    return unicodedata.normalize("NFKD", name).encode("ascii", errors="ignore").decode("ascii").strip()
+
 def parse_name_to_symbol(name: str):
     return ''.join(char if char.isalnum() else "_" for char in name)[0:16]
 
 def parse_messier_number(number: str):
     return number.split('[')[0]
 
-def parse_to_star_array_entry(star: list):
-    symbol, name, ra, dec = star
-    ra_str = ", ".join(str(r) for r in ra)
-    dec_str = ", ".join(str(d) for d in dec)
-    return f"MessierObject(Messier::{symbol}, \"{name}\", RA{{{ra_str}}}, Dec{{{dec_str}}})"
+def ra_to_rad(ra: list):
+    h, m, s = ra
+    return math.radians((h + m / 60 + s / 3600) * 15)
+
+def dec_to_rad(dec: list):
+    d, m, s = dec
+    # sign is kept also for -0 degrees
+    return math.copysign(math.radians(abs(d) + m / 60 + s / 3600), d)
+
+def float_literal(value: float):
+    literal = f"{value:.9g}"
+    if "." not in literal and "e" not in literal:
+        literal += ".0"
+    return literal + "f"
+
+def intern_names(names: list):
+    # names that are suffix of already pooled name share its bytes
+    pool = ""
+    offsets = []
+    for name in names:
+        offset = pool.find(name + "\0")
+        if offset == -1:
+            offset = len(pool)
+            pool += name + "\0"
+        offsets.append(offset)
+    return pool, offsets
+
+def format_array(values: list, per_line: int = 8):
+    lines = [", ".join(values[i:i + per_line]) for i in range(0, len(values), per_line)]
+    return '\t' + ',\n\t'.join(lines)
 
 
 stars = []
-with open(MESSIER_OBJECTS_FILE, "rb") as f:
+with open(MESSIER_OBJECTS_FILE, "r", encoding="utf-8") as f:
     for l in f:
-        line = l.replace(b'\xe2\x88\x92', b'-').replace(b'\xe2\x80\x93', b'').decode("cp1250", errors="ignore").split('\t')
+        line = l.replace('−', '-').replace('–', '').split('\t')
+        source = l.rstrip('\r\n').split('\t')
+        name = parse_name(line[NAME_INDEX])
         stars.append(
             (
-                parse_messier_number(line[NUMBER_INDEX]) + "_" + parse_name_to_symbol(line[NAME_INDEX]),
-                parse_messier_number(line[NUMBER_INDEX]) + " " + line[NAME_INDEX][0:16],
+                parse_messier_number(line[NUMBER_INDEX]) + "_" + parse_name_to_symbol(name),
+                (parse_messier_number(line[NUMBER_INDEX]) + " " + name).strip(),
                 parse_ra(line[RA_INDEX]),
-                parse_dec(line[DEC_INDEX])
+                parse_dec(line[DEC_INDEX]),
+                parse_magnitude(line[MAGNITUDE_INDEX]),
+                parse_type(line[TYPE_INDEX]),
+                source[RA_INDEX].strip(),
+                source[DEC_INDEX].strip()
             )
         )
 
 stars = sorted(stars, key=lambda s: s[1])
+# longest names first so shorter ones can share their suffix
+names_by_length = sorted((s[1] for s in stars), key=len, reverse=True)
+pool, offsets = intern_names(names_by_length)
+offset_by_name = dict(zip(names_by_length, offsets))
 with open(MESSIER_TEMPLATE_FILE, "r") as f:
     content = f.read()
 
     stars_enum = '\t' + ',\n\t'.join(s[0] for s in stars) + ",\n\tlast=" + stars[-1][0]
     content = content.replace("{{MESSIER_ENUM_KEYS}}",stars_enum)
 
-    stars_array = '\t' + ',\n\t'.join(parse_to_star_array_entry(s) for s in stars)
-    content = content.replace("{{MESSIER_ARRAY}}", stars_array)
-    with open(MESSIER_FILE, "w") as sf:
+    ra = [ra_to_rad(s[2]) for s in stars]
+    dec = [dec_to_rad(s[3]) for s in stars]
+    content = content.replace("{{MESSIER_NAMES}}", '\t' + '\n\t'.join('"' + name + '\\0"' for name in pool.split("\0")[:-1]))
+    content = content.replace("{{MESSIER_NAME_OFFSETS}}", format_array([str(offset_by_name[s[1]]) for s in stars], 16))
+    content = content.replace("{{MESSIER_RA}}", format_array([float_literal(r) for r in ra]))
+    content = content.replace("{{MESSIER_DEC}}", format_array([float_literal(d) for d in dec]))
+    content = content.replace("{{MESSIER_RA_TEXT}}", format_array(['"' + s[6] + '"' for s in stars], 4))
+    content = content.replace("{{MESSIER_DEC_TEXT}}", format_array(['"' + s[7] + '"' for s in stars], 4))
+    content = content.replace("{{MESSIER_X}}", format_array([float_literal(math.cos(d) * math.cos(r)) for r, d in zip(ra, dec)]))
+    content = content.replace("{{MESSIER_Y}}", format_array([float_literal(math.cos(d) * math.sin(r)) for r, d in zip(ra, dec)]))
+    content = content.replace("{{MESSIER_Z}}", format_array([float_literal(math.sin(d)) for d in dec]))
+    content = content.replace("{{MESSIER_MAGNITUDE}}", format_array([float_literal(s[4]) for s in stars]))
+    content = content.replace("{{MESSIER_TYPE}}", format_array(["ObjectType::" + s[5] for s in stars], 4))
+    with open(MESSIER_FILE, "w", newline="\r\n") as sf:
         sf.write(content)
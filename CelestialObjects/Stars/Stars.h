@@ -2,7 +2,7 @@
 
 #include "../../CoordsUtils.h"
 
-#include <array>
+#include <cstdint>
 
 namespace coords {
 
@@ -108,107 +108,307 @@ enum class Star : unsigned int {
 	last=Zosma
 };
 
+// Structure of arrays indexed by `Star`. RA and Dec are J2000 radians, x, y, z is the equatorial unit vector.
+constexpr const char STARS_NAMES[] =
+	"Alfa Centauri A (Rigil Kentaurus)\0"
+	"Kapella (Alfa Aurigae A)\0"
+	"Acrux (Alfa Crucis A)\0"
+	"Gamma Cassiopeiae\0"
+	"Epsilon Centauri\0"
+	"Alfa Centauri B\0"
+	"Alfa Aurigae B\0"
+	"Delta Centauri\0"
+	"Kaus Australis\0"
+	"Alfa Crucis B\0"
+	"Gamma Velorum\0"
+	"Kappa Scorpii\0"
+	"Zeta Centauri\0"
+	"Zeta Ophiuchi\0"
+	"Eta Centauri\0"
+	"Miaplacidus\0"
+	"Menkalinan\0"
+	"Rasalhague\0"
+	"Aldebaran\0"
+	"Alderamin\0"
+	"Alfa Lupi\0"
+	"Alpheratz\0"
+	"Alsephina\0"
+	"Aspidiske\0"
+	"Bellatrix\0"
+	"Betelgeza\0"
+	"Fomalhaut\0"
+	"Achernar\0"
+	"Alphecca\0"
+	"Denebola\0"
+	"Dschubba\0"
+	"Algieba\0"
+	"Aljanah\0"
+	"Alnilam\0"
+	"Alnitak\0"
+	"Alphard\0"
+	"Antares\0"
+	"Eltanin\0"
+	"Kanopus\0"
+	"Larawag\0"
+	"Menkent\0"
+	"Peacock\0"
+	"Polaris\0"
+	"Polluks\0"
+	"Procjon\0"
+	"Regulus\0"
+	"Syriusz\0"
+	"Alhena\0"
+	"Alioth\0"
+	"Alkaid\0"
+	"Almach\0"
+	"Alnair\0"
+	"Altair\0"
+	"Aludra\0"
+	"Arktur\0"
+	"Diphda\0"
+	"Elnath\0"
+	"Gacrux\0"
+	"Kastor\0"
+	"Kochab\0"
+	"Markab\0"
+	"Markeb\0"
+	"Menkar\0"
+	"Mimosa\0"
+	"Mirach\0"
+	"Mirfak\0"
+	"Mirzam\0"
+	"Phecda\0"
+	"Sargas\0"
+	"Scheat\0"
+	"Shaula\0"
+	"Suhail\0"
+	"Szedar\0"
+	"Acrab\0"
+	"Adara\0"
+	"Algol\0"
+	"Ankaa\0"
+	"Arneb\0"
+	"Atria\0"
+	"Avior\0"
+	"Deneb\0"
+	"Dubhe\0"
+	"Hadar\0"
+	"Hamal\0"
+	"Merak\0"
+	"Mizar\0"
+	"Nunki\0"
+	"Rigel\0"
+	"Spica\0"
+	"Tiaki\0"
+	"Wezen\0"
+	"Zosma\0"
+	"Caph\0"
+	"Enif\0"
+	"Naos\0"
+	"Sadr\0"
+	"Saif\0"
+	"Wega\0";
+
+constexpr const uint16_t STARS_NAME_OFFSETS[] = {
+	384, 730, 59, 736, 294, 304, 132, 0, 116, 177, 314, 420, 742, 548, 555, 428,
+	562, 569, 576, 436, 444, 452, 393, 324, 334, 583, 590, 748, 460, 597, 754, 344,
+	760, 766, 354, 364, 844, 147, 772, 402, 604, 411, 778, 611, 468, 849, 99, 247,
+	374, 618, 81, 191, 784, 790, 476, 34, 205, 625, 162, 632, 484, 639, 646, 272,
+	653, 492, 796, 260, 660, 667, 674, 681, 802, 854, 808, 500, 688, 508, 516, 524,
+	283, 532, 814, 859, 864, 695, 702, 709, 820, 716, 540, 723, 826, 869, 832, 219,
+	233, 838
+};
+
+constexpr const float STARS_RA[] = {
+	0.426354847f, 4.2125485f, 3.25764978f, 1.82660342f, 1.20392812f, 5.57885769f, 1.38181789f, 3.83801539f,
+	3.83791212f, 3.25764978f, 3.84814557f, 2.70513671f, 0.821041423f, 1.73534451f, 3.37732846f, 5.43760965f,
+	3.61082442f, 0.5406121f, 5.79551123f, 1.46700741f, 1.48683872f, 2.47656403f, 4.07834722f, 0.0365981f,
+	2.28945019f, 5.19577246f, 1.93812268f, 0.114689948f, 4.3170719f, 3.73352834f, 1.45180851f, 2.43076368f,
+	4.40113132f, 2.19262805f, 1.41865452f, 1.54972948f, 0.0400480341f, 3.17806276f, 5.41676751f, 3.09385644f,
+	0.190182711f, 4.19024465f, 2.89606119f, 1.42371598f, 4.69758277f, 5.69058785f, 3.57743046f, 3.82011849f,
+	6.01113938f, 3.27757562f, 0.247436782f, 2.13599212f, 3.68187387f, 0.554899074f, 1.67530592f, 1.38181789f,
+	4.63597992f, 1.98356669f, 4.81785777f, 3.88643373f, 4.40766904f, 6.04216261f, 2.45268211f, 1.56873829f,
+	0.79534654f, 3.69437479f, 2.88782905f, 2.41379036f, 3.34981043f, 0.304263249f, 0.891528726f, 1.66984376f,
+	3.50778455f, 2.11003762f, 4.95352803f, 5.34789972f, 3.11467095f, 0.662403357f, 2.03035606f, 2.00408159f,
+	4.60302229f, 2.65452216f, 1.3724302f, 5.33297716f, 1.51737471f, 4.61342154f, 6.03785746f, 4.59724088f,
+	3.5133187f, 2.39108653f, 1.76779455f, 0.176750948f, 5.94576226f, 4.87356577f, 1.86921127f, 3.64573101f,
+	4.35092402f, 2.94135248f
+};
+
+constexpr const float STARS_DEC[] = {
+	-0.998968286f, -0.345672155f, -1.1012869f, -0.505655821f, 0.288139315f, 1.09232401f, 0.802816404f, -1.06175316f,
+	-1.06180867f, -1.1012869f, -0.827082444f, 0.346302412f, 0.714810891f, 0.286219453f, 0.976683341f, 0.59289271f,
+	0.860680032f, 0.738793073f, -0.819623585f, -0.0209774032f, -0.0339078689f, -0.151121273f, 0.466259862f, 0.507723842f,
+	-0.954840545f, 0.154781422f, -0.5114348f, -0.738378509f, -0.461324458f, 0.334792936f, -0.311057912f, -1.03454876f,
+	-1.204762f, -1.03864059f, 0.110823559f, 0.129277653f, 1.0323574f, -0.88527463f, 0.790289933f, 0.254330445f,
+	-0.313926555f, -0.394822566f, 1.07775536f, 0.499295066f, 0.898652094f, 0.172351264f, -0.933164525f, -0.735792028f,
+	-0.51700531f, -0.996815713f, 1.05970574f, -0.82618069f, -1.0537086f, 0.409496518f, -0.919712788f, 0.802816404f,
+	-0.681202007f, 0.55655641f, -0.600119343f, 1.2942586f, -0.598531578f, 0.265381676f, -0.960120166f, 0.784481866f,
+	0.0713791183f, 0.634753463f, 0.984060266f, -1.21679507f, -1.04176279f, 0.621696024f, 0.870240558f, -0.313389866f,
+	0.95862694f, -0.698187939f, -0.458963416f, -0.990212551f, 0.937149694f, 1.55795361f, 0.489152764f, 0.0911886053f,
+	0.219213354f, 0.20886743f, -0.143145651f, 0.702611379f, -0.168768491f, -0.750452793f, 0.490136935f, -0.647580178f,
+	-0.194802985f, -0.758040127f, -0.291751274f, 0.986763102f, -0.765932894f, 0.676903116f, -0.460650567f, 0.825337114f,
+	-0.184429912f, 0.358206528f
+};
+
+// brightest_stars.txt text the arrays were generated from, never used at run time
+constexpr const std::string_view STARS_RA_TEXT[] = {
+	"01h 37m 42,8s", "16h 05m 26,7s", "12h 26m 35,90s", "6h 58m 37,6s",
+	"4h 35m 55,2s", "21h 18m 34,8s", "5h 16m 41,36s", "14h 39m 36,50s",
+	"14h 39m 35,08s", "12h 26m 35,90s", "14h 41m 55,8s", "10h 19m 58,3s",
+	"3h 08m 10,13s", "6h 37m 42,7s", "12h 54m 01,6s", "20h 46m 12,5s",
+	"13h 47m 32,4s", "2h 03m 53,95s", "22h 08m 14,0s", "5h 36m 12,8s",
+	"5h 40m 45,5s", "9h 27m 35,2s", "15h 34m 41,3s", "0h 08m 23,26s",
+	"8h 44m 42,2s", "19h 50m 47,00s", "7h 24m 11,1s", "0h 26m 17,1s",
+	"16h 29m 24s", "14h 15m 39,7s", "5h 32m 43,8s", "9h 17m 05,4s",
+	"16h 48m 39,9s", "8h 22m 30,8s", "5h 25m 07,9s", "5h 55m 10,31s",
+	"0h 09m 10,7s", "12h 08m 21,5s", "20h 41m 25,9s", "11h 49m 03,58s",
+	"0h 43m 35,2s", "16h 00m 20,0s", "11h 03m 43,7s", "5h 26m 17,5s",
+	"17h 56m 36,4s", "21h 44m 11,2s", "13h 39m 53,2s", "14h 35m 30,4s",
+	"22h 57m 39,1s", "12h 31m 9,9s", "0h 56m 42,5s", "8h 09m 32,0s",
+	"14h 03m 49,4s", "2h 07m 10,41s", "6h 23m 57,11s", "5h 16m 41,36s",
+	"17h 42m 29,3s", "7h 34m 36s", "18h 24m 10,3s", "14h 50m 42,3s",
+	"16h 50m 09,8s", "23h 04m 45,7s", "9h 22m 06,8s", "5h 59m 31,7s",
+	"3h 02m 16,8s", "14h 06m 41,3s", "11h 01m 50,5s", "9h 13m 12,0s",
+	"12h 47m 43,2s", "1h 09m 43,92s", "3h 24m 19,4s", "6h 22m 42s",
+	"13h 23m 55,5s", "8h 03m 35,1s", "18h 55m 15,9s", "20h 25m 38,9s",
+	"11h 53m 49,8s", "2h 31m 48,7s", "7h 45m 19,4s", "7h 39m 18,1s",
+	"17h 34m 56,1s", "10h 08m 22,3s", "5h 14m 32,27s", "20h 22m 13,7s",
+	"5h 47m 45,4s", "17h 37m 19,1s", "23h 03m 46,5s", "17h 33m 36,6s",
+	"13h 25m 11,6s", "9h 07m 59,8s", "6h 45m 08,92s", "0h 40m 30,5s",
+	"22h 42m 40,1s", "18h 36m 56,34s", "7h 08m 23,5s", "13h 55m 32,4s",
+	"16h 37m 09,5s", "11h 14m 06,5s"
+};
+
+constexpr const std::string_view STARS_DEC_TEXT[] = {
+	"−57° 14′ 12″", "−19° 48′ 20″", "−63° 05′ 56,73″", "−28° 58′ 19″",
+	"16° 30′ 33″", "62° 35′ 08,0″", "45° 59′ 52,77″", "−60° 50′ 02,31″",
+	"−60° 50′ 13,76″", "−63° 05′ 56,73″", "−47° 23′ 18″", "19° 50′ 30″",
+	"40° 57′ 20,33″", "16° 23′ 57″", "55° 57′ 35,4″", "33° 58′ 12,9″",
+	"49° 18′ 48″", "42° 19′ 47,01″", "−46° 57′ 39,5″", "−1° 12′ 06,9″",
+	"−1° 56′ 34″", "−8° 39′ 31″", "26° 42′ 53″", "29° 05′ 25,56″",
+	"−54° 42′ 30″", "8° 52′ 05,96″", "−29° 18′ 11″", "−42° 18′ 21,5″",
+	"−26° 25′ 55″", "19° 10′ 56″", "−17° 49′ 20,3″", "−59° 16′ 31″",
+	"−69° 01′ 40″", "−59° 30′ 35″", "6° 20′ 59″", "7° 24′ 25,43″",
+	"59° 08′ 59″", "−50° 43′ 21″", "45° 16′ 49″", "14° 34′ 19,42″",
+	"−17° 59′ 12″", "−22° 37′ 18″", "61° 45′ 03″", "28° 36′ 27″",
+	"51° 29′ 20,3″", "9° 52′ 30,0″", "−53° 27′ 59″", "−42° 09′ 28″",
+	"−29° 37′ 20″", "−57° 06′ 48″", "60° 43′ 00″", "−47° 20′ 12,0″",
+	"−60° 22′ 23″", "23° 27′ 44,72″", "−52° 41′ 44,38″", "45° 59′ 52,77″",
+	"−39° 01′ 48″", "31° 53′ 18″", "−34° 23′ 03,5″", "74° 09′ 20″",
+	"−34° 17′ 36″", "15° 12′ 18,9″", "−55° 00′ 39″", "44° 56′ 51″",
+	"4° 05′ 23,0″", "36° 22′ 07,3″", "56° 22′ 57″", "−69° 43′ 02″",
+	"−59° 41′ 19″", "35° 37′ 14,01″", "49° 51′ 40″", "−17° 57′ 21,3″",
+	"54° 55′ 31″", "−40° 00′ 11,6″", "−26° 17′ 48″", "−56° 44′ 06″",
+	"53° 41′ 41″", "89° 15′ 51″", "28° 01′ 35″", "5° 13′ 29″",
+	"12° 33′ 36″", "11° 58′ 02″", "−8° 12′ 05,91″", "40° 15′ 24″",
+	"−9° 40′ 11″", "−42° 59′ 52″", "28° 04′ 58,0″", "−37° 06′ 13″",
+	"−11° 09′ 41″", "−43° 25′ 57″", "−16° 42′ 58,02″", "56° 32′ 14,5″",
+	"−43° 53′ 05″", "38° 47′ 01,29″", "−26° 23′ 36″", "47° 17′ 18″",
+	"−10° 34′ 01,4″", "20° 31′ 25,4″"
+};
+
+static_assert(matchesSource(STARS_RA_TEXT, STARS_DEC_TEXT, STARS_RA, STARS_DEC), "STARS_RA or STARS_DEC does not match brightest_stars.txt");
+
+constexpr const float STARS_X[] = {
+	0.492724224f, -0.450934805f, -0.449405191f, -0.221361845f, 0.343906399f, 0.350864465f, 0.130500211f, -0.373860396f,
+	-0.373855487f, -0.449405191f, -0.514948761f, -0.852454933f, 0.514649871f, -0.15714267f, -0.544292147f, 0.550093632f,
+	-0.581459592f, 0.633855677f, 0.602934432f, 0.103579881f, 0.0838108059f, -0.777930751f, -0.529169968f, 0.873268251f,
+	-0.38036715f, 0.459221357f, -0.313169393f, 0.734702256f, -0.344843821f, -0.783786877f, 0.113010523f, -0.387181405f,
+	-0.109613743f, -0.295568605f, 0.150625803f, 0.020889509f, 0.512385248f, -0.632655966f, 0.455648954f, -0.966729459f,
+	0.933979283f, -0.46036925f, -0.459111567f, 0.128659778f, -0.00921897556f, 0.817203196f, -0.539644155f, -0.577100704f,
+	0.837333067f, -0.537966566f, 0.474231552f, -0.362957583f, -0.423937403f, 0.779680642f, -0.0632226579f, 0.130500211f,
+	-0.059298067f, -0.340606925f, 0.0868787651f, -0.200727936f, -0.247870664f, 0.93709875f, -0.442646473f, 0.00145658165f,
+	0.698254761f, -0.685294424f, -0.5359151f, -0.258824904f, -0.493798176f, 0.775554036f, 0.404979581f, -0.0940692443f,
+	-0.536543982f, -0.393333838f, 0.214095073f, 0.32559057f, -0.591872861f, 0.0101264127f, -0.391538603f, -0.418110323f,
+	-0.106536741f, -0.864501608f, 0.195052178f, 0.443786465f, 0.0526375797f, -0.0722647202f, 0.855851306f, -0.0916330853f,
+	-0.914079423f, -0.53109075f, -0.187455414f, 0.542802504f, 0.680094337f, 0.125096663f, -0.263359457f, -0.593921532f,
+	-0.347647427f, -0.91781421f
+};
+
+constexpr const float STARS_Y[] = {
+	0.223803481f, -0.825743671f, -0.0523921127f, 0.84638862f, 0.894972913f, -0.298134216f, 0.682315893f, -0.31261891f,
+	-0.31254921f, -0.0523921127f, -0.439535849f, 0.397634573f, 0.552710182f, 0.946360059f, -0.130739967f, -0.620630018f,
+	-0.294799907f, 0.380479455f, -0.319798952f, 0.99439993f, 0.995904838f, 0.610048712f, -0.719642452f, 0.0319742357f,
+	0.434859847f, -0.874842365f, 0.813869907f, 0.0846343772f, -0.826400638f, -0.526989103f, 0.94527893f, 0.333352f,
+	-0.340717164f, 0.412414832f, 0.982384958f, 0.99143523f, 0.0205309992f, -0.0230832672f, -0.536183121f, 0.0461830851f,
+	0.17979971f, -0.800068016f, 0.115047589f, 0.868441551f, -0.622597004f, -0.550242623f, -0.251315391f, -0.465273654f,
+	-0.233584123f, -0.0736085568f, 0.119797227f, 0.572297537f, -0.254282719f, 0.483297678f, 0.602741941f, 0.682315893f,
+	-0.774549786f, 0.777767659f, -0.820682472f, -0.185072412f, -0.788103327f, -0.230339733f, 0.364522106f, 0.707752906f,
+	0.712287833f, -0.422785335f, 0.138992144f, 0.230604578f, -0.104329661f, 0.243534546f, 0.50155329f, 0.946631521f,
+	-0.205758507f, 0.657310578f, -0.87057305f, -0.441425372f, 0.0159380765f, 0.00789822835f, 0.791146019f, 0.903820457f,
+	-0.970237217f, 0.457866886f, 0.970362584f, -0.620856356f, 0.984386042f, -0.727801304f, -0.214280378f, -0.792264385f,
+	-0.356354044f, 0.495264578f, 0.939217488f, 0.0969525949f, -0.238604371f, -0.769413065f, 0.856174063f, -0.327659458f,
+	-0.919516606f, 0.186279652f
+};
+
+constexpr const float STARS_Z[] = {
+	-0.8409131f, -0.338829149f, -0.891790357f, -0.484381294f, 0.284168741f, 0.887699339f, 0.719315451f, -0.873211213f,
+	-0.873238264f, -0.891790357f, -0.735959245f, 0.339422058f, 0.65547461f, 0.282327504f, 0.828645352f, 0.558762362f,
+	0.758286066f, 0.673396143f, -0.73088898f, -0.0209758647f, -0.0339013717f, -0.15054672f, 0.449548537f, 0.48618948f,
+	-0.816221627f, 0.154164138f, -0.489428958f, -0.673089605f, -0.445134501f, 0.328573609f, -0.306065951f, -0.8596319f,
+	-0.933754058f, -0.86171527f, 0.110596845f, 0.128917857f, 0.858510242f, -0.774088878f, 0.710557311f, 0.251597449f,
+	-0.308795665f, -0.384644411f, 0.880897622f, 0.478806782f, 0.782488326f, 0.171499249f, -0.803507785f, -0.671174496f,
+	-0.494279064f, -0.839746244f, 0.872211591f, -0.735348436f, -0.869262548f, 0.398147524f, -0.795427588f, 0.719315451f,
+	-0.629727217f, 0.528265455f, -0.564740967f, 0.962006496f, -0.563429924f, 0.262277602f, -0.81926048f, 0.706458564f,
+	0.0713185212f, 0.592979016f, 0.832752178f, -0.937993176f, -0.863295247f, 0.582414682f, 0.764484033f, -0.308285161f,
+	0.818403319f, -0.64283069f, -0.443019035f, -0.836142584f, 0.805873746f, 0.999917533f, 0.469878175f, 0.0910622801f,
+	0.21746187f, 0.207352078f, -0.142657293f, 0.646212781f, -0.167968464f, -0.681969994f, 0.470746706f, -0.603258255f,
+	-0.19357325f, -0.687499537f, -0.287629933f, 0.834245549f, -0.69320967f, 0.62638196f, -0.444530955f, 0.734776492f,
+	-0.183386143f, 0.350595162f
+};
+
+constexpr const float STARS_MAGNITUDE[] = {
+	0.45f, 2.56f, 1.4f, 1.5f, 0.87f, 2.45f, 0.96f, -0.01f,
+	1.35f, 2.09f, 2.3f, 2.28f, 2.12f, 1.93f, 1.76f, 2.5f,
+	1.85f, 2.26f, 1.73f, 1.7f, 1.7f, 1.99f, 2.24f, 2.22f,
+	2.03f, 0.76f, 2.45f, 2.4f, 1.06f, -0.05f, 2.58f, 2.21f,
+	1.91f, 2.4f, 1.64f, 0.45f, 2.28f, 2.58f, 1.25f, 2.14f,
+	2.04f, 2.29f, 1.87f, 1.65f, 2.24f, 2.38f, 2.29f, 2.33f,
+	1.17f, 1.63f, 2.15f, 1.78f, 0.61f, 2.01f, -0.62f, 0.71f,
+	2.39f, 1.96f, 1.79f, 2.07f, 2.29f, 2.49f, 2.47f, 1.9f,
+	2.54f, 2.06f, 2.34f, 1.67f, 1.25f, 2.07f, 1.79f, 1.98f,
+	2.3f, 2.21f, 2.05f, 1.94f, 2.41f, 1.97f, 1.16f, 0.4f,
+	2.08f, 1.35f, 0.18f, 2.23f, 2.06f, 1.86f, 2.44f, 1.62f,
+	0.98f, 2.23f, -1.44f, 2.24f, 2.07f, 0.03f, 1.83f, 2.55f,
+	2.54f, 2.56f
+};
+
+constexpr const ObjectType STARS_TYPE[] = {
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR, ObjectType::STAR, ObjectType::STAR,
+	ObjectType::STAR, ObjectType::STAR
+};
+
 // TODO print all available stars on startup
-using StarObject = CelestialObject<Star>;
-constexpr const std::array<StarObject, static_cast<unsigned int>(Star::last) + 1> STARS = {{
-	StarObject(Star::Achernar, "Achernar", RA{1.0, 37.0, 42.8}, Dec{-57.0, 14.0, 12.0}),
-	StarObject(Star::Acrab, "Acrab", RA{16.0, 5.0, 26.7}, Dec{-19.0, 48.0, 20.0}),
-	StarObject(Star::Acrux__Alfa_Cruc, "Acrux (Alfa Cruc", RA{12.0, 26.0, 35.9}, Dec{-63.0, 5.0, 56.73}),
-	StarObject(Star::Adara, "Adara", RA{6.0, 58.0, 37.6}, Dec{-28.0, 58.0, 19.0}),
-	StarObject(Star::Aldebaran, "Aldebaran", RA{4.0, 35.0, 55.2}, Dec{16.0, 30.0, 33.0}),
-	StarObject(Star::Alderamin, "Alderamin", RA{21.0, 18.0, 34.8}, Dec{62.0, 35.0, 8.0}),
-	StarObject(Star::Alfa_Aurigae_B, "Alfa Aurigae B", RA{5.0, 16.0, 41.36}, Dec{45.0, 59.0, 52.77}),
-	StarObject(Star::Alfa_Centauri_A_, "Alfa Centauri A ", RA{14.0, 39.0, 36.5}, Dec{-60.0, 50.0, 2.31}),
-	StarObject(Star::Alfa_Centauri_B, "Alfa Centauri B", RA{14.0, 39.0, 35.08}, Dec{-60.0, 50.0, 13.76}),
-	StarObject(Star::Alfa_Crucis_B, "Alfa Crucis B", RA{12.0, 26.0, 35.9}, Dec{-63.0, 5.0, 56.73}),
-	StarObject(Star::Alfa_Lupi, "Alfa Lupi", RA{14.0, 41.0, 55.8}, Dec{-47.0, 23.0, 18.0}),
-	StarObject(Star::Algieba, "Algieba", RA{10.0, 19.0, 58.3}, Dec{19.0, 50.0, 30.0}),
-	StarObject(Star::Algol, "Algol", RA{3.0, 8.0, 10.13}, Dec{40.0, 57.0, 20.33}),
-	StarObject(Star::Alhena, "Alhena", RA{6.0, 37.0, 42.7}, Dec{16.0, 23.0, 57.0}),
-	StarObject(Star::Alioth, "Alioth", RA{12.0, 54.0, 1.6}, Dec{55.0, 57.0, 35.4}),
-	StarObject(Star::Aljanah, "Aljanah", RA{20.0, 46.0, 12.5}, Dec{33.0, 58.0, 12.9}),
-	StarObject(Star::Alkaid, "Alkaid", RA{13.0, 47.0, 32.4}, Dec{49.0, 18.0, 48.0}),
-	StarObject(Star::Almach, "Almach", RA{2.0, 3.0, 53.95}, Dec{42.0, 19.0, 47.01}),
-	StarObject(Star::Alnair, "Alnair", RA{22.0, 8.0, 14.0}, Dec{-46.0, 57.0, 39.5}),
-	StarObject(Star::Alnilam, "Alnilam", RA{5.0, 36.0, 12.8}, Dec{-1.0, 12.0, 6.9}),
-	StarObject(Star::Alnitak, "Alnitak", RA{5.0, 40.0, 45.5}, Dec{-1.0, 56.0, 34.0}),
-	StarObject(Star::Alphard, "Alphard", RA{9.0, 27.0, 35.2}, Dec{-8.0, 39.0, 31.0}),
-	StarObject(Star::Alphecca, "Alphecca", RA{15.0, 34.0, 41.3}, Dec{26.0, 42.0, 53.0}),
-	StarObject(Star::Alpheratz, "Alpheratz", RA{0.0, 8.0, 23.26}, Dec{29.0, 5.0, 25.56}),
-	StarObject(Star::Alsephina, "Alsephina", RA{8.0, 44.0, 42.2}, Dec{-54.0, 42.0, 30.0}),
-	StarObject(Star::Altair, "Altair", RA{19.0, 50.0, 47.0}, Dec{8.0, 52.0, 5.96}),
-	StarObject(Star::Aludra, "Aludra", RA{7.0, 24.0, 11.1}, Dec{-29.0, 18.0, 11.0}),
-	StarObject(Star::Ankaa, "Ankaa", RA{0.0, 26.0, 17.1}, Dec{-42.0, 18.0, 21.5}),
-	StarObject(Star::Antares, "Antares", RA{16.0, 29.0, 24.0}, Dec{-26.0, 25.0, 55.0}),
-	StarObject(Star::Arktur, "Arktur", RA{14.0, 15.0, 39.7}, Dec{19.0, 10.0, 56.0}),
-	StarObject(Star::Arneb, "Arneb", RA{5.0, 32.0, 43.8}, Dec{-17.0, 49.0, 20.3}),
-	StarObject(Star::Aspidiske, "Aspidiske", RA{9.0, 17.0, 5.4}, Dec{-59.0, 16.0, 31.0}),
-	StarObject(Star::Atria, "Atria", RA{16.0, 48.0, 39.9}, Dec{-69.0, 1.0, 40.0}),
-	StarObject(Star::Avior, "Avior", RA{8.0, 22.0, 30.8}, Dec{-59.0, 30.0, 35.0}),
-	StarObject(Star::Bellatrix, "Bellatrix", RA{5.0, 25.0, 7.9}, Dec{6.0, 20.0, 59.0}),
-	StarObject(Star::Betelgeza, "Betelgeza", RA{5.0, 55.0, 10.31}, Dec{7.0, 24.0, 25.43}),
-	StarObject(Star::Caph, "Caph", RA{0.0, 9.0, 10.7}, Dec{59.0, 8.0, 59.0}),
-	StarObject(Star::Delta_Centauri, "Delta Centauri", RA{12.0, 8.0, 21.5}, Dec{-50.0, 43.0, 21.0}),
-	StarObject(Star::Deneb, "Deneb", RA{20.0, 41.0, 25.9}, Dec{45.0, 16.0, 49.0}),
-	StarObject(Star::Denebola, "Denebola", RA{11.0, 49.0, 3.58}, Dec{14.0, 34.0, 19.42}),
-	StarObject(Star::Diphda, "Diphda", RA{0.0, 43.0, 35.2}, Dec{-17.0, 59.0, 12.0}),
-	StarObject(Star::Dschubba, "Dschubba", RA{16.0, 0.0, 20.0}, Dec{-22.0, 37.0, 18.0}),
-	StarObject(Star::Dubhe, "Dubhe", RA{11.0, 3.0, 43.7}, Dec{61.0, 45.0, 3.0}),
-	StarObject(Star::Elnath, "Elnath", RA{5.0, 26.0, 17.5}, Dec{28.0, 36.0, 27.0}),
-	StarObject(Star::Eltanin, "Eltanin", RA{17.0, 56.0, 36.4}, Dec{51.0, 29.0, 20.3}),
-	StarObject(Star::Enif, "Enif", RA{21.0, 44.0, 11.2}, Dec{9.0, 52.0, 30.0}),
-	StarObject(Star::Epsilon_Centauri, "Epsilon Centauri", RA{13.0, 39.0, 53.2}, Dec{-53.0, 27.0, 59.0}),
-	StarObject(Star::Eta_Centauri, "Eta Centauri", RA{14.0, 35.0, 30.4}, Dec{-42.0, 9.0, 28.0}),
-	StarObject(Star::Fomalhaut, "Fomalhaut", RA{22.0, 57.0, 39.1}, Dec{-29.0, 37.0, 20.0}),
-	StarObject(Star::Gacrux, "Gacrux", RA{12.0, 31.0, 9.9}, Dec{-57.0, 6.0, 48.0}),
-	StarObject(Star::Gamma_Cassiopeia, "Gamma Cassiopeia", RA{0.0, 56.0, 42.5}, Dec{60.0, 43.0, 0.0}),
-	StarObject(Star::Gamma_Velorum, "Gamma Velorum", RA{8.0, 9.0, 32.0}, Dec{-47.0, 20.0, 12.0}),
-	StarObject(Star::Hadar, "Hadar", RA{14.0, 3.0, 49.4}, Dec{-60.0, 22.0, 23.0}),
-	StarObject(Star::Hamal, "Hamal", RA{2.0, 7.0, 10.41}, Dec{23.0, 27.0, 44.72}),
-	StarObject(Star::Kanopus, "Kanopus", RA{6.0, 23.0, 57.11}, Dec{-52.0, 41.0, 44.38}),
-	StarObject(Star::Kapella__Alfa_Au, "Kapella (Alfa Au", RA{5.0, 16.0, 41.36}, Dec{45.0, 59.0, 52.77}),
-	StarObject(Star::Kappa_Scorpii, "Kappa Scorpii", RA{17.0, 42.0, 29.3}, Dec{-39.0, 1.0, 48.0}),
-	StarObject(Star::Kastor, "Kastor", RA{7.0, 34.0, 36.0}, Dec{31.0, 53.0, 18.0}),
-	StarObject(Star::Kaus_Australis, "Kaus Australis", RA{18.0, 24.0, 10.3}, Dec{-34.0, 23.0, 3.5}),
-	StarObject(Star::Kochab, "Kochab", RA{14.0, 50.0, 42.3}, Dec{74.0, 9.0, 20.0}),
-	StarObject(Star::Larawag, "Larawag", RA{16.0, 50.0, 9.8}, Dec{-34.0, 17.0, 36.0}),
-	StarObject(Star::Markab, "Markab", RA{23.0, 4.0, 45.7}, Dec{15.0, 12.0, 18.9}),
-	StarObject(Star::Markeb, "Markeb", RA{9.0, 22.0, 6.8}, Dec{-55.0, 0.0, 39.0}),
-	StarObject(Star::Menkalinan, "Menkalinan", RA{5.0, 59.0, 31.7}, Dec{44.0, 56.0, 51.0}),
-	StarObject(Star::Menkar, "Menkar", RA{3.0, 2.0, 16.8}, Dec{4.0, 5.0, 23.0}),
-	StarObject(Star::Menkent, "Menkent", RA{14.0, 6.0, 41.3}, Dec{36.0, 22.0, 7.3}),
-	StarObject(Star::Merak, "Merak", RA{11.0, 1.0, 50.5}, Dec{56.0, 22.0, 57.0}),
-	StarObject(Star::Miaplacidus, "Miaplacidus", RA{9.0, 13.0, 12.0}, Dec{-69.0, 43.0, 2.0}),
-	StarObject(Star::Mimosa, "Mimosa", RA{12.0, 47.0, 43.2}, Dec{-59.0, 41.0, 19.0}),
-	StarObject(Star::Mirach, "Mirach", RA{1.0, 9.0, 43.92}, Dec{35.0, 37.0, 14.01}),
-	StarObject(Star::Mirfak, "Mirfak", RA{3.0, 24.0, 19.4}, Dec{49.0, 51.0, 40.0}),
-	StarObject(Star::Mirzam, "Mirzam", RA{6.0, 22.0, 42.0}, Dec{-17.0, 57.0, 21.3}),
-	StarObject(Star::Mizar, "Mizar", RA{13.0, 23.0, 55.5}, Dec{54.0, 55.0, 31.0}),
-	StarObject(Star::Naos, "Naos", RA{8.0, 3.0, 35.1}, Dec{-40.0, 0.0, 11.6}),
-	StarObject(Star::Nunki, "Nunki", RA{18.0, 55.0, 15.9}, Dec{-26.0, 17.0, 48.0}),
-	StarObject(Star::Peacock, "Peacock", RA{20.0, 25.0, 38.9}, Dec{-56.0, 44.0, 6.0}),
-	StarObject(Star::Phecda, "Phecda", RA{11.0, 53.0, 49.8}, Dec{53.0, 41.0, 41.0}),
-	StarObject(Star::Polaris, "Polaris", RA{2.0, 31.0, 48.7}, Dec{89.0, 15.0, 51.0}),
-	StarObject(Star::Polluks, "Polluks", RA{7.0, 45.0, 19.4}, Dec{28.0, 1.0, 35.0}),
-	StarObject(Star::Procjon, "Procjon", RA{7.0, 39.0, 18.1}, Dec{5.0, 13.0, 29.0}),
-	StarObject(Star::Rasalhague, "Rasalhague", RA{17.0, 34.0, 56.1}, Dec{12.0, 33.0, 36.0}),
-	StarObject(Star::Regulus, "Regulus", RA{10.0, 8.0, 22.3}, Dec{11.0, 58.0, 2.0}),
-	StarObject(Star::Rigel, "Rigel", RA{5.0, 14.0, 32.27}, Dec{-8.0, 12.0, 5.91}),
-	StarObject(Star::Sadr, "Sadr", RA{20.0, 22.0, 13.7}, Dec{40.0, 15.0, 24.0}),
-	StarObject(Star::Saif, "Saif", RA{5.0, 47.0, 45.4}, Dec{-9.0, 40.0, 11.0}),
-	StarObject(Star::Sargas, "Sargas", RA{17.0, 37.0, 19.1}, Dec{-42.0, 59.0, 52.0}),
-	StarObject(Star::Scheat, "Scheat", RA{23.0, 3.0, 46.5}, Dec{28.0, 4.0, 58.0}),
-	StarObject(Star::Shaula, "Shaula", RA{17.0, 33.0, 36.6}, Dec{-37.0, 6.0, 13.0}),
-	StarObject(Star::Spica, "Spica", RA{13.0, 25.0, 11.6}, Dec{-11.0, 9.0, 41.0}),
-	StarObject(Star::Suhail, "Suhail", RA{9.0, 7.0, 59.8}, Dec{-43.0, 25.0, 57.0}),
-	StarObject(Star::Syriusz, "Syriusz", RA{6.0, 45.0, 8.92}, Dec{-16.0, 42.0, 58.02}),
-	StarObject(Star::Szedar, "Szedar", RA{0.0, 40.0, 30.5}, Dec{56.0, 32.0, 14.5}),
-	StarObject(Star::Tiaki, "Tiaki", RA{22.0, 42.0, 40.1}, Dec{-43.0, 53.0, 5.0}),
-	StarObject(Star::Wega, "Wega", RA{18.0, 36.0, 56.34}, Dec{38.0, 47.0, 1.29}),
-	StarObject(Star::Wezen, "Wezen", RA{7.0, 8.0, 23.5}, Dec{-26.0, 23.0, 36.0}),
-	StarObject(Star::Zeta_Centauri, "Zeta Centauri", RA{13.0, 55.0, 32.4}, Dec{47.0, 17.0, 18.0}),
-	StarObject(Star::Zeta_Ophiuchi, "Zeta Ophiuchi", RA{16.0, 37.0, 9.5}, Dec{-10.0, 34.0, 1.4}),
-	StarObject(Star::Zosma, "Zosma", RA{11.0, 14.0, 6.5}, Dec{20.0, 31.0, 25.4})
-}};
+constexpr const Catalog STARS{
+	static_cast<unsigned int>(Star::last) + 1,
+	STARS_NAMES, STARS_NAME_OFFSETS,
+	STARS_RA, STARS_DEC,
+	STARS_X, STARS_Y, STARS_Z,
+	STARS_MAGNITUDE, STARS_TYPE
+};
 
 }
\ No newline at end of file
@@ -3,9 +3,8 @@
 #include <Arduino.h>
 
 #include <array>
-#include <exception>
-#include <stdexcept>
-#include <string>
+#include <cmath>
+#include <string_view>
 #include <tuple>
 
 #include <functional>
@@ -17,23 +16,6 @@ namespace coords {
 struct RA {
 	constexpr RA(double h, double m, double s) : h(h), m(m), s(s) {}
 
-	// accepts hh:mm:ss.ss format
-	RA(std::string ra) {
-		auto hoursEnd = ra.find(':');
-		if (hoursEnd == std::string::npos) {
-			throw std::invalid_argument("Invalid RA format. Must be hh:mm:ss.ss");
-		}
-		h = atof(ra.substr(0, hoursEnd).c_str());
-		hoursEnd++;
-		auto minutesEnd = ra.find(':', hoursEnd);
-		if (minutesEnd == std::string::npos) {
-			throw std::invalid_argument("Invalid RA format. Must be hh:mm:ss.ss");
-		}
-		m = atof(ra.substr(hoursEnd, minutesEnd - hoursEnd).c_str());
-		minutesEnd++;
-		s = atof(ra.substr(minutesEnd, ra.length() - minutesEnd).c_str());
-	}
-
 	double h, m, s;
 
 	constexpr double deg() const {
@@ -44,51 +26,207 @@ struct RA {
 		return deg() * DEG_TO_RAD;
 	}
 
-	std::string str() const {
-		char buf[32];
-		snprintf(buf, sizeof(buf), "%dh%dm%.2fs", static_cast<int>(h), static_cast<int>(m), s);
-		return std::string(buf);
+	// Writes e.g. 5h34m31.94s. Returns false when `size` was too small, text is truncated.
+	bool format(char* buffer, std::size_t size) const {
+		auto count = snprintf(buffer, size, "%dh%dm%.2fs", static_cast<int>(h), static_cast<int>(m), s);
+		return count >= 0 && static_cast<std::size_t>(count) < size;
 	}
 };
 
 struct Dec {
 	constexpr Dec(double d, double m, double s) : d(d), m(m), s(s) {}
 
-	// accepts ddd,mm,ss.ss format
-	Dec(std::string dec) {
-		auto degEnd = dec.find(',');
-		if (degEnd == std::string::npos) {
-			throw std::invalid_argument("Invalid Dec format. Must be ddd,mm,ss.ss");
-		}
-		d = atof(dec.substr(0, degEnd).c_str());
-		degEnd++;
-		auto minutesEnd = dec.find(',', degEnd);
-		if (minutesEnd == std::string::npos) {
-			throw std::invalid_argument("Invalid Dec format. Must be ddd,mm,ss.ss");
-		}
-		m = atof(dec.substr(degEnd, minutesEnd - degEnd).c_str());
-		minutesEnd++;
-		s = atof(dec.substr(minutesEnd, dec.length() - minutesEnd).c_str());
-	}
-
 	double d, m ,s;
 
+	// sign of `d` applies to minutes and seconds as well, also for -0 degrees
 	constexpr double deg() const {
-		return d + m / 60 + s / 3600;
+		auto value = std::fabs(d) + m / 60 + s / 3600;
+		return std::signbit(d) ? -value : value;
 	}
 
 	constexpr double rad() const {
 		return deg() * DEG_TO_RAD;
 	}
 
-	std::string str() const {
-		char buf[32];
-		snprintf(buf, sizeof(buf), "%d^%d\'%.2f\"", static_cast<int>(d), static_cast<int>(m), s);
-		return std::string(buf);
+	// Writes e.g. -5^23'28.00". Returns false when `size` was too small, text is truncated.
+	bool format(char* buffer, std::size_t size) const {
+		auto count = snprintf(buffer, size, "%s%d^%d\'%.2f\"", std::signbit(d) ? "-" : "", static_cast<int>(std::fabs(d)), static_cast<int>(m), s);
+		return count >= 0 && static_cast<std::size_t>(count) < size;
 	}
 };
 
-RA degToRA(double deg) {
+enum class ParseError : uint8_t {
+	NONE,
+	EMPTY,
+	NUMBER,
+	SEPARATOR,
+	TRAILING,
+	RANGE,
+};
+
+constexpr const char* PARSE_ERROR_MESSAGES[] = {
+	"OK", "Empty", "Number expected", "Unknown separator", "Unexpected characters at the end", "Out of range"
+};
+
+template<typename T>
+struct Parsed {
+	T value;
+	ParseError error;
+
+	constexpr explicit operator bool() const { return error == ParseError::NONE; }
+	constexpr const char* message() const { return PARSE_ERROR_MESSAGES[static_cast<std::size_t>(error)]; }
+};
+
+// Up to three sexagesimal fields with optional sign
+struct Sexagesimal {
+	bool negative = false;
+	std::array<double, 3> fields = {0, 0, 0};
+	std::size_t count = 0;
+};
+
+// UTF-8 signs used by the catalog sources: minus, degree, prime, double prime
+constexpr const std::string_view MINUS_SIGN = "−";
+constexpr const std::string_view UNIT_SIGNS[] = {"°", "′", "″"};
+
+constexpr bool startsWith(std::string_view text, std::string_view prefix) {
+	return text.substr(0, prefix.size()) == prefix;
+}
+
+// length of the field separator or unit sign at the start of `text`, 0 when there is none
+constexpr std::size_t separatorLength(std::string_view text) {
+	if (text.empty()) {
+		return 0;
+	}
+	for (auto sign : UNIT_SIGNS) {
+		if (startsWith(text, sign)) {
+			return sign.size();
+		}
+	}
+	switch (text[0]) {
+		case ':':
+		case ',':
+		case '*':
+		case '\'':
+		case '"':
+		case 'h':
+		case 'H':
+		case 'm':
+		case 'M':
+		case 's':
+		case 'S':
+		// LX200 degree sign
+		case '\xDF':
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+constexpr std::string_view skipSpaces(std::string_view text) {
+	while (!text.empty() && text[0] == ' ') {
+		text.remove_prefix(1);
+	}
+	return text;
+}
+
+// Parses fields separated by spaces, ':', ',' or unit signs (h m s, ° ′ ″, LX200 * and 0xDF, ' "). Only the last
+// field may have a fraction; '.' is the decimal mark, ',' is one as well in the third field.
+constexpr ParseError parseSexagesimal(std::string_view text, Sexagesimal& result) {
+	text = skipSpaces(text);
+	if (text.empty()) {
+		return ParseError::EMPTY;
+	}
+	if (text[0] == '+' || text[0] == '-') {
+		result.negative = text[0] == '-';
+		text.remove_prefix(1);
+	} else if (startsWith(text, MINUS_SIGN)) {
+		result.negative = true;
+		text.remove_prefix(MINUS_SIGN.size());
+	}
+	for (;;) {
+		if (result.count == result.fields.size()) {
+			return ParseError::TRAILING;
+		}
+		double value = 0;
+		std::size_t digits = 0;
+		while (!text.empty() && text[0] >= '0' && text[0] <= '9') {
+			value = value * 10 + (text[0] - '0');
+			text.remove_prefix(1);
+			++digits;
+		}
+		auto fraction = !text.empty() && (text[0] == '.' || (text[0] == ',' && result.count == 2));
+		if (fraction) {
+			text.remove_prefix(1);
+			double scale = 0.1;
+			while (!text.empty() && text[0] >= '0' && text[0] <= '9') {
+				value += (text[0] - '0') * scale;
+				scale /= 10;
+				text.remove_prefix(1);
+				++digits;
+			}
+		}
+		if (digits == 0) {
+			return ParseError::NUMBER;
+		}
+		result.fields[result.count++] = value;
+
+		auto separator = separatorLength(text);
+		text.remove_prefix(separator);
+		auto spaced = !text.empty() && text[0] == ' ';
+		text = skipSpaces(text);
+		if (text.empty()) {
+			return ParseError::NONE;
+		}
+		if (fraction) {
+			return ParseError::TRAILING;
+		}
+		if (separator == 0 && !spaced) {
+			return ParseError::SEPARATOR;
+		}
+	}
+}
+
+// hh:mm:ss.s, hh:mm.m (LX200), 5h 34m 31.94s, 6h 45m 08,92s
+constexpr Parsed<RA> parseRA(std::string_view text) {
+	Sexagesimal ra;
+	auto error = parseSexagesimal(text, ra);
+	if (error == ParseError::NONE && (ra.negative || ra.fields[0] >= 24 || ra.fields[1] >= 60 || ra.fields[2] >= 60)) {
+		error = ParseError::RANGE;
+	}
+	return {RA{ra.fields[0], ra.fields[1], ra.fields[2]}, error};
+}
+
+// ±dd:mm:ss.s, ddd,mm,ss.ss, sDD*MM'SS (LX200), −16° 42′ 58,02″
+constexpr Parsed<Dec> parseDec(std::string_view text) {
+	Sexagesimal dec;
+	auto error = parseSexagesimal(text, dec);
+	if (error == ParseError::NONE
+		&& (dec.fields[1] >= 60 || dec.fields[2] >= 60 || dec.fields[0] + dec.fields[1] / 60 + dec.fields[2] / 3600 > 90)) {
+		error = ParseError::RANGE;
+	}
+	return {Dec{dec.negative ? -dec.fields[0] : dec.fields[0], dec.fields[1], dec.fields[2]}, error};
+}
+
+static_assert(parseRA("05h 34m 31.94s") && parseRA("12:30.5") && parseRA("6h 45m 08,92s").value.s > 8.9, "RA parser");
+static_assert(parseDec("−00° 49′ 23.7″").value.rad() < 0 && parseDec("+45*30'10") && parseDec("-12,30,15.5"), "Dec parser");
+static_assert(!parseRA("24:00:00") && !parseRA("12:3a") && !parseDec("+91*00") && !parseDec(""), "Coordinates parser errors");
+
+// True when every catalog source text parses to the generated radians, generated catalogs static_assert it.
+template<std::size_t N>
+constexpr bool matchesSource(const std::string_view (&ra)[N], const std::string_view (&dec)[N], const float (&raRad)[N], const float (&decRad)[N]) {
+	constexpr const double tolerance = 1e-6;
+	for (std::size_t i = 0; i < N; ++i) {
+		auto parsedRA = parseRA(ra[i]);
+		auto parsedDec = parseDec(dec[i]);
+		if (!parsedRA || !parsedDec
+			|| std::fabs(parsedRA.value.rad() - raRad[i]) > tolerance || std::fabs(parsedDec.value.rad() - decRad[i]) > tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+inline RA degToRA(double deg) {
 	static constexpr const auto hoursFactor = 15.0;
 	static constexpr const auto minutesFactor = 15.0/60;
 	static constexpr const auto secondsFactor = 15.0/3600;
@@ -102,39 +240,133 @@ RA degToRA(double deg) {
 	return RA{hours, minutes, seconds};
 }
 
-Dec degToDec(double deg) {
+inline Dec degToDec(double deg) {
 	static constexpr const auto degreesFactor = 1.0;
 	static constexpr const auto minutesFactor = 1.0/60;
 	static constexpr const auto secondsFactor = 1.0/3600;
 
+	auto negative = deg < 0;
+	deg = std::fabs(deg);
 	auto degrees = std::floor(deg / degreesFactor);
 	deg = std::fmod(deg, degreesFactor);
 	auto minutes = std::floor(deg / minutesFactor);
 	deg = std::fmod(deg, minutesFactor);
 	auto seconds = deg / secondsFactor;
 
-	return Dec{degrees, minutes, seconds};
+	return Dec{negative ? -degrees : degrees, minutes, seconds};
 }
 
-struct CelestialObjectBase {
-	constexpr CelestialObjectBase(const char* name, RA ra, Dec dec) : name_(name), ra_(std::move(ra)), dec_(std::move(dec)) {}
+enum class ObjectType : uint8_t {
+	STAR,
+	OPEN_CLUSTER,
+	GLOBULAR_CLUSTER,
+	NEBULA,
+	PLANETARY_NEBULA,
+	SUPERNOVA_REMNANT,
+	GALAXY,
+	OTHER
+};
 
-	const char* name_;
-	RA ra_;
-	Dec dec_;
+// Catalog in structure of arrays layout, generated by CelestialObjects/*/generate_*.py. Batch algorithms
+// stream through the arrays they need only. RA and Dec are J2000 radians, x, y, z is the equatorial unit vector.
+struct Catalog {
+	constexpr std::size_t size() const { return size_; }
+	constexpr const char* name(std::size_t i) const { return names_ + nameOffsets_[i]; }
+
+	std::array<float, 3> vector(std::size_t i) const { return {x_[i], y_[i], z_[i]}; }
+	RA ra(std::size_t i) const { return degToRA(ra_[i] * RAD_TO_DEG); }
+	Dec dec(std::size_t i) const { return degToDec(dec_[i] * RAD_TO_DEG); }
+
+	std::size_t size_;
+	// names are zero terminated, interned in one pool
+	const char* names_;
+	const uint16_t* nameOffsets_;
+	const float* ra_;
+	const float* dec_;
+	const float* x_;
+	const float* y_;
+	const float* z_;
+	// apparent visual magnitude
+	const float* magnitude_;
+	const ObjectType* type_;
 };
 
-template<typename CelestialObjectType>
-struct CelestialObject : public CelestialObjectBase {
-	constexpr CelestialObject(CelestialObjectType key, const char* name, RA ra, Dec dec)
-		: key_(key), CelestialObjectBase(name, std::move(ra), std::move(dec)) {}
-	CelestialObjectType key_;
+// Reference to a single object of a catalog
+struct CatalogObject {
+	const char* name() const { return catalog_->name(index_); }
+	double raRad() const { return catalog_->ra_[index_]; }
+	double decRad() const { return catalog_->dec_[index_]; }
+	std::array<float, 3> vector() const { return catalog_->vector(index_); }
+	RA ra() const { return catalog_->ra(index_); }
+	Dec dec() const { return catalog_->dec(index_); }
+	float magnitude() const { return catalog_->magnitude_[index_]; }
+	ObjectType type() const { return catalog_->type_[index_]; }
+
+	const Catalog* catalog_;
+	std::size_t index_;
 };
 
 // radians per second
 constexpr const double EARTH_ANG_SPEED = 7.292115 * pow(10,-5);
 
-std::pair<double, double> rotatePoint(std::pair<double, double> point, double angle, std::pair<double, double> pivot = {0, 0}) {
+// unix time of J2000.0 epoch (2000-01-01 12:00 UTC)
+constexpr const double J2000_UNIX_SECONDS = 946728000.0;
+
+// observer location in radians, longitude positive to the east
+struct Site {
+	double latitude;
+	double longitude;
+};
+
+// `unixSeconds` is UTC time; result is in range [0, 2*PI)
+inline double localSiderealTimeRad(double unixSeconds, double longitudeRad) {
+	auto daysSinceJ2000 = (unixSeconds - J2000_UNIX_SECONDS) / 86400.0;
+	auto gmstDeg = std::fmod(280.46061837 + 360.98564736629 * daysSinceJ2000, 360.0);
+	auto lst = std::fmod(gmstDeg * DEG_TO_RAD + longitudeRad, TWO_PI);
+	if (lst < 0) {
+		lst += TWO_PI;
+	}
+	return lst;
+}
+
+// Low precision (about 1 arcmin) Sun position, RA and Dec pair in radians
+inline std::pair<double, double> sunRADecRad(double unixSeconds) {
+	auto daysSinceJ2000 = (unixSeconds - J2000_UNIX_SECONDS) / 86400.0;
+	auto meanLongitude = std::fmod(280.460 + 0.9856474 * daysSinceJ2000, 360.0) * DEG_TO_RAD;
+	auto meanAnomaly = std::fmod(357.528 + 0.9856003 * daysSinceJ2000, 360.0) * DEG_TO_RAD;
+	auto eclipticLongitude = meanLongitude + (1.915 * sin(meanAnomaly) + 0.020 * sin(2 * meanAnomaly)) * DEG_TO_RAD;
+	auto obliquity = (23.439 - 0.0000004 * daysSinceJ2000) * DEG_TO_RAD;
+
+	auto ra = atan2(cos(obliquity) * sin(eclipticLongitude), cos(eclipticLongitude));
+	return {ra < 0 ? ra + TWO_PI : ra, asin(sin(obliquity) * sin(eclipticLongitude))};
+}
+
+// equatorial unit vector, x towards RA 0h, z towards north celestial pole
+inline std::array<float, 3> unitVectorFromRADec(double raRad, double decRad) {
+	return {
+		static_cast<float>(cos(decRad) * cos(raRad)),
+		static_cast<float>(cos(decRad) * sin(raRad)),
+		static_cast<float>(sin(decRad))
+	};
+}
+
+// Hour angle (radians) at which object crosses `altitudeRad`. Returns false when object is always above
+// (`hourAngle` = PI) or always below (`hourAngle` = 0) that altitude.
+inline bool hourAngleAtAltitude(double decRad, double latitudeRad, double altitudeRad, double& hourAngle) {
+	auto cosHourAngle = (sin(altitudeRad) - sin(latitudeRad) * sin(decRad)) / (cos(latitudeRad) * cos(decRad));
+	if (cosHourAngle <= -1) {
+		hourAngle = PI;
+		return false;
+	}
+	if (cosHourAngle >= 1) {
+		hourAngle = 0;
+		return false;
+	}
+	hourAngle = acos(cosHourAngle);
+	return true;
+}
+
+inline std::pair<double, double> rotatePoint(std::pair<double, double> point, double angle, std::pair<double, double> pivot = {0, 0}) {
 	// TODO can be optimized: do not compute twice sin, cos, and others
 	return {
 		(point.first - pivot.first)*cos(angle) - (point.second - pivot.second)*sin(angle) + pivot.first,
@@ -142,14 +374,14 @@ std::pair<double, double> rotatePoint(std::pair<double, double> point, double an
 	};
 }
 
-std::pair<double, double> translatePoint(std::pair<double, double> point, std::pair<double, double> delta) {
+inline std::pair<double, double> translatePoint(std::pair<double, double> point, std::pair<double, double> delta) {
 	return {
 		point.first + delta.first,
 		point.second + delta.second
 	};
 }
 
-std::pair<double,double> lineFrom2Points(std::pair<double, double> point1, std::pair<double, double> point2) {
+inline std::pair<double,double> lineFrom2Points(std::pair<double, double> point1, std::pair<double, double> point2) {
 	// TODO can be optimized: do not compute twice some expressions
 	return {
 		(point1.second - point2.second)/(point1.first - point2.first),
@@ -157,11 +389,11 @@ std::pair<double,double> lineFrom2Points(std::pair<double, double> point1, std::
 	};
 }
 
-double angleFrom2Lines(double a1, double a2) {
+inline double angleFrom2Lines(double a1, double a2) {
 	return atan((a2 - a1)/(1 + a1*a2));
 }
 
-std::pair<double, double> deltaXdeltaYFrom2Points(std::pair<double, double> point1, std::pair<double, double> point2, double angle = 0) {
+inline std::pair<double, double> deltaXdeltaYFrom2Points(std::pair<double, double> point1, std::pair<double, double> point2, double angle = 0) {
 	return {
 		point2.first - point1.first*cos(angle) + point1.second*sin(angle),
 		point2.second - point1.first*sin(angle) - point1.second*cos(angle)
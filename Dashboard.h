@@ -1,33 +1,37 @@
 #pragma once
 
+#include "Menu.h"
 #include "Mount.h"
 #include "ScreenItemIfc.h"
+#include "Sky.h"
 
 #include <U8g2lib.h>
 
-#include <functional>
-#include <utility>
+#include <array>
+#include <cmath>
 
 namespace ui {
 
 using scope::Mount;
+using scope::Sky;
 
 class Dashboard : public ScreenItem {
-	using Handler = std::function<void()>;
-	using Items = std::vector<std::pair<const char*, bool>>;
-
 	enum Item : uint8_t {
 		CTRL,
 		GOTO,
+		MAP,
+		TRACK_ERROR,
 		SETTINGS,
 		first = CTRL,
 		last = SETTINGS,
 	};
 public:
-	Dashboard(U8G2& u8g2, Mount& mount, Handler gotoHandler/*, Handler settingsHandler*/)
-		: u8g2_(u8g2), mount_(mount), gotoHandler_(std::move(gotoHandler))/*, settingsHandler_(std::move(settingsHandler))*/ {}
+	Dashboard(U8G2& u8g2, Mount& mount, Sky& sky, ActionDispatcher& dispatcher)
+		: u8g2_(u8g2), mount_(mount), sky_(sky), dispatcher_(dispatcher) {}
 
 	void draw() override {
+		update();
+
 		u8g2_.setFont(u8g2_font_profont11_tf);
 
 		u8g2_.setDrawColor(1);
@@ -35,44 +39,47 @@ public:
 
 		u8g2_.setFontMode(1);
 		u8g2_.setDrawColor(2);
-		if (mount_.trackingMode_ == Mount::MANUAL_CONTROL) {
+		if (trackingMode_ == Mount::MANUAL_CONTROL) {
 			u8g2_.drawStr(1, 10, "CTRL: MAN");
-		} else if (mount_.trackingMode_ == Mount::MOVE_TO) {
+		} else if (trackingMode_ == Mount::MOVE_TO) {
 			u8g2_.drawStr(1, 10, "CTRL: MOV");
 		} else {
 			u8g2_.drawStr(1, 10, "CTRL: AUT");
 		}
 		u8g2_.drawStr(1, 20, "GOTO");
-		u8g2_.drawStr(1, 30, "SETTINGS");
+		u8g2_.drawStr(1, 30, "MAP");
+		u8g2_.drawStr(1, 40, "ERROR");
+		u8g2_.drawStr(1, 50, "SETTINGS");
 
 		u8g2_.drawVLine(64, 0, 64);
 
-		if (mount_.operationMode_ == Mount::FULL_GOTO) {
+		if (operationMode_ == Mount::FULL_GOTO) {
 			u8g2_.drawStr(66, 10, "MODE: FULL");
-		} else if (mount_.operationMode_ == Mount::EASY_TRACK) {
+		} else if (operationMode_ == Mount::EASY_TRACK) {
 			u8g2_.drawStr(66, 10, "MODE: EASY");
-		} else if (mount_.operationMode_ == Mount::EASY_TRACK_GOTO) {
+		} else if (operationMode_ == Mount::EASY_TRACK_GOTO) {
 			u8g2_.drawStr(66, 10, "MODE: EASY GT");
 		} else {
 			u8g2_.drawStr(66, 10, "MODE: -");
 		}
 
-		char s[32];
-		auto currentPosition = mount_.currentPositionDeg();
-		snprintf(s, sizeof(s), "X:  %3.2f", currentPosition.first);
-		u8g2_.drawStr(66, 20, s);
-		snprintf(s, sizeof(s), "Y:  %3.2f", currentPosition.second);
-		u8g2_.drawStr(66, 30, s);
 		// if (mount_.operationMode_ == Mount::OperationMode::EASY_TRACK_GOTO || mount_.operationMode_ == Mount::OperationMode::FULL_GOTO) {
 		// 	snprintf(s, sizeof(s), "%s", mount_.currentPositionRA().str().c_str());
 		// 	u8g2_.drawStr(66, 40, s);
 		// 	snprintf(s, sizeof(s), "%s", mount_.currentPositionDec().str().c_str());
 		// 	u8g2_.drawStr(66, 50, s);
 		// }
-		snprintf(s, sizeof(s), "TX: %3.2f", mount_.targetPositionXDeg());
-		u8g2_.drawStr(66, 40, s);
-		snprintf(s, sizeof(s), "TY: %3.2f", mount_.targetPositionYDeg());
-		u8g2_.drawStr(66, 50, s);
+		for (std::size_t i = 0; i < POSITIONS; ++i) {
+			u8g2_.drawStr(66, 20 + i * 10, positionText_[i].data());
+		}
+
+		// nearest catalogued objects, last line of both columns
+		for (std::size_t i = 0; i < nearestCount_; ++i) {
+			u8g2_.drawStr(1 + i * 65, 60, nearestText_[i].data());
+		}
+	}
+	bool changed() override {
+		return update();
 	}
 	void down() override {
 		if (focusedItem_ < Item::last) {
@@ -90,7 +97,13 @@ public:
 				mount_.toggleAutoTrack();
 				break;
 			case Item::GOTO:
-				gotoHandler_();
+				dispatcher_.dispatch(Action::OPEN_MENU, arg(MenuId::GOTO_OBJECTS));
+				break;
+			case Item::MAP:
+				dispatcher_.dispatch(Action::OPEN_SKY_MAP, 0);
+				break;
+			case Item::TRACK_ERROR:
+				dispatcher_.dispatch(Action::OPEN_TRACKING_ERROR, 0);
 				break;
 			default:
 				break;
@@ -99,11 +112,69 @@ public:
 	void exit() override {}
 
 
+	static constexpr const std::size_t POSITIONS = 4;
+	static constexpr const char* POSITION_FORMATS[POSITIONS] = {"X:  %3.2f", "Y:  %3.2f", "TX: %3.2f", "TY: %3.2f"};
+	// positions are shown with 0.01 deg resolution
+	static constexpr const double POSITION_QUANTUM = 100;
+
+	// Reads mount state, formats only fields whose displayed value changed. Returns true when any did.
+	bool update() {
+		auto changed = false;
+		auto state = mount_.state();
+		if (trackingMode_ != state.trackingMode || operationMode_ != state.operationMode) {
+			trackingMode_ = state.trackingMode;
+			operationMode_ = state.operationMode;
+			changed = true;
+		}
+
+		auto currentPosition = state.positionDeg();
+		auto targetPosition = state.targetDeg();
+		std::array<double, POSITIONS> positions = {
+			currentPosition.first, currentPosition.second, targetPosition.first, targetPosition.second
+		};
+		for (std::size_t i = 0; i < POSITIONS; ++i) {
+			auto quantized = std::lround(positions[i] * POSITION_QUANTUM);
+			if (quantized == positionQuantized_[i] && positionFormatted_) {
+				continue;
+			}
+			positionQuantized_[i] = quantized;
+			snprintf(positionText_[i].data(), positionText_[i].size(), POSITION_FORMATS[i], positions[i]);
+			changed = true;
+		}
+		positionFormatted_ = true;
+
+		auto nearestCount = sky_.updateNearest();
+		for (std::size_t i = 0; i < nearestCount; ++i) {
+			auto index = sky_.nearest_[i].index;
+			if (i < nearestCount_ && nearestIndex_[i] == index) {
+				continue;
+			}
+			nearestIndex_[i] = index;
+			// left column fits 10 characters
+			snprintf(nearestText_[i].data(), nearestText_[i].size(), "%.10s", Sky::object(index).name());
+			changed = true;
+		}
+		if (nearestCount != nearestCount_) {
+			nearestCount_ = nearestCount;
+			changed = true;
+		}
+		return changed;
+	}
+
 	U8G2& u8g2_;
 	Mount& mount_;
-	Handler gotoHandler_;
-	Handler settingsHandler_;
+	Sky& sky_;
+	ActionDispatcher& dispatcher_;
 	uint8_t focusedItem_ = Item::CTRL;
+
+	Mount::TrackingMode trackingMode_ = Mount::MANUAL_CONTROL;
+	Mount::OperationMode operationMode_ = Mount::UNINITIALIZED;
+	bool positionFormatted_ = false;
+	std::array<long, POSITIONS> positionQuantized_;
+	std::array<std::array<char, 16>, POSITIONS> positionText_;
+	std::size_t nearestCount_ = 0;
+	std::array<uint16_t, Sky::NEAREST_COUNT> nearestIndex_;
+	std::array<std::array<char, 12>, Sky::NEAREST_COUNT> nearestText_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+namespace ui {
+
+// Double buffered display pipeline. UI renders into the back buffer (u8g2 `tile_buf_ptr` points to it),
+// submit() swaps it with the front buffer and wakes the display task on the other core, which sends it.
+// submit() never waits for SPI: when previous frame is still being sent the new one is dropped.
+//
+// Only changed tiles are sent. U8g2 full buffer is organised in tile rows (8 pixel rows, `width` bytes each,
+// one byte per column), tile is 8 consecutive bytes of a row. Every tile row is compared with the shadow copy
+// of the last sent frame and the span between the first and the last changed tile goes out with
+// u8x8_DrawTile(). Unchanged frame costs one memcmp per tile row.
+class DirtyTileDisplay {
+public:
+	static constexpr const std::size_t MAX_BUFFER_SIZE = 128 * 64 / 8;
+	static constexpr const std::size_t TILE_BYTES = 8;
+	static constexpr const uint32_t TASK_STACK_SIZE = 2048;
+	static constexpr const UBaseType_t TASK_PRIORITY = 1;
+	// Arduino loop() runs the stepping on core 1
+	static constexpr const BaseType_t TASK_CORE = 0;
+
+	struct Stats {
+		uint32_t frames = 0;
+		uint32_t unchangedFrames = 0;
+		// rendered, but display task was still sending previous frame
+		uint32_t droppedFrames = 0;
+		uint32_t tilesSent = 0;
+		// display data only, without controller addressing commands
+		uint32_t bytesSent = 0;
+		uint32_t bytesSaved = 0;
+		// clear and draw, blocking time of the UI side
+		uint32_t lastRenderUs = 0;
+		uint32_t maxRenderUs = 0;
+		// diff and SPI transfer in display task
+		uint32_t lastFlushUs = 0;
+		uint32_t maxFlushUs = 0;
+		// from beginFrame() until the frame is on the display
+		uint32_t lastLatencyUs = 0;
+		uint32_t maxLatencyUs = 0;
+	};
+
+	explicit DirtyTileDisplay(U8G2& u8g2) : u8g2_(u8g2) {}
+
+	// call after u8g2.begin()
+	bool begin() {
+		tileWidth_ = u8g2_.getBufferTileWidth();
+		tileHeight_ = u8g2_.getBufferTileHeight();
+		back_ = 0;
+		u8g2_.getU8g2()->tile_buf_ptr = buffers_[back_].data();
+		return xTaskCreatePinnedToCore(&DirtyTileDisplay::taskMain, "display", TASK_STACK_SIZE, this, TASK_PRIORITY, &task_, TASK_CORE) == pdPASS;
+	}
+
+	// next frame is sent whole, eg. after display reset
+	void invalidate() {
+		valid_.store(false, std::memory_order_relaxed);
+	}
+
+	void beginFrame() {
+		frameStart_ = micros();
+		u8g2_.clearBuffer();
+	}
+
+	// Hands rendered back buffer to the display task. Returns false and keeps the back buffer when the task
+	// is still busy with previous frame.
+	bool submit() {
+		uint32_t renderUs = micros() - frameStart_;
+		stats_.lastRenderUs = renderUs;
+		stats_.maxRenderUs = std::max(stats_.maxRenderUs, renderUs);
+		if (task_ == nullptr || sending_.load(std::memory_order_acquire)) {
+			++stats_.droppedFrames;
+			return false;
+		}
+		front_ = back_;
+		frontStart_ = frameStart_;
+		back_ ^= 1;
+		u8g2_.getU8g2()->tile_buf_ptr = buffers_[back_].data();
+		sending_.store(true, std::memory_order_release);
+		xTaskNotifyGive(task_);
+		return true;
+	}
+
+	const Stats& stats() const { return stats_; }
+
+	// Clears the UI side counters and wakes the display task to clear the ones it writes
+	void resetStats() {
+		stats_.droppedFrames = 0;
+		stats_.lastRenderUs = 0;
+		stats_.maxRenderUs = 0;
+		resetRequested_.store(true, std::memory_order_release);
+		if (task_ != nullptr) {
+			xTaskNotifyGive(task_);
+		}
+	}
+
+private:
+	static void taskMain(void* self) {
+		auto& display = *static_cast<DirtyTileDisplay*>(self);
+		for (;;) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			if (display.resetRequested_.exchange(false, std::memory_order_acquire)) {
+				display.resetTaskStats();
+			}
+			// woken by resetStats() only
+			if (!display.sending_.load(std::memory_order_acquire)) {
+				continue;
+			}
+			display.send();
+			display.sending_.store(false, std::memory_order_release);
+		}
+	}
+
+	void send() {
+		auto start = micros();
+		auto rowBytes = static_cast<std::size_t>(tileWidth_) * TILE_BYTES;
+		auto* buffer = buffers_[front_].data();
+		auto* u8x8 = u8g2_GetU8x8(u8g2_.getU8g2());
+		auto valid = valid_.load(std::memory_order_relaxed);
+
+		uint32_t tiles = 0;
+		for (uint8_t row = 0; row < tileHeight_; ++row) {
+			auto* current = buffer + row * rowBytes;
+			auto* shadow = shadow_.data() + row * rowBytes;
+			if (valid && std::memcmp(current, shadow, rowBytes) == 0) {
+				continue;
+			}
+			uint8_t first = 0;
+			uint8_t last = tileWidth_ - 1;
+			if (valid) {
+				while (std::memcmp(current + first * TILE_BYTES, shadow + first * TILE_BYTES, TILE_BYTES) == 0) {
+					++first;
+				}
+				while (std::memcmp(current + last * TILE_BYTES, shadow + last * TILE_BYTES, TILE_BYTES) == 0) {
+					--last;
+				}
+			}
+			u8x8_DrawTile(u8x8, first, row, last - first + 1, current + first * TILE_BYTES);
+			std::memcpy(shadow + first * TILE_BYTES, current + first * TILE_BYTES, (last - first + 1) * TILE_BYTES);
+			tiles += last - first + 1;
+		}
+		valid_.store(true, std::memory_order_relaxed);
+
+		auto bytes = tiles * TILE_BYTES;
+		++stats_.frames;
+		if (tiles == 0) {
+			++stats_.unchangedFrames;
+		}
+		stats_.tilesSent += tiles;
+		stats_.bytesSent += bytes;
+		stats_.bytesSaved += tileWidth_ * tileHeight_ * TILE_BYTES - bytes;
+		auto end = micros();
+		stats_.lastFlushUs = end - start;
+		stats_.maxFlushUs = std::max(stats_.maxFlushUs, stats_.lastFlushUs);
+		stats_.lastLatencyUs = end - frontStart_;
+		stats_.maxLatencyUs = std::max(stats_.maxLatencyUs, stats_.lastLatencyUs);
+	}
+
+	void resetTaskStats() {
+		stats_.frames = 0;
+		stats_.unchangedFrames = 0;
+		stats_.tilesSent = 0;
+		stats_.bytesSent = 0;
+		stats_.bytesSaved = 0;
+		stats_.lastFlushUs = 0;
+		stats_.maxFlushUs = 0;
+		stats_.lastLatencyUs = 0;
+		stats_.maxLatencyUs = 0;
+	}
+
+	U8G2& u8g2_;
+	uint8_t tileWidth_ = 0;
+	uint8_t tileHeight_ = 0;
+	std::array<std::array<uint8_t, MAX_BUFFER_SIZE>, 2> buffers_;
+	std::array<uint8_t, MAX_BUFFER_SIZE> shadow_;
+	// owned by UI side
+	std::size_t back_ = 0;
+	uint32_t frameStart_ = 0;
+	// written by UI side before notifying the task, read by the task
+	std::size_t front_ = 0;
+	uint32_t frontStart_ = 0;
+	std::atomic<bool> sending_{false};
+	std::atomic<bool> valid_{false};
+	std::atomic<bool> resetRequested_{false};
+	TaskHandle_t task_ = nullptr;
+	// render and dropped frame counters written by UI side, the rest by the display task
+	Stats stats_;
+};
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstdlib>
+
+namespace scope {
+
+// Guide pulses of one axis, durations signed by direction. A pulse posted while another one runs starts the
+// microsecond that one ends, so a burst from the guider is neither lost nor overlapped. Pulse time is integrated
+// in microseconds, independent of how often advance() is called. Not thread safe, motion task only.
+class GuidePulseQueue {
+public:
+	static constexpr const std::size_t SIZE = 8;
+
+	// `requestedUs` is when the pulse was asked for, an idle axis starts it then. Returns false when full.
+	bool push(int32_t durationUs, uint32_t requestedUs) {
+		if (durationUs == 0) {
+			return true;
+		}
+		if (count_ == SIZE) {
+			return false;
+		}
+		pulses_[(first_ + count_++) % SIZE] = durationUs;
+		if (!active_) {
+			// never before the end of a pulse that ended in the last advance(), an older end is not comparable
+			start(ended_ && static_cast<int32_t>(requestedUs - endUs_) < 0 ? endUs_ : requestedUs);
+		}
+		return true;
+	}
+
+	// Signed pulse time (us) between the previous call and `nowUs`
+	int32_t advance(uint32_t nowUs) {
+		int32_t elapsedUs = 0;
+		ended_ = false;
+		while (active_) {
+			auto untilUs = static_cast<int32_t>(nowUs - endUs_) >= 0 ? endUs_ : nowUs;
+			if (static_cast<int32_t>(untilUs - integratedUs_) > 0) {
+				elapsedUs += sign_ * static_cast<int32_t>(untilUs - integratedUs_);
+				integratedUs_ = untilUs;
+			}
+			if (untilUs != endUs_) {
+				break;
+			}
+			active_ = false;
+			ended_ = true;
+			start(endUs_);
+		}
+		return elapsedUs;
+	}
+
+	void clear() {
+		count_ = 0;
+		active_ = false;
+		ended_ = false;
+	}
+
+	bool active() const { return active_; }
+	std::size_t queued() const { return count_; }
+
+private:
+	void start(uint32_t startUs) {
+		if (count_ == 0) {
+			return;
+		}
+		auto durationUs = pulses_[first_];
+		first_ = (first_ + 1) % SIZE;
+		--count_;
+		sign_ = durationUs < 0 ? -1 : 1;
+		endUs_ = startUs + static_cast<uint32_t>(std::abs(durationUs));
+		integratedUs_ = startUs;
+		active_ = true;
+	}
+
+	std::array<int32_t, SIZE> pulses_;
+	std::size_t first_ = 0;
+	std::size_t count_ = 0;
+	bool active_ = false;
+	// the pulse ending at endUs_ ended in the last advance()
+	bool ended_ = false;
+	int32_t sign_ = 1;
+	uint32_t endUs_ = 0;
+	// pulse time up to here was returned by advance()
+	uint32_t integratedUs_ = 0;
+};
+
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Print.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace heap {
+
+// Every region: id, name. Code runs in OTHER unless a Region scope names it; the sketch marks the motion task's
+// loop, the UI task's steps and its timers.
+#define HEAP_REGIONS(X) \
+	X(OTHER, "other") \
+	X(MOTION, "motion") \
+	X(INPUT_EVENTS, "input") \
+	X(SCRIPTS, "scripts") \
+	X(COMMAND, "command") \
+	X(SCREEN, "screen") \
+	X(TIMER, "timer")
+
+enum class RegionId : uint8_t {
+#define HEAP_REGION_ID(id, name) id,
+	HEAP_REGIONS(HEAP_REGION_ID)
+#undef HEAP_REGION_ID
+	count,
+};
+
+constexpr const char* REGION_NAMES[] = {
+#define HEAP_REGION_NAME(id, name) name,
+	HEAP_REGIONS(HEAP_REGION_NAME)
+#undef HEAP_REGION_NAME
+};
+
+// Counts heap allocations per region of the allocating task. The allocator hooks call allocated() and freed():
+// operator new and delete on the board (AllocationHooks.cpp, malloc of the core can not be replaced), malloc and
+// free in the simulator (sim/Heap.cpp), which also catches exceptions and C code. Counting is off until enabled,
+// a hook then costs a thread local read and two relaxed atomic adds.
+class Tracker {
+public:
+	struct Counts {
+		uint32_t allocations = 0;
+		uint32_t bytes = 0;
+		uint32_t frees = 0;
+	};
+
+	constexpr Tracker() = default;
+
+	void enable(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+	bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+	void allocated(std::size_t size) {
+		if (!enabled()) {
+			return;
+		}
+		auto& counters = counters_[static_cast<std::size_t>(current_)];
+		counters.allocations.fetch_add(1, std::memory_order_relaxed);
+		counters.bytes.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+	}
+
+	void freed() {
+		if (!enabled()) {
+			return;
+		}
+		counters_[static_cast<std::size_t>(current_)].frees.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Counts counts(RegionId region) const {
+		const auto& counters = counters_[static_cast<std::size_t>(region)];
+		return {counters.allocations.load(std::memory_order_relaxed), counters.bytes.load(std::memory_order_relaxed),
+			counters.frees.load(std::memory_order_relaxed)};
+	}
+
+	void reset() {
+		for (auto& counters : counters_) {
+			counters.allocations.store(0, std::memory_order_relaxed);
+			counters.bytes.store(0, std::memory_order_relaxed);
+			counters.frees.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	void print(Print& out) const {
+		out.printf("allocs: %s\n", enabled() ? "on" : "off");
+		out.printf("%-8s %10s %10s %10s\n", "region", "allocs", "bytes", "frees");
+		for (std::size_t i = 0; i < counters_.size(); ++i) {
+			auto region = counts(static_cast<RegionId>(i));
+			out.printf("%-8s %10lu %10lu %10lu\n", REGION_NAMES[i], static_cast<unsigned long>(region.allocations),
+				static_cast<unsigned long>(region.bytes), static_cast<unsigned long>(region.frees));
+		}
+	}
+
+	// region of the calling task, see Region
+	static thread_local RegionId current_;
+
+private:
+	struct Counters {
+		std::atomic<uint32_t> allocations{0};
+		std::atomic<uint32_t> bytes{0};
+		std::atomic<uint32_t> frees{0};
+	};
+
+	std::atomic<bool> enabled_{false};
+	std::array<Counters, static_cast<std::size_t>(RegionId::count)> counters_;
+};
+
+inline thread_local RegionId Tracker::current_ = RegionId::OTHER;
+
+// constant initialized, the allocator hooks run before any constructor and must not allocate the tracker
+inline Tracker& tracker() {
+	static Tracker instance;
+	return instance;
+}
+
+// Allocations until the end of the scope count for `region`, nested scopes restore the outer one. The simulator
+// runs all tasks on one thread, a scope must not span a blocking call there.
+class Region {
+public:
+	explicit Region(RegionId region) : previous_(Tracker::current_) { Tracker::current_ = region; }
+	~Region() { Tracker::current_ = previous_; }
+
+	Region(const Region&) = delete;
+	Region& operator=(const Region&) = delete;
+
+private:
+	RegionId previous_;
+};
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "ButtonProcessor.h"
+#include "Mount.h"
+#include "MpscQueue.h"
+#include "ScreenUI.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace ui {
+
+enum class Button : uint8_t {
+	UP,
+	DOWN,
+	CROSS,
+	CIRCLE,
+	// toggles fine jog
+	L1,
+	count,
+};
+
+struct InputEvent {
+	enum class Kind : uint8_t {
+		BUTTON_DOWN,
+		BUTTON_UP,
+		STICKS,
+		DISCONNECTED,
+	};
+
+	Kind kind;
+	Button button;
+	// jog sticks, PS4 range -128 : 127
+	int8_t x;
+	int8_t y;
+	uint32_t timestampUs;
+};
+
+// Stick position to jog speed fraction: dead zone, then expo curve (0 linear .. 1 cubic), scaled down in fine mode
+struct RateCurve {
+	uint8_t deadZone = 10;
+	float expo = 0.6f;
+	float fineScale = 0.1f;
+
+	float apply(int8_t stick, bool fine) const {
+		auto magnitude = std::abs(static_cast<int>(stick));
+		if (magnitude < deadZone) {
+			return 0;
+		}
+		auto x = std::min(1.0f, static_cast<float>(magnitude - deadZone) / (128 - deadZone));
+		auto y = (1 - expo) * x + expo * x * x * x;
+		if (fine) {
+			y *= fineScale;
+		}
+		return stick < 0 ? -y : y;
+	}
+};
+
+// Controller callbacks post timestamped events from the Bluetooth task, the UI task handles them right away
+// instead of polling the controller state. Menu buttons auto repeat, sticks jog the mount through the rate curve.
+class InputPipeline {
+public:
+	static constexpr const std::size_t QUEUE_SIZE = 32;
+
+	struct Stats {
+		uint32_t events = 0;
+		// queue was full
+		uint32_t dropped = 0;
+		// from controller callback until handled
+		uint32_t lastLatencyUs = 0;
+		uint32_t maxLatencyUs = 0;
+	};
+
+	InputPipeline(ScreenUI& screen, scope::Mount& mount) : screen_(screen), mount_(mount) {}
+
+	// any task, usually the controller callback
+	bool post(InputEvent event) {
+		event.timestampUs = micros();
+		if (!events_.push(event)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	// UI task, every iteration
+	void process(uint32_t nowMs) {
+		InputEvent event;
+		while (events_.pop(event)) {
+			uint32_t latency = micros() - event.timestampUs;
+			++stats_.events;
+			stats_.lastLatencyUs = latency;
+			stats_.maxLatencyUs = std::max(stats_.maxLatencyUs, latency);
+			handle(event, nowMs);
+		}
+		for (std::size_t i = 0; i < buttons_.size(); ++i) {
+			if (buttons_[i].repeat(nowMs)) {
+				press(static_cast<Button>(i));
+			}
+		}
+		if (jogPending_) {
+			jog();
+		}
+	}
+
+	// UI task
+	const RateCurve& curve() const { return curve_; }
+	void setCurve(const RateCurve& curve) {
+		curve_ = curve;
+		jog();
+	}
+	bool fine() const { return fine_; }
+
+	Stats stats() const {
+		auto stats = stats_;
+		stats.dropped = dropped_.load(std::memory_order_relaxed);
+		return stats;
+	}
+	void resetStats() {
+		stats_ = {};
+		dropped_.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	void handle(const InputEvent& event, uint32_t nowMs) {
+		switch (event.kind) {
+			case InputEvent::Kind::BUTTON_DOWN:
+				if (event.button == Button::L1) {
+					fine_ = !fine_;
+					jog();
+				} else {
+					press(event.button);
+					buttons_[static_cast<std::size_t>(event.button)].press(nowMs);
+				}
+				break;
+			case InputEvent::Kind::BUTTON_UP:
+				if (event.button != Button::L1) {
+					buttons_[static_cast<std::size_t>(event.button)].release();
+				}
+				break;
+			case InputEvent::Kind::STICKS:
+				sticks_ = {event.x, event.y};
+				jog();
+				break;
+			case InputEvent::Kind::DISCONNECTED:
+				for (auto& button : buttons_) {
+					button.release();
+				}
+				sticks_ = {0, 0};
+				jog();
+				break;
+		}
+	}
+
+	void press(Button button) {
+		switch (button) {
+			case Button::UP: screen_.up(); break;
+			case Button::DOWN: screen_.down(); break;
+			case Button::CROSS: screen_.enter(); break;
+			case Button::CIRCLE: screen_.exit(); break;
+			default: break;
+		}
+	}
+
+	// retried next iteration when the motion queue is full
+	void jog() {
+		jogPending_ = !mount_.jog({curve_.apply(sticks_.first, fine_), curve_.apply(sticks_.second, fine_)});
+	}
+
+	ScreenUI& screen_;
+	scope::Mount& mount_;
+	scope::MpscQueue<InputEvent, QUEUE_SIZE> events_;
+	std::atomic<uint32_t> dropped_{0};
+
+	// UI task only
+	std::array<ButtonProcessor, static_cast<std::size_t>(Button::L1)> buttons_;
+	std::pair<int8_t, int8_t> sticks_ = {0, 0};
+	RateCurve curve_;
+	bool fine_ = false;
+	bool jogPending_ = false;
+	Stats stats_;
+};
+
+}
@@ -1,17 +1,15 @@
 #pragma once
 
 
+#include "Menu.h"
 #include "ScreenItemIfc.h"
 
-#include <functional>
-#include <string>
-#include <vector>
-#include <utility>
 #include <U8g2lib.h>
 
 
 namespace ui {
 
+// List with title, optional text and items. Subclasses provide items, the list handles focus, scrolling and drawing.
 class ItemsList : public ScreenItem {
 	static constexpr const std::size_t MAX_ELEMENTS = 5;
 	static constexpr const uint8_t LINE_HEIGHT = 10;
@@ -19,35 +17,33 @@ class ItemsList : public ScreenItem {
 	static constexpr const uint8_t BORDER_WIDTH = 1;
 
 public:
-	using Text = std::vector<std::string>;
-	using Handler = std::function<void()>;
-	using Items = std::vector<std::pair<const char*, Handler>>;
+	using Text = std::array<const char*, Menu::MAX_TEXT_LINES>;
 
-	ItemsList(U8G2& u8g2, const char* title, Text text, Items items, Handler exitHandler)
-		: u8g2_(u8g2), title_(title), text_(std::move(text)), items_(std::move(items)), exitHandler_(std::move(exitHandler)) {}
-
-	ItemsList(U8G2& u8g2, const char* title, Text text, Items items)
-		: u8g2_(u8g2), title_(title), text_(std::move(text)), items_(std::move(items)) {}
+	explicit ItemsList(U8G2& u8g2) : u8g2_(u8g2) {}
 
 	void draw() override;
 	void down() override;
 	void up() override;
 
-	void enter() override {
-		items_[focused_].second();
-	}
+	virtual std::size_t count() const = 0;
+	virtual const char* label(std::size_t i) const = 0;
 
-	void exit() override {
-		if (exitHandler_) {
-			exitHandler_();
+	// shows the list from its first item; text ends at the first nullptr line
+	void reset(const char* title, const Text& text) {
+		title_ = title;
+		text_ = text;
+		textLines_ = 0;
+		while (textLines_ < text_.size() && text_[textLines_] != nullptr) {
+			++textLines_;
 		}
+		viewOffset_ = 0;
+		focused_ = 0;
 	}
 
 	U8G2& u8g2_;
-	const char* title_;
-	Text text_;
-	Items items_;
-	Handler exitHandler_;
+	const char* title_ = "";
+	Text text_ = {};
+	std::size_t textLines_ = 0;
 	std::size_t viewOffset_ = 0;
 	std::size_t focused_ = 0;
 
@@ -57,4 +53,104 @@ public:
 	uint8_t borderWidth_ = BORDER_WIDTH;
 };
 
+// Shows one of MENUS at a time
+class MenuList : public ItemsList {
+public:
+	MenuList(U8G2& u8g2, ActionDispatcher& dispatcher) : ItemsList(u8g2), dispatcher_(dispatcher) {}
+
+	void open(MenuId id) {
+		menu_ = &MENUS[static_cast<std::size_t>(id)];
+		id_ = id;
+		reset(menu_->title, menu_->text);
+	}
+
+	MenuId id() const { return id_; }
+
+	std::size_t count() const override { return menu_->itemCount; }
+
+	const char* label(std::size_t i) const override {
+		const auto& item = menu_->items[i];
+		return item.label != nullptr ? item.label : dispatcher_.label(item.action);
+	}
+
+	void enter() override {
+		const auto& item = menu_->items[focused_];
+		dispatcher_.dispatch(item.action, item.arg);
+	}
+
+	void exit() override {
+		dispatcher_.dispatch(menu_->exit.action, menu_->exit.arg);
+	}
+
+private:
+	ActionDispatcher& dispatcher_;
+	const Menu* menu_ = &MENUS[0];
+	MenuId id_ = MenuId::MOUNT_TYPE;
+};
+
+// Catalog objects identified by index, labelled with object name or a formatted label for the first rows
+template<std::size_t N, std::size_t LABELS, typename ObjectAt>
+class CatalogList : public ItemsList {
+public:
+	static constexpr const std::size_t LABEL_SIZE = 24;
+
+	CatalogList(U8G2& u8g2, ActionDispatcher& dispatcher, ObjectAt objectAt)
+		: ItemsList(u8g2), dispatcher_(dispatcher), objectAt_(objectAt) {}
+
+	// `action` is dispatched with object index, `emptyLabel` is shown when nothing is added
+	void open(const char* title, const Text& text, Action action, MenuItem exit, const char* emptyLabel) {
+		reset(title, text);
+		action_ = action;
+		exit_ = exit;
+		emptyLabel_ = emptyLabel;
+		rowCount_ = 0;
+		labelledCount_ = 0;
+	}
+
+	void add(uint16_t index) {
+		if (rowCount_ < N) {
+			rows_[rowCount_++] = index;
+		}
+	}
+
+	// Buffer for the row label, only before any add() without label. Returns nullptr when out of label buffers.
+	char* addLabelled(uint16_t index) {
+		if (labelledCount_ >= LABELS || labelledCount_ != rowCount_ || rowCount_ >= N) {
+			return nullptr;
+		}
+		rows_[rowCount_++] = index;
+		return labels_[labelledCount_++].data();
+	}
+
+	std::size_t count() const override { return rowCount_ > 0 ? rowCount_ : 1; }
+
+	const char* label(std::size_t i) const override {
+		if (rowCount_ == 0) {
+			return emptyLabel_;
+		}
+		return i < labelledCount_ ? labels_[i].data() : objectAt_(rows_[i]).name();
+	}
+
+	void enter() override {
+		if (rowCount_ > 0) {
+			dispatcher_.dispatch(action_, rows_[focused_]);
+		}
+	}
+
+	void exit() override {
+		dispatcher_.dispatch(exit_.action, exit_.arg);
+	}
+
+private:
+	ActionDispatcher& dispatcher_;
+	ObjectAt objectAt_;
+	Action action_ = Action::NONE;
+	MenuItem exit_ = {nullptr, Action::NONE};
+	const char* emptyLabel_ = "";
+	std::array<uint16_t, N> rows_;
+	std::size_t rowCount_ = 0;
+	std::array<std::array<char, LABEL_SIZE>, LABELS> labels_;
+	std::size_t labelledCount_ = 0;
+};
+
 }
\ No newline at end of file
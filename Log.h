@@ -0,0 +1,288 @@
+#pragma once
+
+#include "MpscQueue.h"
+
+#include <Arduino.h>
+#include <Stream.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace logging {
+
+enum class Level : uint8_t {
+	OFF,
+	ERROR,
+	WARN,
+	INFO,
+	DEBUG,
+	last = DEBUG,
+};
+
+enum class Category : uint8_t {
+	MOUNT,
+	TRACKING,
+	ALIGNMENT,
+	SCRIPT,
+	last = SCRIPT,
+};
+
+// Every log message: id, category, level, printf format. Formats may use only conversions without length
+// modifier, integer ones (d i u x X c) get int32_t, floating ones (f e g) get double. log_decode.py reads
+// this table, keep one entry per line and append new ones at the end so recorded ids stay valid.
+#define LOG_MESSAGES(X) \
+	X(STOP_MOUNT_MOVE, MOUNT, DEBUG, "stopMountMove() stopping mount") \
+	X(MOVE_TO_STEPS, MOUNT, DEBUG, "safeMoveTo() moveto(steps): %d, %d") \
+	X(MOVE_TO_LIMITED_STEPS, MOUNT, DEBUG, "safeMoveTo() moveto(limits,steps): %d, %d") \
+	X(MOVE_TO_RAD, MOUNT, DEBUG, "safeMoveToPositionRad(): position(rad) %f, %f") \
+	X(MOVE_TO_DEG, MOUNT, DEBUG, "safeMoveToPositionDeg(): position(deg) %f, %f") \
+	X(MOVE_TO_RADEC, MOUNT, DEBUG, "safeMoveToPositionRADec(): position(rad) %f, %f") \
+	X(MOVE_TO_RADEC_ANGLE, MOUNT, DEBUG, "safeMoveToPositionRADec(): angle delta(rad) %f") \
+	X(MOVE_TO_RADEC_NO_PIVOT, MOUNT, ERROR, "safeMoveToPositionRADec(). skyPivot not set.") \
+	X(EARTH_ANGLE_NO_TIME, MOUNT, ERROR, "safeMoveToPositionRADec(). gettimeofday() failed.") \
+	X(AUTO_TRACK_ANGLE, TRACKING, DEBUG, "computeAutoTrackCoords() angle delta(rad): %f") \
+	X(AUTO_TRACK_START, TRACKING, DEBUG, "computeAutoTrackCoords() start coords(rad): %f, %f") \
+	X(AUTO_TRACK_PIVOT, TRACKING, DEBUG, "computeAutoTrackCoords() pivot coords(rad): %f, %f") \
+	X(AUTO_TRACK_TARGET, TRACKING, DEBUG, "computeAutoTrackCoords() target coords(rad): %f, %f") \
+	X(SECOND_STAR_FIRST_MOUNT, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): first star mount(rad) %f, %f") \
+	X(SECOND_STAR_FIRST_STAR, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): first star(rad) %f, %f") \
+	X(SECOND_STAR_SECOND_MOUNT, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): second star mount(rad) %f, %f") \
+	X(SECOND_STAR_SECOND_STAR, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): second star(rad) %f, %f") \
+	X(SECOND_STAR_NO_TIME, ALIGNMENT, ERROR, "setTwoStarAlignmentSecondStar(). gettimeofday() failed.") \
+	X(ALIGNMENT_DELTA, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): alignment delta(rad) %f, %f") \
+	X(ALIGNMENT_ANGLE, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): alignment angle(rad) %f") \
+	X(ALIGNMENT_SKY_PIVOT, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): sky pivot(rad) %f, %f") \
+	X(ALIGNMENT_AUTOTRACK_PIVOT, ALIGNMENT, DEBUG, "setTwoStarAlignmentSecondStar(): autotrack pivot(steps) %f, %f") \
+	X(SYNC_DELTA, ALIGNMENT, DEBUG, "sync(): alignment delta(rad) %f, %f") \
+	X(SCRIPT_FIRED, SCRIPT, INFO, "script %d fired") \
+	X(GUIDE_PULSE, TRACKING, DEBUG, "guide(): direction %d pulse(us) %d") \
+	X(SET_TIME_FAILED, MOUNT, ERROR, "setTime(). gettimeofday() or settimeofday() failed.")
+
+enum class Message : uint16_t {
+#define LOG_MESSAGE_ID(id, category, level, format) id,
+	LOG_MESSAGES(LOG_MESSAGE_ID)
+#undef LOG_MESSAGE_ID
+};
+
+struct MessageInfo {
+	Category category;
+	Level level;
+	const char* format;
+};
+
+constexpr const MessageInfo MESSAGES[] = {
+#define LOG_MESSAGE_INFO(id, category, level, format) {Category::category, Level::level, format},
+	LOG_MESSAGES(LOG_MESSAGE_INFO)
+#undef LOG_MESSAGE_INFO
+};
+
+constexpr const char* LEVEL_NAMES[] = {"off", "error", "warn", "info", "debug"};
+constexpr const char* CATEGORY_NAMES[] = {"mount", "tracking", "alignment", "script"};
+
+// Producers only copy message id and raw arguments into a lock-free ring, formatting and the blocking serial
+// output happen in a low priority task on core 0. When the ring is full the record is dropped and counted,
+// the producer never waits.
+//
+// Binary output frame, little endian: FRAME_START, id (u16), argument count (u8), timestamp (u32, micros()),
+// arguments (8 bytes each, int32_t in the first 4 or double), checksum (u8, sum of the bytes after FRAME_START).
+class Logger {
+public:
+	static constexpr const std::size_t QUEUE_SIZE = 64;
+	static constexpr const std::size_t MAX_ARGS = 4;
+	static constexpr const uint8_t FRAME_START = 0xA5;
+	static constexpr const uint32_t DRAIN_INTERVAL_MS = 20;
+	static constexpr const uint32_t TASK_STACK_SIZE = 3072;
+	// below UI and display
+	static constexpr const UBaseType_t TASK_PRIORITY = 0;
+	static constexpr const BaseType_t TASK_CORE = 0;
+
+	enum class Output : uint8_t {
+		TEXT,
+		BINARY,
+	};
+
+	union Arg {
+		int32_t i;
+		double d;
+	};
+
+	struct Record {
+		uint32_t timestampUs;
+		Message id;
+		uint8_t argCount;
+		std::array<Arg, MAX_ARGS> args;
+	};
+
+	bool begin(Stream& stream) {
+		stream_ = &stream;
+		return xTaskCreatePinnedToCore(&Logger::taskMain, "log", TASK_STACK_SIZE, this, TASK_PRIORITY, nullptr, TASK_CORE) == pdPASS;
+	}
+
+	bool enabled(Message id) const {
+		const auto& info = MESSAGES[static_cast<std::size_t>(id)];
+		return info.level <= level_.load(std::memory_order_relaxed)
+			&& (categories_.load(std::memory_order_relaxed) & categoryBit(info.category)) != 0;
+	}
+
+	// any task, use LOG() so disabled messages do not evaluate arguments
+	template<typename... Args>
+	void write(Message id, Args... args) {
+		static_assert(sizeof...(Args) <= MAX_ARGS, "Too many log arguments");
+		Record record;
+		record.timestampUs = micros();
+		record.id = id;
+		record.argCount = sizeof...(Args);
+		std::size_t i = 0;
+		(void)std::initializer_list<int>{(record.args[i++] = toArg(args), 0)...};
+		if (!queue_.push(record)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	Level level() const { return level_.load(std::memory_order_relaxed); }
+	void setLevel(Level level) { level_.store(level, std::memory_order_relaxed); }
+
+	bool categoryEnabled(Category category) const {
+		return (categories_.load(std::memory_order_relaxed) & categoryBit(category)) != 0;
+	}
+	void setCategoryEnabled(Category category, bool enabled) {
+		if (enabled) {
+			categories_.fetch_or(categoryBit(category), std::memory_order_relaxed);
+		} else {
+			categories_.fetch_and(~categoryBit(category), std::memory_order_relaxed);
+		}
+	}
+
+	Output output() const { return output_.load(std::memory_order_relaxed); }
+	void setOutput(Output output) { output_.store(output, std::memory_order_relaxed); }
+
+	uint32_t written() const { return written_.load(std::memory_order_relaxed); }
+	uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+	// Formats `record` without the line end. Returns false when `size` was too small, text is truncated.
+	static bool format(const Record& record, char* buffer, std::size_t size) {
+		const auto* next = MESSAGES[static_cast<std::size_t>(record.id)].format;
+		std::size_t length = 0;
+		std::size_t arg = 0;
+		char spec[16];
+		while (*next != '\0' && length + 1 < size) {
+			if (*next != '%') {
+				buffer[length++] = *next++;
+				continue;
+			}
+			if (next[1] == '%') {
+				buffer[length++] = '%';
+				next += 2;
+				continue;
+			}
+			std::size_t specLength = 0;
+			do {
+				spec[specLength++] = *next++;
+			} while (*next != '\0' && std::strchr("diouxXcfeEgGaA", *next) == nullptr && specLength + 2 < sizeof(spec));
+			auto conversion = *next;
+			if (conversion == '\0') {
+				break;
+			}
+			spec[specLength++] = *next++;
+			spec[specLength] = '\0';
+			auto value = arg < record.argCount ? record.args[arg] : Arg{0};
+			++arg;
+			int count = std::strchr("fFeEgGaA", conversion) != nullptr
+				? snprintf(buffer + length, size - length, spec, value.d)
+				: snprintf(buffer + length, size - length, spec, value.i);
+			if (count < 0) {
+				break;
+			}
+			length = std::min(size - 1, length + static_cast<std::size_t>(count));
+		}
+		buffer[length] = '\0';
+		return *next == '\0';
+	}
+
+private:
+	static constexpr uint32_t categoryBit(Category category) {
+		return 1u << static_cast<uint8_t>(category);
+	}
+
+	template<typename T>
+	static Arg toArg(T value) {
+		Arg arg;
+		if (std::is_floating_point<T>::value) {
+			arg.d = value;
+		} else {
+			arg.i = static_cast<int32_t>(value);
+		}
+		return arg;
+	}
+
+	static void taskMain(void* self) {
+		auto& logger = *static_cast<Logger*>(self);
+		for (;;) {
+			logger.drain();
+			vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+		}
+	}
+
+	void drain() {
+		Record record;
+		while (queue_.pop(record)) {
+			if (output() == Output::BINARY) {
+				writeBinary(record);
+			} else {
+				char line[128];
+				format(record, line, sizeof(line));
+				stream_->print(line);
+				stream_->print("\n");
+			}
+			written_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void writeBinary(const Record& record) {
+		uint8_t frame[1 + 2 + 1 + 4 + MAX_ARGS * sizeof(Arg) + 1];
+		std::size_t length = 0;
+		frame[length++] = FRAME_START;
+		auto id = static_cast<uint16_t>(record.id);
+		frame[length++] = id & 0xFF;
+		frame[length++] = id >> 8;
+		frame[length++] = record.argCount;
+		for (std::size_t i = 0; i < 4; ++i) {
+			frame[length++] = (record.timestampUs >> (8 * i)) & 0xFF;
+		}
+		// ESP32 is little endian, arguments go as they are in memory
+		std::memcpy(frame + length, record.args.data(), record.argCount * sizeof(Arg));
+		length += record.argCount * sizeof(Arg);
+		uint8_t checksum = 0;
+		for (std::size_t i = 1; i < length; ++i) {
+			checksum += frame[i];
+		}
+		frame[length++] = checksum;
+		stream_->write(frame, length);
+	}
+
+	scope::MpscQueue<Record, QUEUE_SIZE> queue_;
+	Stream* stream_ = nullptr;
+	std::atomic<Level> level_{Level::INFO};
+	std::atomic<uint32_t> categories_{~0u};
+	std::atomic<Output> output_{Output::TEXT};
+	std::atomic<uint32_t> written_{0};
+	std::atomic<uint32_t> dropped_{0};
+};
+
+inline Logger& logger() {
+	static Logger instance;
+	return instance;
+}
+
+}
+
+#define LOG(id, ...) do { \
+		auto& logger_ = ::logging::logger(); \
+		if (logger_.enabled(::logging::Message::id)) { \
+			logger_.write(::logging::Message::id, ##__VA_ARGS__); \
+		} \
+	} while (false)
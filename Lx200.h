@@ -0,0 +1,323 @@
+#pragma once
+
+#include "CoordsUtils.h"
+#include "Mount.h"
+
+#include <Arduino.h>
+#include <Stream.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace scope {
+
+// Meade LX200 command subset used by planetarium software: position (:GR# :GD#), target (:Sr :Sd), goto (:MS#),
+// sync (:CM#), stop (:Q# :Qn# ...), jog (:Mn# :Ms# :Me# :Mw#) with slew rates (:RG# :RC# :RM# :RS#), guide pulses
+// (:MgnDDDD# ... in ms), precision toggle (:U#) and the ACK alignment query. Bytes are fed one at a time, a command
+// is kept in a fixed buffer and executed on '#', nothing blocks and nothing is allocated. Unknown commands are
+// ignored as on the real mount.
+class Lx200Server {
+public:
+	static constexpr const std::size_t MAX_COMMAND_LENGTH = 32;
+	static constexpr const uint8_t ACK = 0x06;
+	// manual control speeds (PS4 stick scale) of guide, center, find and slew rate
+	static constexpr const std::array<int8_t, 4> JOG_SPEEDS = {4, 16, 64, 127};
+
+	Lx200Server(Mount& mount, Print& output) : mount_(mount), output_(output) {}
+
+	// Returns true when `byte` belongs to LX200. Command start ':' is recognized only at `lineStart` of the text
+	// commands, so it can not be confused with a character inside them.
+	bool accept(uint8_t byte, bool lineStart) {
+		if (inCommand_) {
+			if (byte == '#') {
+				command_[length_] = '\0';
+				inCommand_ = false;
+				execute();
+			} else if (length_ < MAX_COMMAND_LENGTH) {
+				command_[length_++] = byte;
+			} else {
+				// overlong, drop it
+				inCommand_ = false;
+			}
+			return true;
+		}
+		if (byte == ACK) {
+			output_.print(mount_.state().mountType == Mount::MountType::EQ ? "P" : "A");
+			return true;
+		}
+		if (byte == ':' && lineStart) {
+			inCommand_ = true;
+			length_ = 0;
+			return true;
+		}
+		return false;
+	}
+
+	uint32_t commands() const { return commands_; }
+	uint32_t unknownCommands() const { return unknownCommands_; }
+
+private:
+	enum class Rate : uint8_t {
+		GUIDE,
+		CENTER,
+		FIND,
+		SLEW,
+	};
+
+	bool is(const char* name) const {
+		return std::strncmp(command_, name, std::strlen(name)) == 0;
+	}
+
+	void execute() {
+		++commands_;
+		if (is("GR") || is("GD")) {
+			// pairs of :GR# :GD# are answered from one snapshot
+			auto state = mount_.state();
+			if (!positionValid_ || state.timestampUs != positionTimestampUs_) {
+				positionTimestampUs_ = state.timestampUs;
+				positionValid_ = state.positionRADec(position_);
+				if (!positionValid_) {
+					position_ = {0, 0};
+				}
+			}
+			if (command_[1] == 'R') {
+				printRA(position_.first);
+			} else {
+				printDec(position_.second);
+			}
+		} else if (is("U")) {
+			highPrecision_ = !highPrecision_;
+		} else if (is("Sr")) {
+			auto ra = coords::parseRA(command_ + 2);
+			if (ra) {
+				target_.first = ra.value.rad();
+				targetRASet_ = true;
+			}
+			output_.print(ra ? "1" : "0");
+		} else if (is("Sd")) {
+			auto dec = coords::parseDec(command_ + 2);
+			if (dec) {
+				target_.second = dec.value.rad();
+				targetDecSet_ = true;
+			}
+			output_.print(dec ? "1" : "0");
+		} else if (is("MS")) {
+			auto mode = mount_.state().operationMode;
+			if (mode != Mount::OperationMode::EASY_TRACK_GOTO && mode != Mount::OperationMode::FULL_GOTO) {
+				output_.print("2Not aligned#");
+			} else if (!targetRASet_ || !targetDecSet_) {
+				output_.print("2No target#");
+			} else if (!mount_.moveToRADec(target_)) {
+				output_.print("2Busy#");
+			} else {
+				output_.print("0");
+			}
+		} else if (is("CM")) {
+			if (mount_.state().mountType == Mount::MountType::EQ && targetRASet_ && targetDecSet_ && mount_.sync(target_)) {
+				output_.print("Coordinates matched#");
+			} else {
+				output_.print("Sync failed#");
+			}
+		} else if (is("Q")) {
+			switch (command_[1]) {
+				case 'n':
+				case 's':
+					jogY_ = 0;
+					break;
+				case 'e':
+				case 'w':
+					jogX_ = 0;
+					break;
+				default:
+					jogX_ = 0;
+					jogY_ = 0;
+					mount_.stop();
+					break;
+			}
+			mount_.manualControlSetSpeed({jogX_, jogY_});
+		} else if (is("Mg")) {
+			char* end = nullptr;
+			auto durationMs = std::strtoul(command_ + 3, &end, 10);
+			if (end == command_ + 3 || *end != '\0' || durationMs > Mount::MAX_GUIDE_PULSE_MS) {
+				++unknownCommands_;
+				return;
+			}
+			switch (command_[2]) {
+				case 'n': mount_.guide(Mount::GuideDirection::NORTH, durationMs * 1000); break;
+				case 's': mount_.guide(Mount::GuideDirection::SOUTH, durationMs * 1000); break;
+				case 'e': mount_.guide(Mount::GuideDirection::EAST, durationMs * 1000); break;
+				case 'w': mount_.guide(Mount::GuideDirection::WEST, durationMs * 1000); break;
+				default: ++unknownCommands_; break;
+			}
+		} else if (is("M") && command_[2] == '\0') {
+			auto speed = JOG_SPEEDS[static_cast<std::size_t>(rate_)];
+			switch (command_[1]) {
+				case 'n': jogY_ = speed; break;
+				case 's': jogY_ = -speed; break;
+				case 'e': jogX_ = -speed; break;
+				case 'w': jogX_ = speed; break;
+				default: ++unknownCommands_; return;
+			}
+			mount_.manualControlSetSpeed({jogX_, jogY_});
+		} else if (is("R") && command_[2] == '\0') {
+			switch (command_[1]) {
+				case 'G': rate_ = Rate::GUIDE; break;
+				case 'C': rate_ = Rate::CENTER; break;
+				case 'M': rate_ = Rate::FIND; break;
+				case 'S': rate_ = Rate::SLEW; break;
+				default: ++unknownCommands_; break;
+			}
+		} else if (is("GVP")) {
+			output_.print("stars-tracker#");
+		} else {
+			++unknownCommands_;
+		}
+	}
+
+	// HH:MM:SS# or HH:MM.T#
+	void printRA(double ra) {
+		char s[16];
+		auto tenths = std::lround(ra * RAD_TO_DEG / 15 * (highPrecision_ ? 3600 : 600));
+		auto units = highPrecision_ ? 24 * 3600L : 24 * 600L;
+		tenths = (tenths % units + units) % units;
+		if (highPrecision_) {
+			snprintf(s, sizeof(s), "%02ld:%02ld:%02ld#", tenths / 3600, tenths / 60 % 60, tenths % 60);
+		} else {
+			snprintf(s, sizeof(s), "%02ld:%02ld.%01ld#", tenths / 600, tenths / 10 % 60, tenths % 10);
+		}
+		output_.print(s);
+	}
+
+	// sDD*MM'SS# or sDD*MM#
+	void printDec(double dec) {
+		char s[16];
+		auto unitsPerDegree = highPrecision_ ? 3600 : 60;
+		auto units = static_cast<int>(std::clamp<long>(std::lround(std::fabs(dec) * RAD_TO_DEG * unitsPerDegree), 0,
+			90 * unitsPerDegree));
+		auto sign = dec < 0 ? '-' : '+';
+		if (highPrecision_) {
+			snprintf(s, sizeof(s), "%c%02d*%02d'%02d#", sign, units / 3600, units / 60 % 60, units % 60);
+		} else {
+			snprintf(s, sizeof(s), "%c%02d*%02d#", sign, units / 60, units % 60);
+		}
+		output_.print(s);
+	}
+
+	Mount& mount_;
+	Print& output_;
+
+	char command_[MAX_COMMAND_LENGTH + 1];
+	std::size_t length_ = 0;
+	bool inCommand_ = false;
+	bool highPrecision_ = true;
+
+	bool positionValid_ = false;
+	uint32_t positionTimestampUs_ = 0;
+	std::pair<double, double> position_ = {0, 0};
+
+	bool targetRASet_ = false;
+	bool targetDecSet_ = false;
+	std::pair<double, double> target_ = {0, 0};
+
+	Rate rate_ = Rate::SLEW;
+	int8_t jogX_ = 0;
+	int8_t jogY_ = 0;
+
+	uint32_t commands_ = 0;
+	uint32_t unknownCommands_ = 0;
+};
+
+// Feeds LX200 bytes to the server and passes the rest through, so SerialCommands and planetarium software share
+// the serial port. Injected lines (scheduled scripts) are read in between typed lines. Writes go straight to
+// `stream`.
+class SerialDemux : public Stream {
+public:
+	static constexpr const std::size_t INJECT_SIZE = 192;
+
+	SerialDemux(Stream& stream, Lx200Server& lx200) : stream_(stream), lx200_(lx200) {}
+
+	int available() override {
+		fill();
+		return pending_ >= 0 ? 1 : 0;
+	}
+	int read() override {
+		fill();
+		auto byte = pending_;
+		pending_ = -1;
+		return byte;
+	}
+	int peek() override {
+		fill();
+		return pending_;
+	}
+	size_t write(uint8_t byte) override {
+		return stream_.write(byte);
+	}
+	void flush() override {
+		stream_.flush();
+	}
+	using Print::write;
+
+	// Queues `line` as if typed, it is read once the serial input is at a line start. Returns false when it does
+	// not fit. Call from the reading task only.
+	bool inject(const char* line) {
+		auto length = std::strlen(line);
+		if (injectedLength_ + length + 2 > INJECT_SIZE) {
+			return false;
+		}
+		for (std::size_t i = 0; i < length; ++i) {
+			pushInjected(line[i]);
+		}
+		pushInjected('\r');
+		pushInjected('\n');
+		return true;
+	}
+
+private:
+	void pushInjected(char byte) {
+		injected_[(injectedStart_ + injectedLength_++) % INJECT_SIZE] = byte;
+	}
+
+	void fill() {
+		while (pending_ < 0) {
+			if (injecting_ || (lineStart_ && injectedLength_ > 0)) {
+				auto byte = static_cast<uint8_t>(injected_[injectedStart_]);
+				injectedStart_ = (injectedStart_ + 1) % INJECT_SIZE;
+				--injectedLength_;
+				lineStart_ = byte == '\n';
+				injecting_ = !lineStart_;
+				pending_ = byte;
+				break;
+			}
+			if (stream_.available() <= 0) {
+				break;
+			}
+			auto byte = stream_.read();
+			if (byte < 0) {
+				break;
+			}
+			if (lx200_.accept(byte, lineStart_)) {
+				continue;
+			}
+			// "\r\n" ends a command line
+			lineStart_ = byte == '\n';
+			pending_ = byte;
+		}
+	}
+
+	Stream& stream_;
+	Lx200Server& lx200_;
+	int pending_ = -1;
+	bool lineStart_ = true;
+
+	std::array<char, INJECT_SIZE> injected_;
+	std::size_t injectedStart_ = 0;
+	std::size_t injectedLength_ = 0;
+	bool injecting_ = false;
+};
+
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+
+namespace ui {
+
+// Everything a menu entry can do. ScreenUI::dispatch() is the only place that interprets them, `arg` meaning
+// is given per action.
+enum class Action : uint8_t {
+	NONE,
+	// arg: MenuId
+	OPEN_MENU,
+	OPEN_DASHBOARD,
+	OPEN_SKY_MAP,
+	OPEN_TRACKING_ERROR,
+	// back from confirm screen to the catalog list it was opened from
+	BACK_TO_LIST,
+	MOUNT_EQ,
+	MOUNT_AZ,
+	EASY_TRACK_POLE,
+	EASY_TRACK_TWO_STAR,
+	POLE_ALIGNMENT_OK,
+	POLE_ALIGNMENT_THEN_TWO_STAR_OK,
+	POLE_ALIGNMENT_AZ_OK,
+	POLE_ALIGNMENT_TEST,
+	POLE_ALIGNMENT_HOME,
+	// arg: star index
+	SELECT_FIRST_STAR,
+	FIRST_STAR_OK,
+	// arg: star index
+	SELECT_SECOND_STAR,
+	SECOND_STAR_OK,
+	GOTO_STARS,
+	GOTO_MESSIER,
+	TRANSITS_NEXT,
+	BEST_NOW,
+	TOGGLE_VISIBLE_ONLY,
+	// arg: Sky object index
+	SELECT_GOTO_OBJECT,
+	GOTO_OK,
+};
+
+enum class MenuId : uint8_t {
+	MOUNT_TYPE,
+	OPERATION_MODE,
+	EASY_TRACK_ALIGNMENT,
+	POLE_ALIGNMENT_EQ,
+	POLE_ALIGNMENT_THEN_TWO_STAR_EQ,
+	POLE_ALIGNMENT_AZ,
+	FIRST_STAR_CONFIRM,
+	SECOND_STAR_CONFIRM,
+	ALIGNMENT_FINISHED,
+	GOTO_OBJECTS,
+	GOTO_CONFIRM,
+	last = GOTO_CONFIRM,
+};
+
+constexpr uint16_t arg(MenuId id) {
+	return static_cast<uint16_t>(id);
+}
+
+class ActionDispatcher {
+public:
+	virtual void dispatch(Action action, uint16_t arg) = 0;
+	// label of entries declared with nullptr label, eg. toggles
+	virtual const char* label(Action action) const = 0;
+};
+
+struct MenuItem {
+	const char* label;
+	Action action;
+	uint16_t arg;
+};
+
+struct Menu {
+	static constexpr const std::size_t MAX_TEXT_LINES = 3;
+
+	const char* title;
+	std::array<const char*, MAX_TEXT_LINES> text;
+	const MenuItem* items;
+	uint8_t itemCount;
+	MenuItem exit;
+};
+
+namespace menu {
+
+constexpr const MenuItem MOUNT_TYPE_ITEMS[] = {
+	{"EQ", Action::MOUNT_EQ},
+	{"AZ", Action::MOUNT_AZ},
+};
+
+// Full operation mode features:
+// - goto rightascension and declination coords
+// - planets and moon tracking
+// - manual control
+// Requires:
+// - date, time, location
+// Alignment:
+// - 2 star
+// - 3 star
+// Easy track operation mode features:
+// - compensate earth rotation
+// - switch on/off
+// - manual control
+// Requires:
+// - nothing but alignment
+// Alignment:
+// - pole
+// - 2 star
+constexpr const MenuItem OPERATION_MODE_ITEMS[] = {
+	{"Full", Action::NONE},
+	{"Easy track", Action::OPEN_MENU, arg(MenuId::EASY_TRACK_ALIGNMENT)},
+};
+
+constexpr const MenuItem EASY_TRACK_ALIGNMENT_ITEMS[] = {
+	{"pole", Action::EASY_TRACK_POLE},
+	{"2 star", Action::EASY_TRACK_TWO_STAR},
+};
+
+constexpr const MenuItem POLE_ALIGNMENT_EQ_ITEMS[] = {
+	{"OK", Action::POLE_ALIGNMENT_OK},
+	{"Test", Action::POLE_ALIGNMENT_TEST},
+	{"Home", Action::POLE_ALIGNMENT_HOME},
+};
+
+constexpr const MenuItem POLE_ALIGNMENT_THEN_TWO_STAR_EQ_ITEMS[] = {
+	{"OK", Action::POLE_ALIGNMENT_THEN_TWO_STAR_OK},
+	{"Test", Action::POLE_ALIGNMENT_TEST},
+	{"Home", Action::POLE_ALIGNMENT_HOME},
+};
+
+constexpr const MenuItem POLE_ALIGNMENT_AZ_ITEMS[] = {
+	{"OK", Action::POLE_ALIGNMENT_AZ_OK},
+};
+
+constexpr const MenuItem FIRST_STAR_CONFIRM_ITEMS[] = {
+	{"OK", Action::FIRST_STAR_OK},
+};
+
+constexpr const MenuItem SECOND_STAR_CONFIRM_ITEMS[] = {
+	{"OK", Action::SECOND_STAR_OK},
+};
+
+constexpr const MenuItem ALIGNMENT_FINISHED_ITEMS[] = {
+	{"OK", Action::OPEN_DASHBOARD},
+};
+
+constexpr const MenuItem GOTO_OBJECTS_ITEMS[] = {
+	{"Stars", Action::GOTO_STARS},
+	{"Messier", Action::GOTO_MESSIER},
+	{"Transits next", Action::TRANSITS_NEXT},
+	{"Best now", Action::BEST_NOW},
+	{"NGC", Action::NONE},
+	{"Manual", Action::NONE},
+	{nullptr, Action::TOGGLE_VISIBLE_ONLY},
+};
+
+constexpr const MenuItem GOTO_CONFIRM_ITEMS[] = {
+	{"OK", Action::GOTO_OK},
+	{"Cancel", Action::NONE},
+};
+
+template<std::size_t N>
+constexpr uint8_t count(const MenuItem (&)[N]) {
+	return N;
+}
+
+constexpr const MenuItem NO_EXIT = {nullptr, Action::NONE};
+
+}
+
+// Indexed by MenuId. Confirm screens text is filled in by ScreenUI.
+constexpr const std::array<Menu, static_cast<std::size_t>(MenuId::last) + 1> MENUS = {{
+	{"Mount type", {}, menu::MOUNT_TYPE_ITEMS, menu::count(menu::MOUNT_TYPE_ITEMS), menu::NO_EXIT},
+	{"Operation mode", {}, menu::OPERATION_MODE_ITEMS, menu::count(menu::OPERATION_MODE_ITEMS),
+		{nullptr, Action::OPEN_MENU, arg(MenuId::MOUNT_TYPE)}},
+	{"Easy track alignment", {}, menu::EASY_TRACK_ALIGNMENT_ITEMS, menu::count(menu::EASY_TRACK_ALIGNMENT_ITEMS),
+		{nullptr, Action::OPEN_MENU, arg(MenuId::OPERATION_MODE)}},
+	{"EQ - Pole alignment", {"Move to north pole", "and press OK"}, menu::POLE_ALIGNMENT_EQ_ITEMS, menu::count(menu::POLE_ALIGNMENT_EQ_ITEMS),
+		{nullptr, Action::OPEN_MENU, arg(MenuId::EASY_TRACK_ALIGNMENT)}},
+	{"EQ 2S- Pole alignment", {"Move to north pole", "and press OK"}, menu::POLE_ALIGNMENT_THEN_TWO_STAR_EQ_ITEMS, menu::count(menu::POLE_ALIGNMENT_THEN_TWO_STAR_EQ_ITEMS),
+		{nullptr, Action::OPEN_MENU, arg(MenuId::EASY_TRACK_ALIGNMENT)}},
+	{"AZ - Pole alignment", {"Move to north pole", "and press OK"}, menu::POLE_ALIGNMENT_AZ_ITEMS, menu::count(menu::POLE_ALIGNMENT_AZ_ITEMS),
+		{nullptr, Action::OPEN_MENU, arg(MenuId::EASY_TRACK_ALIGNMENT)}},
+	{"2S alignment 1/2", {}, menu::FIRST_STAR_CONFIRM_ITEMS, menu::count(menu::FIRST_STAR_CONFIRM_ITEMS),
+		{nullptr, Action::BACK_TO_LIST}},
+	{"2S alignment 2/2", {}, menu::SECOND_STAR_CONFIRM_ITEMS, menu::count(menu::SECOND_STAR_CONFIRM_ITEMS),
+		{nullptr, Action::BACK_TO_LIST}},
+	{"", {"Alignment finished!"}, menu::ALIGNMENT_FINISHED_ITEMS, menu::count(menu::ALIGNMENT_FINISHED_ITEMS), menu::NO_EXIT},
+	{"GOTO Objects", {}, menu::GOTO_OBJECTS_ITEMS, menu::count(menu::GOTO_OBJECTS_ITEMS),
+		{nullptr, Action::OPEN_DASHBOARD}},
+	{"GOTO Object", {}, menu::GOTO_CONFIRM_ITEMS, menu::count(menu::GOTO_CONFIRM_ITEMS),
+		{nullptr, Action::BACK_TO_LIST}},
+}};
+
+}
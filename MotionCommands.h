@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace scope {
+
+// Everything other tasks may ask the motion task to do. Payload meaning is given per kind, `postedUs` is
+// stamped by Mount::post() and used for queue latency.
+struct MotionCommand {
+	enum class Kind : uint8_t {
+		// a, b: axis position (steps)
+		MOVE_TO,
+		// a, b: axis position (deg)
+		MOVE_TO_DEG,
+		// a: X axis position (deg), Y axis keeps its position
+		MOVE_TO_X_DEG,
+		// a, b: RA and Dec (rad)
+		MOVE_TO_RADEC,
+		// a, b: speed (-128 : 127)
+		JOG,
+		TRACK_TOGGLE,
+		STOP,
+		// current position is the pole
+		SYNC_POLE,
+		// a, b: RA and Dec (rad) of the star at current position
+		SYNC_FIRST_STAR,
+		SYNC_SECOND_STAR,
+		// a, b: RA and Dec (rad) at current position, EQ mount only
+		SYNC_RADEC,
+		// a: Mount::MountType
+		SET_MOUNT_TYPE,
+		// a: UTC unix time (s), tracking and alignment timestamps move with the clock
+		SET_TIME,
+		// a: Mount::GuideDirection, b: pulse duration (us)
+		GUIDE,
+		// a: guide rate, fraction of sidereal rate
+		SET_GUIDE_RATE,
+		RESET_TRACKING_ERROR,
+		RESET_COMMAND_STATS,
+		RESET_GUIDE_STATS,
+	};
+
+	Kind kind;
+	int32_t speed;
+	uint32_t postedUs;
+	double a;
+	double b;
+};
+
+}
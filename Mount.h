@@ -1,24 +1,30 @@
 #pragma once
 
 #include "CoordsUtils.h"
+#include "GuidePulses.h"
+#include "Log.h"
+#include "MotionCommands.h"
+#include "MpscQueue.h"
+#include "Profiler.h"
+#include "Telemetry.h"
+#include "TrackingError.h"
 
 #include <Arduino.h>
 #include <AccelStepper.h>
-#include <Stream.h>
 #include <WiFi.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
 #include <utility>
 
-#define DEBUG_MOUNT
-
-#ifdef DEBUG_MOUNT
-#define LOG_DEBUG(x) x
-#else
-#define LOG_DEBUG(x)
-#endif
-
 namespace scope {
 
+// Steppers and everything derived from their positions belong to the motion task, the one calling tick().
+// Other tasks (UI, serial, PS4) post commands through a lock-free queue, tick() applies them every
+// COMMAND_INTERVAL_US, so a command waits at most one interval plus the batch before it. After the batch
+// tick() publishes a State snapshot, other tasks read the mount only through state().
 class Mount {
 public:
 	static constexpr const int X_AXIS_DRIVER_STEP_DIV = 16;
@@ -43,6 +49,57 @@ public:
 
 	static constexpr const int MAX_SPEED = 400;
 	static constexpr const int MAX_ACCELERATION = 800;
+	// manual control ramps the speed, a step change at full speed stalls the steppers
+	static constexpr const double JOG_ACCELERATION = MAX_ACCELERATION;
+	// ramp step limit after a late tick
+	static constexpr const uint32_t MAX_JOG_PLAN_INTERVAL_US = 10000;
+
+	// guide pulses move this fraction of the sidereal rate on top of tracking
+	static constexpr const double DEFAULT_GUIDE_RATE = 0.5;
+	static constexpr const uint32_t MAX_GUIDE_PULSE_MS = 10000;
+	// sidereal rate, steps/s
+	static constexpr const double X_AXIS_SIDEREAL_SPEED = X_AXIS_ANGLE_RAD_TO_STEPS * coords::EARTH_ANG_SPEED;
+	static constexpr const double Y_AXIS_SIDEREAL_SPEED = Y_AXIS_ANGLE_RAD_TO_STEPS * coords::EARTH_ANG_SPEED;
+
+	static constexpr const std::size_t COMMAND_QUEUE_SIZE = 16;
+	static constexpr const uint32_t COMMAND_INTERVAL_US = 1000;
+	static constexpr const uint32_t AUTO_TRACK_INTERVAL_US = 200000;
+	static constexpr const uint32_t TRACKING_ERROR_INTERVAL_US = 250000;
+
+	struct CommandStats {
+		uint32_t commands = 0;
+		// queue was full, command was dropped
+		uint32_t rejected = 0;
+		uint32_t maxQueued = 0;
+		// from post() until applied
+		uint32_t lastLatencyUs = 0;
+		uint32_t maxLatencyUs = 0;
+		// one batch, time the steppers were not serviced
+		uint32_t lastApplyUs = 0;
+		uint32_t maxApplyUs = 0;
+	};
+
+	struct StepTiming {
+		uint32_t lastStepUs = 0;
+		// stepped at a speed since the last stop
+		bool stepping = false;
+	};
+
+	struct GuideStats {
+		uint32_t pulses = 0;
+		// axis queue was full
+		uint32_t dropped = 0;
+		// not auto tracking
+		uint32_t ignored = 0;
+	};
+
+	// east and west move the X axis (RA on EQ mount), north and south the Y axis
+	enum GuideDirection : uint8_t {
+		NORTH,
+		SOUTH,
+		EAST,
+		WEST
+	};
 
 	enum MountType : uint8_t {
 		EQ,
@@ -62,7 +119,87 @@ public:
 		MOVE_TO
 	};
 
-	Mount(AccelStepper& stepperX, AccelStepper& stepperY, Stream& serial) : stepperX_(stepperX), stepperY_(stepperY), serial_(serial) {
+	// Copy of the motion task state at `timestampUs`, consistent across all fields
+	struct State {
+		uint32_t timestampUs = 0;
+		// steps
+		int32_t positionX = 0;
+		int32_t positionY = 0;
+		int32_t targetX = 0;
+		int32_t targetY = 0;
+		// steps/s
+		float speedX = 0;
+		float speedY = 0;
+		MountType mountType = MountType::EQ;
+		OperationMode operationMode = OperationMode::UNINITIALIZED;
+		TrackingMode trackingMode = TrackingMode::MANUAL_CONTROL;
+
+		// fraction of sidereal rate
+		float guideRate = DEFAULT_GUIDE_RATE;
+		bool guidingX = false;
+		bool guidingY = false;
+		// steps, added to tracking by guide pulses since tracking started
+		float guideOffsetX = 0;
+		float guideOffsetY = 0;
+
+		double alignmentTimestamp = 0;
+		double alignmentAngle = 0;
+		std::pair<double, double> alignmentDelta = {0, 0};
+		bool skyPivotSet = false;
+		std::pair<double, double> skyPivotRad = {0, 0};
+
+		// last RA and Dec (radians) passed to safeMoveToPositionRADec()
+		bool gotoTargetSet = false;
+		std::pair<double, double> gotoTargetRADec = {0, 0};
+
+		// `rejected` is counted by the posting tasks, see commandStats()
+		CommandStats commandStats;
+		GuideStats guideStats;
+		// settime applied, the clock is UTC
+		bool clockSet = false;
+
+		std::pair<double, double> positionDeg() const {
+			return {positionX * X_AXIS_STEPS_TO_ANGLE_DEG, positionY * Y_AXIS_STEPS_TO_ANGLE_DEG};
+		}
+
+		std::pair<double, double> targetDeg() const {
+			return {targetX * X_AXIS_STEPS_TO_ANGLE_DEG, targetY * Y_AXIS_STEPS_TO_ANGLE_DEG};
+		}
+
+		// Inverse of safeMoveToPositionRADec(): `result` is RA and Dec pair in radians. Requires star alignment.
+		bool positionRADec(std::pair<double, double>& result) const {
+			if (operationMode != OperationMode::EASY_TRACK_GOTO && operationMode != OperationMode::FULL_GOTO) {
+				return false;
+			}
+			double now = 0;
+			if (!getTimeOfDaySeconds(now)) {
+				return false;
+			}
+			auto angle = -coords::EARTH_ANG_SPEED * (now - alignmentTimestamp);
+			auto mountPositionDeg = normalizedEQDeg(positionDeg());
+			std::pair<double, double> mountPositionRad = {mountPositionDeg.first * DEG_TO_RAD, mountPositionDeg.second * DEG_TO_RAD};
+
+			if (mountType == MountType::EQ) {
+				result = coords::translatePoint(mountPositionRad, {-angle - alignmentDelta.first, -alignmentDelta.second});
+			} else {
+				if (!skyPivotSet) {
+					return false;
+				}
+				auto alignedPositionRad = coords::rotatePoint(mountPositionRad, -angle, skyPivotRad);
+				auto skyPositionRad = coords::translatePoint(alignedPositionRad, {-alignmentDelta.first, -alignmentDelta.second});
+				result = coords::rotatePoint(skyPositionRad, -alignmentAngle);
+			}
+
+			result.first = std::fmod(result.first, TWO_PI);
+			if (result.first < 0) {
+				result.first += TWO_PI;
+			}
+			result.second = std::max(-HALF_PI, std::min(HALF_PI, result.second));
+			return true;
+		}
+	};
+
+	Mount(AccelStepper& stepperX, AccelStepper& stepperY) : stepperX_(stepperX), stepperY_(stepperY) {
 		// stepperX_.disableOutputs();
 		stepperX_.setMaxSpeed(MAX_SPEED);
 		stepperX_.setAcceleration(MAX_ACCELERATION);
@@ -72,6 +209,7 @@ public:
 		stepperY_.setMaxSpeed(MAX_SPEED);
 		stepperY_.setAcceleration(MAX_ACCELERATION);
 		stepperY_.setCurrentPosition(Y_AXIS_HOME);
+		publishState();
 	}
 
 	void disableSteppers() {
@@ -105,55 +243,245 @@ public:
 		}
 		autoTrackStartTimeStamp_ = timestamp;
 		autoTrackStartCoords_ = std::pair<double, double>{stepperX_.currentPosition(), stepperY_.currentPosition()};
+		guideOffset_ = {0, 0};
+		guideAppliedSteps_ = {0, 0};
 		trackingMode_ = TrackingMode::AUTO_TRACKING;
+		resetTrackingErrorStats();
 	}
 
 	void stopAutoTrack() {
 		trackingMode_ = TrackingMode::MANUAL_CONTROL;
+		for (auto& pulses : guidePulses_) {
+			pulses.clear();
+		}
+		jogSpeed_ = {0, 0};
+		jogTargetSpeed_ = {0, 0};
 		stepperX_.setSpeed(0);
 		stepperY_.setSpeed(0);
 	}
 
-	void toggleAutoTrack() {
-		if (trackingMode_ == TrackingMode::MANUAL_CONTROL) {
-			startAutoTrack();
-		} else {
-			stopAutoTrack();
+	// Commands, callable from any task. They return false when the queue is full.
+
+	bool moveTo(std::pair<int, int> position, int speed = MAX_SPEED) {
+		return post({MotionCommand::Kind::MOVE_TO, speed, 0, static_cast<double>(position.first), static_cast<double>(position.second)});
+	}
+
+	bool moveToDeg(std::pair<double, double> position, int speed = MAX_SPEED) {
+		return post({MotionCommand::Kind::MOVE_TO_DEG, speed, 0, position.first, position.second});
+	}
+
+	// Y axis keeps its position
+	bool moveToXDeg(double position, int speed = MAX_SPEED) {
+		return post({MotionCommand::Kind::MOVE_TO_X_DEG, speed, 0, position, 0});
+	}
+
+	// `position` is RA and Dec pair in radians
+	bool moveToRADec(std::pair<double, double> position, int speed = MAX_SPEED) {
+		return post({MotionCommand::Kind::MOVE_TO_RADEC, speed, 0, position.first, position.second});
+	}
+
+	bool stop() {
+		return post({MotionCommand::Kind::STOP});
+	}
+
+	bool toggleAutoTrack() {
+		return post({MotionCommand::Kind::TRACK_TOGGLE});
+	}
+
+	// tracking error statistics start again, as they do when tracking starts
+	bool resetTrackingError() {
+		return post({MotionCommand::Kind::RESET_TRACKING_ERROR});
+	}
+
+	// Fraction of MAX_SPEED per axis, -1 : 1, reached with JOG_ACCELERATION. Call from one task only, unchanged
+	// speed is not posted.
+	bool jog(std::pair<float, float> speedXY) {
+		if (speedXY == lastJogSpeed_) {
+			return true;
+		}
+		if (!post({MotionCommand::Kind::JOG, 0, 0, speedXY.first, speedXY.second})) {
+			return false;
+		}
+		lastJogSpeed_ = speedXY;
+		return true;
+	}
+
+	// PS4 range: -128 : 127  int8_t
+	bool manualControlSetSpeed(std::pair<int8_t, int8_t> speedXY) {
+		return jog({speedXY.first / 128.0f, speedXY.second / 128.0f});
+	}
+
+	// Moves `direction` at the guide rate for `durationUs` on top of tracking. Pulses of one axis run back to back,
+	// the axes independently. Ignored unless auto tracking.
+	bool guide(GuideDirection direction, uint32_t durationUs) {
+		return post({MotionCommand::Kind::GUIDE, 0, 0, static_cast<double>(direction), static_cast<double>(durationUs)});
+	}
+
+	// fraction of sidereal rate
+	bool setGuideRate(double rate) {
+		return post({MotionCommand::Kind::SET_GUIDE_RATE, 0, 0, rate, 0});
+	}
+
+	// current position is the pole, switches to easy track
+	bool alignPole() {
+		return post({MotionCommand::Kind::SYNC_POLE});
+	}
+
+	bool setTwoStarAlignmentFirstStar(std::pair<double, double> firstStarRAandDecRad) {
+		return post({MotionCommand::Kind::SYNC_FIRST_STAR, 0, 0, firstStarRAandDecRad.first, firstStarRAandDecRad.second});
+	}
+
+	// One star alignment of EQ mount: current position is `position` (RA and Dec in radians), switches to easy
+	// track goto. Ignored on AZ mount, it needs two star alignment.
+	bool sync(std::pair<double, double> position) {
+		return post({MotionCommand::Kind::SYNC_RADEC, 0, 0, position.first, position.second});
+	}
+
+	bool setMountType(MountType mountType) {
+		return post({MotionCommand::Kind::SET_MOUNT_TYPE, 0, 0, static_cast<double>(mountType), 0});
+	}
+
+	// switches to easy track goto
+	bool setTwoStarAlignmentSecondStar(std::pair<double, double> secondStarRAandDecRad) {
+		return post({MotionCommand::Kind::SYNC_SECOND_STAR, 0, 0, secondStarRAandDecRad.first, secondStarRAandDecRad.second});
+	}
+
+	// Any task, never blocks the motion task. Retries only when the copy overlapped a publication.
+	State state() const {
+		for (;;) {
+			auto before = stateSequence_.load(std::memory_order_acquire);
+			if (before & 1) {
+				continue;
+			}
+			State copy = state_;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (stateSequence_.load(std::memory_order_relaxed) == before) {
+				return copy;
+			}
+		}
+	}
+
+	// Tracking error while auto tracking, since tracking started, TrackingError::summary() of it gives RMS and
+	// amplitudes. Seqlock copy like state().
+	TrackingError::Totals trackingError() const {
+		for (;;) {
+			auto before = trackingErrorSequence_.load(std::memory_order_acquire);
+			if (before & 1) {
+				continue;
+			}
+			TrackingError::Totals copy = trackingErrorTotals_;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (trackingErrorSequence_.load(std::memory_order_relaxed) == before) {
+				return copy;
+			}
 		}
 	}
 
-	// call with longer interval eg. 200ms
+	// Any task, copy from the state snapshot
+	CommandStats commandStats() const {
+		auto stats = state().commandStats;
+		stats.rejected = rejected_.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	// the motion task clears its statistics
+	bool resetCommandStats() {
+		return post({MotionCommand::Kind::RESET_COMMAND_STATS});
+	}
+
+	// Any task, copy from the state snapshot
+	GuideStats guideStats() const { return state().guideStats; }
+
+	// the motion task clears its statistics
+	bool resetGuideStats() {
+		return post({MotionCommand::Kind::RESET_GUIDE_STATS});
+	}
+
+	// motion task only, tick() calls it every AUTO_TRACK_INTERVAL_US
 	void computeAutoTrackCoords() {
 		if (trackingMode_ != TrackingMode::AUTO_TRACKING) {
 			return;
 		}
 		auto angle = getEarthDeltaAngleSinceTimestamp(autoTrackStartTimeStamp_);
 
-		LOG_DEBUG(serial_.printf("computeAutoTrackCoords() angle delta(rad): %f\n", angle));
-		LOG_DEBUG(serial_.printf("computeAutoTrackCoords() start coords(rad): %f, %f\n", autoTrackStartCoords_.first * X_AXIS_STEPS_TO_ANGLE_RAD, autoTrackStartCoords_.second * Y_AXIS_STEPS_TO_ANGLE_RAD));
-		if (mountType_ == MountType::EQ) {
-			targetCoords_ = coords::translatePoint(autoTrackStartCoords_, {X_AXIS_ANGLE_RAD_TO_STEPS * angle, 0});
-		} else {
-			LOG_DEBUG(serial_.printf("computeAutoTrackCoords() pivot coords(rad): %f, %f\n", autoTrackPivot_.first * X_AXIS_STEPS_TO_ANGLE_RAD, autoTrackPivot_.second * Y_AXIS_STEPS_TO_ANGLE_RAD));
-			targetCoords_ = coords::rotatePoint(autoTrackStartCoords_, angle, autoTrackPivot_);
+		LOG(AUTO_TRACK_ANGLE, angle);
+		LOG(AUTO_TRACK_START, autoTrackStartCoords_.first * X_AXIS_STEPS_TO_ANGLE_RAD, autoTrackStartCoords_.second * Y_AXIS_STEPS_TO_ANGLE_RAD);
+		if (mountType_ == MountType::AZ) {
+			LOG(AUTO_TRACK_PIVOT, autoTrackPivot_.first * X_AXIS_STEPS_TO_ANGLE_RAD, autoTrackPivot_.second * Y_AXIS_STEPS_TO_ANGLE_RAD);
 		}
-		LOG_DEBUG(serial_.printf("computeAutoTrackCoords() target coords(rad): %f, %f\n", targetCoords_.first * X_AXIS_STEPS_TO_ANGLE_RAD, targetCoords_.second * Y_AXIS_STEPS_TO_ANGLE_RAD));
+		targetCoords_ = coords::translatePoint(autoTrackPositionSteps(angle), guideOffset_);
+		guideAppliedSteps_ = {std::lround(guideOffset_.first), std::lround(guideOffset_.second)};
+		LOG(AUTO_TRACK_TARGET, targetCoords_.first * X_AXIS_STEPS_TO_ANGLE_RAD, targetCoords_.second * Y_AXIS_STEPS_TO_ANGLE_RAD);
 		safeMoveTo({targetCoords_});
 	}
 
-	// PS4 range: -128 : 127  int8_t
-	void manualControlSetSpeed(std::pair<int8_t, int8_t> speedXY) {
-		if (speedXY == lastManualControlSpeed_) {
+	// where auto tracking wants the mount (steps, before limits) after earth rotated by `angle` since start
+	std::pair<double, double> autoTrackPositionSteps(double angle) const {
+		if (mountType_ == MountType::EQ) {
+			return coords::translatePoint(autoTrackStartCoords_, {X_AXIS_ANGLE_RAD_TO_STEPS * angle, 0});
+		}
+		return coords::rotatePoint(autoTrackStartCoords_, angle, autoTrackPivot_);
+	}
+
+	void startGuidePulse(GuideDirection direction, int32_t durationUs, uint32_t requestedUs) {
+		LOG(GUIDE_PULSE, direction, durationUs);
+		if (trackingMode_ != TrackingMode::AUTO_TRACKING) {
+			++guideStats_.ignored;
+			return;
+		}
+		auto& pulses = guidePulses_[direction == GuideDirection::NORTH || direction == GuideDirection::SOUTH ? 1 : 0];
+		auto sign = direction == GuideDirection::NORTH || direction == GuideDirection::WEST ? 1 : -1;
+		if (!pulses.push(sign * durationUs, requestedUs)) {
+			++guideStats_.dropped;
 			return;
 		}
-		lastManualControlSpeed_ = speedXY;
+		++guideStats_.pulses;
+	}
+
+	// Motion task every COMMAND_INTERVAL_US. Guide pulse time integrates into a step offset at the guide rate, whole
+	// steps go straight into the stepper targets, between auto track updates, which then include the offset.
+	void applyGuidePulses(uint32_t now) {
+		auto elapsedX = guidePulses_[0].advance(now);
+		auto elapsedY = guidePulses_[1].advance(now);
+		if (elapsedX == 0 && elapsedY == 0) {
+			return;
+		}
+		guideOffset_.first += elapsedX / 1e6 * guideRate_ * X_AXIS_SIDEREAL_SPEED;
+		guideOffset_.second += elapsedY / 1e6 * guideRate_ * Y_AXIS_SIDEREAL_SPEED;
+		std::pair<long, long> steps = {std::lround(guideOffset_.first), std::lround(guideOffset_.second)};
+		if (steps.first != guideAppliedSteps_.first) {
+			stepperX_.moveTo(stepperX_.targetPosition() + steps.first - guideAppliedSteps_.first);
+		}
+		if (steps.second != guideAppliedSteps_.second) {
+			stepperY_.moveTo(stepperY_.targetPosition() + steps.second - guideAppliedSteps_.second);
+		}
+		guideAppliedSteps_ = steps;
+	}
+
+	// fraction of MAX_SPEED, planJog() ramps towards it
+	void setManualControlSpeed(double speedX, double speedY) {
+		if (trackingMode_ != TrackingMode::MANUAL_CONTROL) {
+			// continue from the goto or tracking speed
+			jogSpeed_ = {stepperX_.speed(), stepperY_.speed()};
+			trackingMode_ = TrackingMode::MANUAL_CONTROL;
+		}
+		jogTargetSpeed_ = {speedX * MAX_SPEED, speedY * MAX_SPEED};
+	}
 
-		auto newSpeedX = speedXY.first/128.0 * MAX_SPEED;
-		auto newSpeedY = speedXY.second/128.0 * MAX_SPEED;
+	static double approach(double value, double target, double maxChange) {
+		return target > value ? std::min(target, value + maxChange) : std::max(target, value - maxChange);
+	}
 
-		trackingMode_ = TrackingMode::MANUAL_CONTROL;
-		stepperX_.setSpeed(newSpeedX);
-		stepperY_.setSpeed(newSpeedY);
+	// acceleration limited manual control speed, motion task every COMMAND_INTERVAL_US
+	void planJog(uint32_t elapsedUs) {
+		if (trackingMode_ != TrackingMode::MANUAL_CONTROL || jogSpeed_ == jogTargetSpeed_) {
+			return;
+		}
+		auto maxChange = JOG_ACCELERATION * std::min(elapsedUs, MAX_JOG_PLAN_INTERVAL_US) / 1e6;
+		jogSpeed_.first = approach(jogSpeed_.first, jogTargetSpeed_.first, maxChange);
+		jogSpeed_.second = approach(jogSpeed_.second, jogTargetSpeed_.second, maxChange);
+		stepperX_.setSpeed(jogSpeed_.first);
+		stepperY_.setSpeed(jogSpeed_.second);
 	}
 
 
@@ -178,16 +506,16 @@ public:
 	}
 
 	void stopMountMove() {
-		LOG_DEBUG(serial_.println("stopMountMove() stopping mount"));
+		LOG(STOP_MOUNT_MOVE);
 		safeMoveTo({stepperX_.currentPosition(), stepperY_.currentPosition()});
 	}
 
 	void safeMoveTo(std::pair<int, int> position, int speed = MAX_SPEED) {
-		LOG_DEBUG(serial_.printf("safeMoveTo() moveto(steps): %d, %d\n", position.first, position.second));
+		LOG(MOVE_TO_STEPS, position.first, position.second);
 		if (!normalizeTargetSteps(position)) {
 			return;
 		}
-		LOG_DEBUG(serial_.printf("safeMoveTo() moveto(limits,steps): %d, %d\n", position.first, position.second));
+		LOG(MOVE_TO_LIMITED_STEPS, position.first, position.second);
 		stepperX_.moveTo(stepperX_.currentPosition());
 		stepperY_.moveTo(stepperY_.currentPosition());
 		stepperX_.setMaxSpeed(speed);
@@ -197,36 +525,40 @@ public:
 	}
 
 	void safeMoveToPositionRad(std::pair<double, double> position, int speed = MAX_SPEED) {
-		LOG_DEBUG(serial_.printf("safeMoveToPositionRad(): position(rad) %f, %f\n", position.first, position.second));
+		LOG(MOVE_TO_RAD, position.first, position.second);
 		safeMoveTo({position.first * X_AXIS_ANGLE_RAD_TO_STEPS, position.second * Y_AXIS_ANGLE_RAD_TO_STEPS}, speed);
 	}
 
 	void safeMoveToPositionDeg(std::pair<double, double> position, int speed = MAX_SPEED) {
-		LOG_DEBUG(serial_.printf("safeMoveToPositionDeg(): position(deg) %f, %f\n", position.first, position.second));
+		LOG(MOVE_TO_DEG, position.first, position.second);
 		safeMoveToPositionRad({position.first * DEG_TO_RAD, position.second * DEG_TO_RAD}, speed);
 	}
 
 	// `position` is RA and Dec pair in radians
 	void safeMoveToPositionRADec(std::pair<double, double> position, int speed  = MAX_SPEED) {
-		LOG_DEBUG(serial_.printf("safeMoveToPositionRADec(): position(rad) %f, %f\n", position.first, position.second));
+		LOG(MOVE_TO_RADEC, position.first, position.second);
 		auto angle = getEarthDeltaAngleSinceTimestamp(alignmentTimestamp_);
-		LOG_DEBUG(serial_.printf("safeMoveToPositionRADec(): angle delta(rad) %f\n", angle));
+		LOG(MOVE_TO_RADEC_ANGLE, angle);
 
 		if (mountType_ == MountType::EQ) {
 			auto mountPositionRad = coords::translatePoint(position, alignmentDelta_);
 			safeMoveToPositionRad(coords::translatePoint(mountPositionRad, {angle, 0}), speed);
+			gotoTargetRADec_ = position;
+			gotoTargetSet_ = true;
 		} else {
 			if (!skyPivotSet_) {
-				serial_.print("safeMoveToPositionRADec(). skyPivot not set.");
+				LOG(MOVE_TO_RADEC_NO_PIVOT);
 				//TODO show error somehow
 				return;
 			}
 			auto mountPositionRad = coords::translatePoint(coords::rotatePoint(position, alignmentAngle_), alignmentDelta_);
 			safeMoveToPositionRad(coords::rotatePoint(mountPositionRad, angle, skyPivotRad_), speed);
+			gotoTargetRADec_ = position;
+			gotoTargetSet_ = true;
 		}
 	}
 
-	bool getTimeOfDaySeconds(double& result) const {
+	static bool getTimeOfDaySeconds(double& result) {
 		timeval tv;
 		if (gettimeofday(&tv, NULL) != 0) {
 			return false;
@@ -235,10 +567,24 @@ public:
 		return true;
 	}
 
+	// `seconds` is UTC unix time. The motion task sets the clock and shifts timestamps taken before in one step,
+	// so tracking does not jump. Returns false when the motion queue is full.
+	bool setTimeOfDaySeconds(double seconds) {
+		return post({MotionCommand::Kind::SET_TIME, 0, 0, seconds, 0});
+	}
+
+	// true once the motion task set the clock
+	bool clockSet() const { return state().clockSet; }
+
+	void setSite(coords::Site site) {
+		site_ = site;
+		siteSet_ = true;
+	}
+
 	double getEarthDeltaAngleSinceTimestamp(double time) const {
 		double timestamp = 0;
 		if (!getTimeOfDaySeconds(timestamp)) {
-			serial_.print("safeMoveToPositionRADec(). gettimeofday() failed.");
+			LOG(EARTH_ANGLE_NO_TIME);
 			//TODO show error somehow
 			return 0;
 		}
@@ -256,8 +602,10 @@ public:
 	}
 
 	std::pair<double, double> currentPositionDegEQNormalized() const {
-		auto position = currentPositionDeg();
+		return normalizedEQDeg(currentPositionDeg());
+	}
 
+	static std::pair<double, double> normalizedEQDeg(std::pair<double, double> position) {
 		position.second = std::fmod(position.second, 360);
 		while (position.second > 90 || position.second < -90) {
 			position.first += 180;
@@ -279,47 +627,21 @@ public:
 		return {position.first * DEG_TO_RAD, position.second * DEG_TO_RAD};
 	}
 
-	// coords::RA currentPositionRADecNormalized() const {
-	// 	// TODO use alignment angle and current rotation to be correct
-	// 	return coords::degToRA(currentPositionXDeg());
-	// }
-
-	// coords::Dec currentPositionDec() const {
-	// 	// TODO use alignment angle and current rotation to be correct
-	// 	return coords::degToDec(currentPositionYDeg());
-	// }
-
-	double targetPositionXDeg() const {
-		return stepperX_.targetPosition() * X_AXIS_STEPS_TO_ANGLE_DEG;
-	}
-
-	double targetPositionYDeg() const {
-		return stepperY_.targetPosition() * Y_AXIS_STEPS_TO_ANGLE_DEG;
-	}
-
-	double targetPositionXRad() const {
-		return stepperX_.targetPosition() * X_AXIS_STEPS_TO_ANGLE_RAD;
-	}
-
-	double targetPositionYRad() const {
-		return stepperY_.targetPosition() * Y_AXIS_STEPS_TO_ANGLE_RAD;
-	}
-
-	void setTwoStarAlignmentFirstStar(std::pair<double, double> firstStarRAandDecRad) {
+	void alignFirstStar(std::pair<double, double> firstStarRAandDecRad) {
 		twoStarAlignmentFirstStarRad_ = firstStarRAandDecRad;
 		twoStarAlignmentFirstStarMountRad_ = currentPositionRadEQNormalized();
 		twoStarAlignmentFirstStarSet_ = true;
 	}
 
-	void setTwoStarAlignmentSecondStar(std::pair<double, double> secondStarRAandDecRad) {
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): first star mount(rad) %f, %f\n", twoStarAlignmentFirstStarMountRad_.first, twoStarAlignmentFirstStarMountRad_.second));
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): first star(rad) %f, %f\n", twoStarAlignmentFirstStarRad_.first, twoStarAlignmentFirstStarRad_.second));
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): second star mount(rad) %f, %f\n", currentPositionRadEQNormalized().first, currentPositionRadEQNormalized().second));
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): second star(rad) %f, %f\n", secondStarRAandDecRad.first, secondStarRAandDecRad.second));
+	void alignSecondStar(std::pair<double, double> secondStarRAandDecRad) {
+		LOG(SECOND_STAR_FIRST_MOUNT, twoStarAlignmentFirstStarMountRad_.first, twoStarAlignmentFirstStarMountRad_.second);
+		LOG(SECOND_STAR_FIRST_STAR, twoStarAlignmentFirstStarRad_.first, twoStarAlignmentFirstStarRad_.second);
+		LOG(SECOND_STAR_SECOND_MOUNT, currentPositionRadEQNormalized().first, currentPositionRadEQNormalized().second);
+		LOG(SECOND_STAR_SECOND_STAR, secondStarRAandDecRad.first, secondStarRAandDecRad.second);
 
 		double timestamp = 0;
 		if (!getTimeOfDaySeconds(timestamp)) {
-			serial_.print("setTwoStarAlignmentSecondStar(). gettimeofday() failed.");
+			LOG(SECOND_STAR_NO_TIME);
 			//TODO show error somehow
 			return;
 		}
@@ -333,7 +655,7 @@ public:
 					(deltaXYFirstStar.first + deltaXYSecondStar.first) / 2,
 					(deltaXYFirstStar.second + deltaXYSecondStar.second) / 2
 			};
-			LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): alignment delta(rad) %f, %f\n", alignmentDelta_.first, alignmentDelta_.second));
+			LOG(ALIGNMENT_DELTA, alignmentDelta_.first, alignmentDelta_.second);
 			return;
 		}
 
@@ -343,10 +665,10 @@ public:
 				coords::lineFrom2Points(twoStarAlignmentFirstStarRad_, secondStarRAandDecRad).first,
 				coords::lineFrom2Points(twoStarAlignmentFirstStarMountRad_, currentPositionRadEQNormalized()).first
 		);
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): alignment angle(rad) %f\n", alignmentAngle_));
+		LOG(ALIGNMENT_ANGLE, alignmentAngle_);
 
 		alignmentDelta_ = coords::deltaXdeltaYFrom2Points(twoStarAlignmentFirstStarRad_, twoStarAlignmentFirstStarMountRad_, alignmentAngle_);
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): alignment delta(rad) %f, %f\n", alignmentDelta_.first, alignmentDelta_.second));
+		LOG(ALIGNMENT_DELTA, alignmentDelta_.first, alignmentDelta_.second);
 
 		skyPivotRad_ = coords::translatePoint(coords::rotatePoint({0, 90 * DEG_TO_RAD}, alignmentAngle_), alignmentDelta_);
 		skyPivotSet_ = true;
@@ -354,12 +676,63 @@ public:
 		if (normalizeTargetSteps(autoTrackPivot_)) {
 			autoTrackPivotSet_ = true;
 		}
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): sky pivot(rad) %f, %f\n", skyPivotRad_.first, skyPivotRad_.second));
-		LOG_DEBUG(serial_.printf("setTwoStarAlignmentSecondStar(): autotrack pivot(steps) %f, %f\n", autoTrackPivot_.first, autoTrackPivot_.second));
+		LOG(ALIGNMENT_SKY_PIVOT, skyPivotRad_.first, skyPivotRad_.second);
+		LOG(ALIGNMENT_AUTOTRACK_PIVOT, autoTrackPivot_.first, autoTrackPivot_.second);
+	}
+
+	bool syncRADec(std::pair<double, double> position) {
+		double timestamp = 0;
+		if (!getTimeOfDaySeconds(timestamp)) {
+			return false;
+		}
+		alignmentTimestamp_ = timestamp;
+		alignmentDelta_ = coords::deltaXdeltaYFrom2Points(position, currentPositionRadEQNormalized());
+		LOG(SYNC_DELTA, alignmentDelta_.first, alignmentDelta_.second);
+		return true;
 	}
 
-	// call as frequent as possible
+	// motion task only, call as frequent as possible
 	void tick() {
+		using Cause = profile::Profiler::Cause;
+		auto& profiler = profile::profiler();
+		uint32_t now = micros();
+		++ticks_;
+		auto gapUs = now - tickTimestampUs_;
+		maxTickGapUs_ = std::max(maxTickGapUs_, gapUs);
+		tickTimestampUs_ = now;
+		if (ticked_) {
+			profiler.recordLoopGap(gapUs, now, tickCause_);
+		}
+		ticked_ = true;
+		// a step of this iteration waits for its sections, or for the ones of the previous iteration
+		auto previousCause = tickCause_;
+		tickCause_ = Cause::NONE;
+		uint32_t commandsUs = 0;
+		if (now - commandsTimestampUs_ >= COMMAND_INTERVAL_US) {
+			auto elapsedUs = now - commandsTimestampUs_;
+			commandsTimestampUs_ = now;
+			// before the batch, a pulse posted after the previous one ended must not start at its end
+			applyGuidePulses(now);
+			processCommands(now);
+			planJog(elapsedUs);
+			publishState();
+			recordTelemetry(now);
+			sampleTrackingError(now);
+			commandsUs = micros() - now;
+			profiler.record(profile::Probe::COMMANDS, commandsUs, now);
+			tickCause_ = Cause::COMMANDS;
+		}
+		if (now - autoTrackTimestampUs_ >= AUTO_TRACK_INTERVAL_US) {
+			autoTrackTimestampUs_ = now;
+			uint32_t start = micros();
+			computeAutoTrackCoords();
+			auto autoTrackUs = micros() - start;
+			profiler.record(profile::Probe::AUTOTRACK, autoTrackUs, start);
+			if (autoTrackUs >= commandsUs) {
+				tickCause_ = Cause::AUTOTRACK;
+			}
+		}
+
 		// TODO reset target to current and no return
 		// if ((stepperX_.targetPosition() > X_AXIS_UPPER_LIMIT) || (stepperX_.targetPosition() < X_AXIS_LOWER_LIMIT) ||
 		// 	(stepperY_.targetPosition() > Y_AXIS_UPPER_LIMIT) || (stepperY_.targetPosition() < Y_AXIS_LOWER_LIMIT)) {
@@ -373,6 +746,10 @@ public:
 		// if ((stepperY_.currentPosition() >= Y_AXIS_UPPER_LIMIT) || (stepperY_.currentPosition() <= Y_AXIS_LOWER_LIMIT)) {
 		// 	stepperY_.setSpeed(0);
 		// }
+		auto positionX = stepperX_.currentPosition();
+		auto positionY = stepperY_.currentPosition();
+		auto speedX = stepperX_.speed();
+		auto speedY = stepperY_.speed();
 		if (trackingMode_ == TrackingMode::MANUAL_CONTROL) {
 			stepperX_.runSpeed();
 			stepperY_.runSpeed();
@@ -380,20 +757,262 @@ public:
 			stepperX_.run();
 			stepperY_.run();
 		}
+		auto cause = tickCause_ != Cause::NONE ? tickCause_ : previousCause;
+		profileStep(stepTimingX_, stepperX_.currentPosition() != positionX, speedX, cause);
+		profileStep(stepTimingY_, stepperY_.currentPosition() != positionY, speedY, cause);
+	}
+
+	// How much later than the interval of `speed` a step came, the sections before it delay it. The first step after
+	// a stop has no interval.
+	void profileStep(StepTiming& timing, bool stepped, float speed, profile::Profiler::Cause cause) {
+		if (speed == 0) {
+			timing.stepping = false;
+			return;
+		}
+		if (!stepped) {
+			return;
+		}
+		uint32_t now = micros();
+		if (timing.stepping) {
+			auto intervalUs = static_cast<uint32_t>(1e6f / std::fabs(speed));
+			auto gapUs = now - timing.lastStepUs;
+			profile::profiler().recordStepLate(gapUs > intervalUs ? gapUs - intervalUs : 0, now, cause);
+		}
+		timing.lastStepUs = now;
+		timing.stepping = true;
+	}
+
+	bool post(MotionCommand command) {
+		command.postedUs = micros();
+		if (!commands_.push(command)) {
+			rejected_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	void processCommands(uint32_t now) {
+		auto queued = static_cast<uint32_t>(commands_.size());
+		if (queued == 0) {
+			return;
+		}
+		commandStats_.maxQueued = std::max(commandStats_.maxQueued, queued);
+		MotionCommand command;
+		while (commands_.pop(command)) {
+			// posted on another core after `now` was read
+			uint32_t latency = static_cast<int32_t>(now - command.postedUs) > 0 ? now - command.postedUs : 0;
+			commandStats_.lastLatencyUs = latency;
+			commandStats_.maxLatencyUs = std::max(commandStats_.maxLatencyUs, latency);
+			++commandStats_.commands;
+			apply(command);
+		}
+		uint32_t applyUs = micros() - now;
+		commandStats_.lastApplyUs = applyUs;
+		commandStats_.maxApplyUs = std::max(commandStats_.maxApplyUs, applyUs);
+	}
+
+	void publishState() {
+		auto sequence = stateSequence_.load(std::memory_order_relaxed);
+		stateSequence_.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		state_.timestampUs = micros();
+		state_.positionX = stepperX_.currentPosition();
+		state_.positionY = stepperY_.currentPosition();
+		state_.targetX = stepperX_.targetPosition();
+		state_.targetY = stepperY_.targetPosition();
+		state_.speedX = stepperX_.speed();
+		state_.speedY = stepperY_.speed();
+		state_.mountType = mountType_;
+		state_.operationMode = operationMode_;
+		state_.trackingMode = trackingMode_;
+		state_.guideRate = guideRate_;
+		state_.guidingX = guidePulses_[0].active();
+		state_.guidingY = guidePulses_[1].active();
+		state_.guideOffsetX = guideOffset_.first;
+		state_.guideOffsetY = guideOffset_.second;
+		state_.alignmentTimestamp = alignmentTimestamp_;
+		state_.alignmentAngle = alignmentAngle_;
+		state_.alignmentDelta = alignmentDelta_;
+		state_.skyPivotSet = skyPivotSet_;
+		state_.skyPivotRad = skyPivotRad_;
+		state_.gotoTargetSet = gotoTargetSet_;
+		state_.gotoTargetRADec = gotoTargetRADec_;
+		state_.commandStats = commandStats_;
+		state_.guideStats = guideStats_;
+		state_.clockSet = clockSet_;
+		stateSequence_.store(sequence + 2, std::memory_order_release);
+	}
+
+	static_assert(1000000 / COMMAND_INTERVAL_US == telemetry::Recorder::SAMPLE_RATE_HZ, "Telemetry is sampled with commands");
+
+	void recordTelemetry(uint32_t now) {
+		using telemetry::Channel;
+		auto& recorder = telemetry::recorder();
+		if (recorder.due(Channel::POSITION)) {
+			recorder.record(Channel::POSITION, now, state_.targetX, state_.targetY, state_.positionX, state_.positionY);
+		}
+		if (recorder.due(Channel::VELOCITY)) {
+			recorder.record(Channel::VELOCITY, now, state_.speedX, state_.speedY);
+		}
+		// the last sample, computing the error costs a clock read and for AZ a rotation
+		if (recorder.due(Channel::TRACKING_ERROR) && trackingMode_ == TrackingMode::AUTO_TRACKING) {
+			recorder.record(Channel::TRACKING_ERROR, now, static_cast<float>(trackingErrorSample_.first),
+				static_cast<float>(trackingErrorSample_.second));
+		}
+		if (recorder.due(Channel::LOOP)) {
+			recorder.record(Channel::LOOP, now, ticks_, maxTickGapUs_);
+			ticks_ = 0;
+			maxTickGapUs_ = 0;
+		}
+		if (recorder.due(Channel::MODE)) {
+			recorder.record(Channel::MODE, now, trackingMode_, operationMode_, mountType_);
+		}
+	}
+
+	// auto tracking: where the sky, the alignment and the guiding want the axes now, minus where they are
+	std::pair<double, double> trackingErrorSteps() {
+		auto ideal = coords::translatePoint(autoTrackPositionSteps(getEarthDeltaAngleSinceTimestamp(autoTrackStartTimeStamp_)), guideOffset_);
+		normalizeTargetSteps(ideal);
+		return {ideal.first - stepperX_.currentPosition(), ideal.second - stepperY_.currentPosition()};
+	}
+
+	void sampleTrackingError(uint32_t now) {
+		if (trackingMode_ != TrackingMode::AUTO_TRACKING || now - trackingErrorTimestampUs_ < TRACKING_ERROR_INTERVAL_US) {
+			return;
+		}
+		trackingErrorTimestampUs_ = now;
+		trackingErrorSample_ = trackingErrorSteps();
+		trackingError_.add(trackingErrorSample_.first, trackingErrorSample_.second);
+		publishTrackingError();
+	}
+
+	void resetTrackingErrorStats() {
+		trackingError_.reset(TRACKING_ERROR_INTERVAL_US / 1e6);
+		trackingErrorTimestampUs_ = micros();
+		trackingErrorSample_ = {0, 0};
+		publishTrackingError();
+	}
+
+	void publishTrackingError() {
+		auto sequence = trackingErrorSequence_.load(std::memory_order_relaxed);
+		trackingErrorSequence_.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		trackingErrorTotals_ = trackingError_.totals();
+		trackingErrorSequence_.store(sequence + 2, std::memory_order_release);
+	}
+
+	// the clock change goes to tracking and alignment timestamps before the next autotrack target
+	void setTime(double seconds) {
+		double previous = 0;
+		timeval tv;
+		tv.tv_sec = static_cast<time_t>(seconds);
+		tv.tv_usec = static_cast<suseconds_t>((seconds - tv.tv_sec) * pow(10,6));
+		if (!getTimeOfDaySeconds(previous) || settimeofday(&tv, NULL) != 0) {
+			LOG(SET_TIME_FAILED);
+			return;
+		}
+		clockSet_ = true;
+		autoTrackStartTimeStamp_ += seconds - previous;
+		alignmentTimestamp_ += seconds - previous;
+	}
+
+	void apply(const MotionCommand& command) {
+		switch (command.kind) {
+			case MotionCommand::Kind::MOVE_TO:
+				trackingMode_ = TrackingMode::MOVE_TO;
+				safeMoveTo({std::lround(command.a), std::lround(command.b)}, command.speed);
+				break;
+			case MotionCommand::Kind::MOVE_TO_DEG:
+				trackingMode_ = TrackingMode::MOVE_TO;
+				safeMoveToPositionDeg({command.a, command.b}, command.speed);
+				break;
+			case MotionCommand::Kind::MOVE_TO_X_DEG:
+				trackingMode_ = TrackingMode::MOVE_TO;
+				safeMoveToPositionDeg({command.a, currentPositionDeg().second}, command.speed);
+				break;
+			case MotionCommand::Kind::MOVE_TO_RADEC:
+				trackingMode_ = TrackingMode::MOVE_TO;
+				safeMoveToPositionRADec({command.a, command.b}, command.speed);
+				break;
+			case MotionCommand::Kind::JOG:
+				setManualControlSpeed(command.a, command.b);
+				break;
+			case MotionCommand::Kind::TRACK_TOGGLE:
+				if (trackingMode_ == TrackingMode::MANUAL_CONTROL) {
+					startAutoTrack();
+				} else {
+					stopAutoTrack();
+				}
+				break;
+			case MotionCommand::Kind::STOP:
+				stopAutoTrack();
+				break;
+			case MotionCommand::Kind::SYNC_POLE:
+				setAutoTrackPivot();
+				operationMode_ = OperationMode::EASY_TRACK;
+				break;
+			case MotionCommand::Kind::SYNC_FIRST_STAR:
+				alignFirstStar({command.a, command.b});
+				break;
+			case MotionCommand::Kind::SYNC_SECOND_STAR:
+				alignSecondStar({command.a, command.b});
+				operationMode_ = OperationMode::EASY_TRACK_GOTO;
+				break;
+			case MotionCommand::Kind::SYNC_RADEC:
+				if (mountType_ == MountType::EQ && syncRADec({command.a, command.b})) {
+					operationMode_ = OperationMode::EASY_TRACK_GOTO;
+				}
+				break;
+			case MotionCommand::Kind::SET_MOUNT_TYPE:
+				mountType_ = static_cast<MountType>(command.a);
+				break;
+			case MotionCommand::Kind::SET_TIME:
+				setTime(command.a);
+				break;
+			case MotionCommand::Kind::GUIDE:
+				startGuidePulse(static_cast<GuideDirection>(command.a), static_cast<int32_t>(command.b), command.postedUs);
+				break;
+			case MotionCommand::Kind::SET_GUIDE_RATE:
+				guideRate_ = command.a;
+				break;
+			case MotionCommand::Kind::RESET_TRACKING_ERROR:
+				resetTrackingErrorStats();
+				break;
+			case MotionCommand::Kind::RESET_COMMAND_STATS:
+				commandStats_ = CommandStats{};
+				rejected_.store(0, std::memory_order_relaxed);
+				break;
+			case MotionCommand::Kind::RESET_GUIDE_STATS:
+				guideStats_ = GuideStats{};
+				break;
+		}
 	}
 
 	AccelStepper& stepperX_;
 	AccelStepper& stepperY_;
-	Stream& serial_;
 	MountType mountType_ = MountType::EQ;
 	OperationMode operationMode_ = OperationMode::UNINITIALIZED;
 	TrackingMode trackingMode_ = TrackingMode::MANUAL_CONTROL;
+	// manual control, steps/s
+	std::pair<double, double> jogSpeed_ = {0, 0};
+	std::pair<double, double> jogTargetSpeed_ = {0, 0};
+	// X and Y axis
+	std::array<GuidePulseQueue, 2> guidePulses_;
+	double guideRate_ = DEFAULT_GUIDE_RATE;
+	// steps since tracking started, whole steps of it are already in the stepper targets
+	std::pair<double, double> guideOffset_ = {0, 0};
+	std::pair<long, long> guideAppliedSteps_ = {0, 0};
+	GuideStats guideStats_;
+
+	bool clockSet_ = false;
+	bool siteSet_ = false;
+	coords::Site site_ = {0, 0};
 
 	bool autoTrackPivotSet_ = false;
 	std::pair<double, double> autoTrackPivot_ = {0, 0};
 	std::pair<double, double> autoTrackStartCoords_ = {0, 0};
 	double autoTrackStartTimeStamp_ = 0;
-	std::pair<int8_t, int8_t> lastManualControlSpeed_ = {0, 0};
+	std::pair<float, float> lastJogSpeed_ = {0, 0};
 	std::pair<double, double> targetCoords_ = {0, 0};
 
 	bool twoStarAlignmentFirstStarSet_ = false;
@@ -404,6 +1023,39 @@ public:
 	double alignmentTimestamp_ = 0;
 	bool skyPivotSet_ = false;
 	std::pair<double, double> skyPivotRad_ = {0, 0};
+
+	// last RA and Dec (radians) passed to safeMoveToPositionRADec()
+	bool gotoTargetSet_ = false;
+	std::pair<double, double> gotoTargetRADec_ = {0, 0};
+
+	MpscQueue<MotionCommand, COMMAND_QUEUE_SIZE> commands_;
+	std::atomic<uint32_t> rejected_{0};
+	CommandStats commandStats_;
+	uint32_t commandsTimestampUs_ = 0;
+	uint32_t autoTrackTimestampUs_ = 0;
+
+	// between telemetry LOOP samples
+	uint32_t ticks_ = 0;
+	uint32_t maxTickGapUs_ = 0;
+	uint32_t tickTimestampUs_ = 0;
+
+	// profiler: section that held up the last iteration, last step of each axis
+	bool ticked_ = false;
+	profile::Profiler::Cause tickCause_ = profile::Profiler::Cause::NONE;
+	StepTiming stepTimingX_;
+	StepTiming stepTimingY_;
+
+	// motion task's statistics, published after every sample
+	TrackingError trackingError_{TRACKING_ERROR_INTERVAL_US / 1e6};
+	uint32_t trackingErrorTimestampUs_ = 0;
+	// steps, every TRACKING_ERROR_INTERVAL_US, also for telemetry
+	std::pair<double, double> trackingErrorSample_ = {0, 0};
+	std::atomic<uint32_t> trackingErrorSequence_{0};
+	TrackingError::Totals trackingErrorTotals_;
+
+	// seqlock: odd while publishState() writes `state_`
+	std::atomic<uint32_t> stateSequence_{0};
+	State state_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <atomic>
+
+namespace scope {
+
+// Bounded multi producer single consumer queue (D. Vyukov). Every cell has a sequence number telling
+// producers whether it is free for the round they claimed, so push() is one CAS on `head_` and pop() never
+// touches producer state. No locks, no allocation, full queue is reported to the producer.
+template<typename T, std::size_t N>
+class MpscQueue {
+public:
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscQueue size must be a power of 2");
+
+	MpscQueue() {
+		for (std::size_t i = 0; i < N; ++i) {
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// any task
+	bool push(const T& value) {
+		auto position = head_.load(std::memory_order_relaxed);
+		for (;;) {
+			auto& cell = cells_[position & (N - 1)];
+			auto sequence = cell.sequence.load(std::memory_order_acquire);
+			auto diff = static_cast<int32_t>(sequence - position);
+			if (diff == 0) {
+				if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					cell.value = value;
+					cell.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			} else if (diff < 0) {
+				return false;
+			} else {
+				position = head_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// consumer task only
+	bool pop(T& value) {
+		auto& cell = cells_[tail_ & (N - 1)];
+		auto sequence = cell.sequence.load(std::memory_order_acquire);
+		if (static_cast<int32_t>(sequence - (tail_ + 1)) < 0) {
+			return false;
+		}
+		value = cell.value;
+		cell.sequence.store(tail_ + N, std::memory_order_release);
+		++tail_;
+		return true;
+	}
+
+	// consumer task only, approximate when producers are active
+	std::size_t size() const {
+		return head_.load(std::memory_order_relaxed) - tail_;
+	}
+
+private:
+	struct Cell {
+		std::atomic<uint32_t> sequence;
+		T value;
+	};
+
+	std::array<Cell, N> cells_;
+	std::atomic<uint32_t> head_{0};
+	uint32_t tail_ = 0;
+};
+
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Print.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace profile {
+
+// Every probe: id, name, what it measures. Motion task probes are written in Mount::tick(), UI task probes around
+// the steps of its loop and its timers; each probe has one writer.
+#define PROFILER_PROBES(X) \
+	X(LOOP_GAP, "loop", "time between loop() iterations") \
+	X(STEP_LATE, "step", "step pulse later than the stepper's interval") \
+	X(COMMANDS, "commands", "motion command batch, jog planning, state and telemetry") \
+	X(AUTOTRACK, "autotrack", "auto tracking target") \
+	X(PS4, "ps4", "controller report, Bluetooth task") \
+	X(INPUT_EVENTS, "input", "input events") \
+	X(SCRIPTS, "scripts", "scheduled commands") \
+	X(SERIAL_READ, "serial", "serial read and commands") \
+	X(DRAW, "draw", "screen draw timer") \
+	X(SKY, "sky", "sky timer")
+
+enum class Probe : uint8_t {
+#define PROFILER_PROBE_ID(id, name, description) id,
+	PROFILER_PROBES(PROFILER_PROBE_ID)
+#undef PROFILER_PROBE_ID
+	count,
+};
+
+constexpr const char* PROBE_NAMES[] = {
+#define PROFILER_PROBE_NAME(id, name, description) name,
+	PROFILER_PROBES(PROFILER_PROBE_NAME)
+#undef PROFILER_PROBE_NAME
+};
+
+constexpr const char* PROBE_DESCRIPTIONS[] = {
+#define PROFILER_PROBE_DESCRIPTION(id, name, description) description,
+	PROFILER_PROBES(PROFILER_PROBE_DESCRIPTION)
+#undef PROFILER_PROBE_DESCRIPTION
+};
+
+// Microseconds in log-linear buckets: exact below 4, then 4 buckets per power of two (within 25%), up to 16 s.
+// Recording is a count leading zeros, two shifts and two increments.
+class Histogram {
+public:
+	static constexpr const uint32_t SUB_BUCKET_BITS = 2;
+	static constexpr const uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+	static constexpr const uint32_t MAX_VALUE = (1u << 24) - 1;
+	static constexpr const std::size_t BUCKETS = (24 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	void record(uint32_t us, uint32_t now) {
+		++buckets_[index(us)];
+		++count_;
+		if (us >= max_) {
+			max_ = us;
+			maxAtUs_ = now;
+		}
+	}
+
+	uint32_t count() const { return count_; }
+	uint32_t max() const { return max_; }
+	uint32_t maxAtUs() const { return maxAtUs_; }
+
+	// upper bound of the bucket holding the `fraction` quantile, 0 when empty
+	uint32_t percentile(double fraction) const {
+		uint32_t total = count_;
+		if (total == 0) {
+			return 0;
+		}
+		auto rank = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(fraction * total)));
+		uint32_t seen = 0;
+		for (std::size_t i = 0; i < BUCKETS; ++i) {
+			seen += buckets_[i];
+			if (seen >= rank) {
+				return std::min(upperBound(i), max_);
+			}
+		}
+		return max_;
+	}
+
+	void reset() { *this = Histogram{}; }
+
+	static std::size_t index(uint32_t us) {
+		us = std::min(us, MAX_VALUE);
+		if (us < SUB_BUCKETS) {
+			return us;
+		}
+		uint32_t msb = 31 - __builtin_clz(us);
+		return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + ((us >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+	}
+
+	static uint32_t upperBound(std::size_t index) {
+		if (index < SUB_BUCKETS) {
+			return index;
+		}
+		uint32_t msb = index / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+		uint32_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << (msb - SUB_BUCKET_BITS);
+		return lower + (1u << (msb - SUB_BUCKET_BITS)) - 1;
+	}
+
+private:
+	std::array<uint32_t, BUCKETS> buckets_ = {};
+	uint32_t count_ = 0;
+	uint32_t max_ = 0;
+	uint32_t maxAtUs_ = 0;
+};
+
+// Histograms of every probe. Long loop gaps and late steps are blamed on the motion task section that ran in the
+// iteration before them (none when the loop only stepped: preemption, interrupts, flash writes). Readers on the
+// other core see counts of an ongoing update, good enough for statistics. reset() only requests it, each probe's
+// writer clears its histogram (and the loop gap and step causes) before its next record.
+class Profiler {
+public:
+	// loop gaps from here on are counted per cause
+	static constexpr const uint32_t LONG_GAP_US = 200;
+
+	enum class Cause : uint8_t {
+		NONE,
+		COMMANDS,
+		AUTOTRACK,
+		count,
+	};
+	static constexpr const char* CAUSE_NAMES[] = {"other", "commands", "autotrack"};
+
+	void record(Probe probe, uint32_t us, uint32_t now) {
+		auto i = static_cast<std::size_t>(probe);
+		auto& resetRequested = resetRequested_[i];
+		if (resetRequested.load(std::memory_order_relaxed) && resetRequested.exchange(false, std::memory_order_acquire)) {
+			histograms_[i].reset();
+			if (probe == Probe::LOOP_GAP) {
+				longGaps_ = {};
+				worstGapCause_ = Cause::NONE;
+			} else if (probe == Probe::STEP_LATE) {
+				worstStepCause_ = Cause::NONE;
+			}
+		}
+		histograms_[i].record(us, now);
+	}
+
+	// motion task: `gapUs` since the previous iteration, which ran `cause`
+	void recordLoopGap(uint32_t gapUs, uint32_t now, Cause cause) {
+		record(Probe::LOOP_GAP, gapUs, now);
+		if (gapUs >= LONG_GAP_US) {
+			++longGaps_[static_cast<std::size_t>(cause)];
+			if (gapUs >= histogram(Probe::LOOP_GAP).max()) {
+				worstGapCause_ = cause;
+			}
+		}
+	}
+
+	void recordStepLate(uint32_t lateUs, uint32_t now, Cause cause) {
+		record(Probe::STEP_LATE, lateUs, now);
+		if (lateUs >= histogram(Probe::STEP_LATE).max()) {
+			worstStepCause_ = cause;
+		}
+	}
+
+	const Histogram& histogram(Probe probe) const { return histograms_[static_cast<std::size_t>(probe)]; }
+
+	// any task, the writers apply it
+	void reset() {
+		for (auto& resetRequested : resetRequested_) {
+			resetRequested.store(true, std::memory_order_release);
+		}
+	}
+
+	// percentiles in us of every probe that recorded something, then the worst offenders
+	void print(Print& out) const {
+		out.printf("%-10s %9s %7s %7s %7s %7s %8s %8s\n", "probe", "count", "p50", "p90", "p99", "p99.9", "max", "at s");
+		const Histogram* worstSection = nullptr;
+		std::size_t worstSectionIndex = 0;
+		for (std::size_t i = 0; i < histograms_.size(); ++i) {
+			const auto& histogram = histograms_[i];
+			if (histogram.count() == 0 || resetPending(static_cast<Probe>(i))) {
+				continue;
+			}
+			out.printf("%-10s %9lu %7lu %7lu %7lu %7lu %8lu %8.3f\n", PROBE_NAMES[i],
+				static_cast<unsigned long>(histogram.count()), static_cast<unsigned long>(histogram.percentile(0.5)),
+				static_cast<unsigned long>(histogram.percentile(0.9)), static_cast<unsigned long>(histogram.percentile(0.99)),
+				static_cast<unsigned long>(histogram.percentile(0.999)), static_cast<unsigned long>(histogram.max()),
+				histogram.maxAtUs() / 1e6);
+			if (i > static_cast<std::size_t>(Probe::STEP_LATE) && (worstSection == nullptr || histogram.max() > worstSection->max())) {
+				worstSection = &histogram;
+				worstSectionIndex = i;
+			}
+		}
+		const auto& gaps = histogram(Probe::LOOP_GAP);
+		if (gaps.count() > 0 && !resetPending(Probe::LOOP_GAP)) {
+			out.printf("worst loop gap %lu us after %s\n", static_cast<unsigned long>(gaps.max()),
+				CAUSE_NAMES[static_cast<std::size_t>(worstGapCause_)]);
+			out.printf("loop gaps >= %lu us:", static_cast<unsigned long>(LONG_GAP_US));
+			for (std::size_t i = 0; i < longGaps_.size(); ++i) {
+				out.printf(" %s %lu", CAUSE_NAMES[i], static_cast<unsigned long>(longGaps_[i]));
+			}
+			out.println();
+		}
+		const auto& steps = histogram(Probe::STEP_LATE);
+		if (steps.count() > 0 && !resetPending(Probe::STEP_LATE)) {
+			out.printf("latest step %lu us after %s\n", static_cast<unsigned long>(steps.max()),
+				CAUSE_NAMES[static_cast<std::size_t>(worstStepCause_)]);
+		}
+		if (worstSection != nullptr) {
+			out.printf("longest section %s (%s) %lu us\n", PROBE_NAMES[worstSectionIndex],
+				PROBE_DESCRIPTIONS[worstSectionIndex], static_cast<unsigned long>(worstSection->max()));
+		}
+	}
+
+private:
+	// reset but not recorded since, printed as empty
+	bool resetPending(Probe probe) const {
+		return resetRequested_[static_cast<std::size_t>(probe)].load(std::memory_order_relaxed);
+	}
+
+	std::array<Histogram, static_cast<std::size_t>(Probe::count)> histograms_;
+	std::array<std::atomic<bool>, static_cast<std::size_t>(Probe::count)> resetRequested_ = {};
+	std::array<uint32_t, static_cast<std::size_t>(Cause::count)> longGaps_ = {};
+	Cause worstGapCause_ = Cause::NONE;
+	Cause worstStepCause_ = Cause::NONE;
+};
+
+inline Profiler& profiler() {
+	static Profiler instance;
+	return instance;
+}
+
+// Records the time until the end of the scope
+class Scope {
+public:
+	explicit Scope(Probe probe) : probe_(probe), startUs_(micros()) {}
+	~Scope() {
+		auto now = micros();
+		profiler().record(probe_, now - startUs_, now);
+	}
+
+	Scope(const Scope&) = delete;
+	Scope& operator=(const Scope&) = delete;
+
+private:
+	Probe probe_;
+	uint32_t startUs_;
+};
+
+}
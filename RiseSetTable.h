@@ -0,0 +1,231 @@
+#pragma once
+
+#include "CoordsUtils.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace coords {
+
+// Times are minutes since `RiseSetTable::start()` (local mean noon before the night).
+struct RiseSetEntry {
+	static constexpr const int16_t NONE = std::numeric_limits<int16_t>::min();
+	static constexpr const uint16_t ALWAYS = std::numeric_limits<uint16_t>::max();
+
+	int16_t rise;
+	int16_t transit;
+	int16_t set;
+	// how long object stays above minimum altitude on each side of transit, ALWAYS when it never goes below
+	uint16_t halfArcAboveMin;
+	// time above minimum altitude between dusk and dawn
+	uint16_t darkAboveMin;
+};
+
+// Rise, transit and set times of a whole catalog for one night and site. Rebuild is spread over several
+// `tick()` calls, `CHUNK_SIZE` objects each; the table is not ready until it finishes, entries of the previous
+// night are being overwritten.
+template<std::size_t N>
+class RiseSetTable {
+public:
+	static constexpr const std::size_t CHUNK_SIZE = 16;
+	static constexpr const double HORIZON_ALTITUDE_DEG = -0.5667; // refraction at horizon
+	static constexpr const double SUNSET_ALTITUDE_DEG = -0.833;
+	static constexpr const double DARKNESS_SUN_ALTITUDE_DEG = -12;
+	static constexpr const double SIDEREAL_DAY_S = TWO_PI / EARTH_ANG_SPEED;
+	static constexpr const double SOLAR_DAY_S = 86400;
+
+	// changes once per day, at local mean noon
+	static int32_t nightNumber(double unixSeconds, double longitudeRad) {
+		return static_cast<int32_t>(std::floor((unixSeconds + longitudeRad / TWO_PI * SOLAR_DAY_S) / SOLAR_DAY_S - 0.5));
+	}
+
+	void beginRebuild(const Site& site, double unixSeconds, double minAltitudeRad) {
+		site_ = site;
+		minAltitudeRad_ = minAltitudeRad;
+		night_ = nightNumber(unixSeconds, site.longitude);
+		start_ = (night_ + 0.5) * SOLAR_DAY_S - site.longitude / TWO_PI * SOLAR_DAY_S;
+		midnight_ = start_ + SOLAR_DAY_S / 2;
+		midnightLst_ = localSiderealTimeRad(midnight_, site.longitude);
+		computeDarkness();
+		cursor_ = 0;
+		rebuilding_ = true;
+		ready_ = false;
+	}
+
+	// `objectAt(i)` returns CatalogObject; returns true when rebuild finished with this call
+	template<typename ObjectAt>
+	bool tick(ObjectAt objectAt) {
+		if (!rebuilding_) {
+			return false;
+		}
+		auto end = std::min(cursor_ + CHUNK_SIZE, N);
+		for (; cursor_ < end; ++cursor_) {
+			const auto& object = objectAt(cursor_);
+			entries_[cursor_] = computeEntry(object.raRad(), object.decRad());
+		}
+		if (cursor_ < N) {
+			return false;
+		}
+		rebuilding_ = false;
+		ready_ = true;
+		return true;
+	}
+
+	bool ready() const { return ready_; }
+	bool rebuilding() const { return rebuilding_; }
+	int32_t night() const { return night_; }
+	const Site& site() const { return site_; }
+	double minAltitudeRad() const { return minAltitudeRad_; }
+	double start() const { return start_; }
+	int16_t dusk() const { return dusk_; }
+	int16_t dawn() const { return dawn_; }
+	const RiseSetEntry& operator[](std::size_t i) const { return entries_[i]; }
+	static constexpr std::size_t size() { return N; }
+
+	double timeAt(int16_t minutes) const {
+		return start_ + minutes * 60.0;
+	}
+
+	// seconds from `now` to next transit, negative value means it is not going to rise at all
+	double secondsToNextTransit(std::size_t i, double now) const {
+		if (entries_[i].rise == RiseSetEntry::NONE && entries_[i].set == RiseSetEntry::NONE) {
+			return -1;
+		}
+		auto delta = std::fmod(timeAt(entries_[i].transit) - now, SIDEREAL_DAY_S);
+		return delta < 0 ? delta + SIDEREAL_DAY_S : delta;
+	}
+
+	// seconds since nearest transit (negative before transit), wraps at half of sidereal day
+	double secondsFromTransit(std::size_t i, double now) const {
+		auto delta = std::fmod(now - timeAt(entries_[i].transit), SIDEREAL_DAY_S);
+		if (delta > SIDEREAL_DAY_S / 2) {
+			delta -= SIDEREAL_DAY_S;
+		} else if (delta < -SIDEREAL_DAY_S / 2) {
+			delta += SIDEREAL_DAY_S;
+		}
+		return delta;
+	}
+
+	bool aboveMinAltitude(std::size_t i, double now) const {
+		auto halfArc = entries_[i].halfArcAboveMin;
+		return halfArc == RiseSetEntry::ALWAYS || std::fabs(secondsFromTransit(i, now)) <= halfArc * 60.0;
+	}
+
+	// Indices of objects ordered by their next transit, returns number of written indices
+	template<std::size_t K>
+	std::size_t transitsNext(double now, std::array<uint16_t, K>& result) const {
+		std::array<float, N> keys;
+		for (std::size_t i = 0; i < N; ++i) {
+			keys[i] = entries_[i].halfArcAboveMin == 0 ? -1 : secondsToNextTransit(i, now);
+		}
+		return sortedBy(keys, result);
+	}
+
+	// Indices of objects above minimum altitude now, the closest to transit (the highest on its path) first
+	template<std::size_t K>
+	std::size_t bestNow(double now, std::array<uint16_t, K>& result) const {
+		std::array<float, N> keys;
+		for (std::size_t i = 0; i < N; ++i) {
+			keys[i] = aboveMinAltitude(i, now) ? std::fabs(secondsFromTransit(i, now)) : -1;
+		}
+		return sortedBy(keys, result);
+	}
+
+private:
+	// negative keys are skipped
+	template<std::size_t K>
+	static std::size_t sortedBy(const std::array<float, N>& keys, std::array<uint16_t, K>& result) {
+		std::array<uint16_t, N> indices;
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < N; ++i) {
+			if (keys[i] >= 0) {
+				indices[count++] = i;
+			}
+		}
+		auto resultCount = std::min(count, K);
+		std::partial_sort(indices.begin(), indices.begin() + resultCount, indices.begin() + count,
+				[&keys](uint16_t a, uint16_t b) { return keys[a] < keys[b]; });
+		std::copy(indices.begin(), indices.begin() + resultCount, result.begin());
+		return resultCount;
+	}
+
+	int16_t toMinutes(double time) const {
+		auto minutes = std::lround((time - start_) / 60);
+		return static_cast<int16_t>(std::max<long>(std::min<long>(minutes, std::numeric_limits<int16_t>::max()), RiseSetEntry::NONE + 1));
+	}
+
+	RiseSetEntry computeEntry(double ra, double dec) const {
+		// transit nearest to local midnight
+		auto hourAngle = std::remainder(midnightLst_ - ra, TWO_PI);
+		auto transit = midnight_ - hourAngle / EARTH_ANG_SPEED;
+
+		RiseSetEntry entry;
+		entry.transit = toMinutes(transit);
+
+		double horizonHourAngle = 0;
+		if (hourAngleAtAltitude(dec, site_.latitude, HORIZON_ALTITUDE_DEG * DEG_TO_RAD, horizonHourAngle)) {
+			entry.rise = toMinutes(transit - horizonHourAngle / EARTH_ANG_SPEED);
+			entry.set = toMinutes(transit + horizonHourAngle / EARTH_ANG_SPEED);
+		} else {
+			// circumpolar objects have no rise but keep set time as marker, never rising have none of them
+			entry.rise = RiseSetEntry::NONE;
+			entry.set = horizonHourAngle > 0 ? entry.transit : RiseSetEntry::NONE;
+		}
+
+		auto darkStart = timeAt(dusk_);
+		auto darkEnd = timeAt(dawn_);
+		double minHourAngle = 0;
+		if (!hourAngleAtAltitude(dec, site_.latitude, minAltitudeRad_, minHourAngle)) {
+			auto always = minHourAngle > 0;
+			entry.halfArcAboveMin = always ? RiseSetEntry::ALWAYS : 0;
+			entry.darkAboveMin = always ? std::lround((darkEnd - darkStart) / 60) : 0;
+			return entry;
+		}
+		auto halfArc = minHourAngle / EARTH_ANG_SPEED;
+		entry.halfArcAboveMin = std::lround(halfArc / 60);
+
+		double darkAboveMin = 0;
+		for (int day = -1; day <= 1; ++day) {
+			auto dayTransit = transit + day * SIDEREAL_DAY_S;
+			auto from = std::max(dayTransit - halfArc, darkStart);
+			auto to = std::min(dayTransit + halfArc, darkEnd);
+			darkAboveMin += std::max(0.0, to - from);
+		}
+		entry.darkAboveMin = std::lround(darkAboveMin / 60);
+		return entry;
+	}
+
+	void computeDarkness() {
+		auto sun = sunRADecRad(midnight_);
+		// Sun lower culmination nearest to midnight
+		auto lowerCulmination = midnight_ - std::remainder(midnightLst_ - sun.first - PI, TWO_PI) / EARTH_ANG_SPEED;
+
+		double hourAngle = 0;
+		if (!hourAngleAtAltitude(sun.second, site_.latitude, DARKNESS_SUN_ALTITUDE_DEG * DEG_TO_RAD, hourAngle) && hourAngle > 0) {
+			// no darkness (summer at high latitude), fall back to sunset and sunrise
+			hourAngleAtAltitude(sun.second, site_.latitude, SUNSET_ALTITUDE_DEG * DEG_TO_RAD, hourAngle);
+		}
+		auto halfNight = (PI - hourAngle) / TWO_PI * SOLAR_DAY_S;
+		dusk_ = toMinutes(lowerCulmination - halfNight);
+		dawn_ = toMinutes(lowerCulmination + halfNight);
+	}
+
+	std::array<RiseSetEntry, N> entries_;
+	Site site_ = {0, 0};
+	double minAltitudeRad_ = 0;
+	int32_t night_ = 0;
+	double start_ = 0;
+	double midnight_ = 0;
+	double midnightLst_ = 0;
+	int16_t dusk_ = 0;
+	int16_t dawn_ = 0;
+	std::size_t cursor_ = 0;
+	bool rebuilding_ = false;
+	bool ready_ = false;
+};
+
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstring>
+
+namespace scope {
+
+// Fires stored command lines at millisecond deadlines, one shot or periodic. Entries live in a hierarchical
+// timer wheel: level 0 has a slot per millisecond, every next level a slot per full turn of the previous one.
+// A tick touches only the current level 0 slot, an entry is moved down a level when its coarse slot comes up,
+// so the cost does not grow with the number of waiting entries. Not thread safe, use from one task.
+class ScriptScheduler {
+public:
+	static constexpr const std::size_t MAX_ENTRIES = 32;
+	static constexpr const std::size_t COMMAND_SIZE = 64;
+	static constexpr const uint8_t NONE = 0xFF;
+
+	static constexpr const std::size_t LEVELS = 4;
+	static constexpr const uint32_t LEVEL_0_BITS = 8;
+	static constexpr const uint32_t LEVEL_BITS = 6;
+	// 256 ms, 16.4 s, 17.5 min and 18.6 h per turn of level 0 .. 3
+	static constexpr const uint32_t MAX_DELAY_MS = (1u << (LEVEL_0_BITS + (LEVELS - 1) * LEVEL_BITS)) - 1;
+
+	struct Entry {
+		uint32_t deadlineMs;
+		// 0 for one shot
+		uint32_t periodMs;
+		uint32_t fired;
+		uint8_t prev;
+		uint8_t next;
+		uint8_t level;
+		uint8_t slot;
+		bool used;
+		std::array<char, COMMAND_SIZE> command;
+	};
+
+	explicit ScriptScheduler(uint32_t nowMs = 0) : currentMs_(nowMs) {
+		level0_.fill(NONE);
+		for (auto& level : levels_) {
+			level.fill(NONE);
+		}
+		for (auto& entry : entries_) {
+			entry.used = false;
+		}
+	}
+
+	// Runs `command` `delayMs` from `nowMs`, then every `periodMs` when not 0. Returns entry id or NONE when there
+	// is no free entry or the command is too long. Delays above MAX_DELAY_MS wait in the top level and cascade again.
+	uint8_t add(uint32_t nowMs, uint32_t delayMs, uint32_t periodMs, const char* command) {
+		auto length = std::strlen(command);
+		if (length == 0 || length >= COMMAND_SIZE) {
+			return NONE;
+		}
+		uint8_t id = 0;
+		while (id < MAX_ENTRIES && entries_[id].used) {
+			++id;
+		}
+		if (id == MAX_ENTRIES) {
+			return NONE;
+		}
+		if (count_ == 0) {
+			// nothing to cascade, the wheel can jump
+			currentMs_ = nowMs;
+		}
+		auto& entry = entries_[id];
+		entry.used = true;
+		entry.deadlineMs = nowMs + delayMs;
+		entry.periodMs = periodMs;
+		entry.fired = 0;
+		std::memcpy(entry.command.data(), command, length + 1);
+		insert(id);
+		++count_;
+		return id;
+	}
+
+	bool cancel(uint8_t id) {
+		if (id >= MAX_ENTRIES || !entries_[id].used) {
+			return false;
+		}
+		unlink(id);
+		entries_[id].used = false;
+		--count_;
+		return true;
+	}
+
+	void clear() {
+		for (uint8_t id = 0; id < MAX_ENTRIES; ++id) {
+			cancel(id);
+		}
+	}
+
+	std::size_t size() const { return count_; }
+	const Entry& entry(uint8_t id) const { return entries_[id]; }
+	bool used(uint8_t id) const { return id < MAX_ENTRIES && entries_[id].used; }
+
+	// Advances the wheel to `nowMs` and calls `fire(id, command)` for every entry due, in deadline order.
+	// `fire` returning false (eg. output full) retries the entry on the next millisecond. `fire` must not add or
+	// cancel entries.
+	template<typename Fire>
+	void run(uint32_t nowMs, Fire&& fire) {
+		if (count_ == 0) {
+			currentMs_ = nowMs;
+			return;
+		}
+		while (static_cast<int32_t>(nowMs - currentMs_) >= 0) {
+			auto index = currentMs_ & ((1u << LEVEL_0_BITS) - 1);
+			if (index == 0) {
+				cascade(1);
+			}
+			auto id = level0_[index];
+			level0_[index] = NONE;
+			while (id != NONE) {
+				auto next = entries_[id].next;
+				expire(id, fire);
+				id = next;
+			}
+			if (count_ == 0) {
+				currentMs_ = nowMs;
+				return;
+			}
+			++currentMs_;
+		}
+	}
+
+private:
+	static constexpr uint32_t shift(std::size_t level) {
+		return level == 0 ? 0 : LEVEL_0_BITS + (level - 1) * LEVEL_BITS;
+	}
+
+	static constexpr uint32_t slotCount(std::size_t level) {
+		return level == 0 ? 1u << LEVEL_0_BITS : 1u << LEVEL_BITS;
+	}
+
+	template<typename Fire>
+	void expire(uint8_t id, Fire& fire) {
+		auto& entry = entries_[id];
+		if (static_cast<int32_t>(entry.deadlineMs - currentMs_) > 0) {
+			// beyond the top level, came around early
+			insert(id);
+			return;
+		}
+		if (!fire(id, entry.command.data())) {
+			entry.deadlineMs = currentMs_ + 1;
+			insert(id);
+			return;
+		}
+		++entry.fired;
+		if (entry.periodMs == 0) {
+			entry.used = false;
+			--count_;
+			return;
+		}
+		entry.deadlineMs += entry.periodMs;
+		if (static_cast<int32_t>(entry.deadlineMs - currentMs_) <= 0) {
+			// fell behind more than a period, skip the missed runs
+			entry.deadlineMs = currentMs_ + 1;
+		}
+		insert(id);
+	}
+
+	// moves entries of the current `level` slot one level down, and the level above first when this one wrapped
+	void cascade(std::size_t level) {
+		if (level >= LEVELS) {
+			return;
+		}
+		auto index = (currentMs_ >> shift(level)) & (slotCount(level) - 1);
+		if (index == 0) {
+			cascade(level + 1);
+		}
+		auto id = head(level, index);
+		head(level, index) = NONE;
+		while (id != NONE) {
+			auto next = entries_[id].next;
+			insert(id);
+			id = next;
+		}
+	}
+
+	uint8_t& head(std::size_t level, uint32_t slot) {
+		return level == 0 ? level0_[slot] : levels_[level - 1][slot];
+	}
+
+	void insert(uint8_t id) {
+		auto& entry = entries_[id];
+		auto delay = static_cast<int32_t>(entry.deadlineMs - currentMs_) > 0 ? entry.deadlineMs - currentMs_ : 0;
+		std::size_t level = 0;
+		while (level + 1 < LEVELS && delay >= (1u << shift(level + 1))) {
+			++level;
+		}
+		auto when = delay > MAX_DELAY_MS ? currentMs_ + MAX_DELAY_MS : currentMs_ + delay;
+		auto slot = (when >> shift(level)) & (slotCount(level) - 1);
+		entry.level = level;
+		entry.slot = slot;
+		entry.prev = NONE;
+		entry.next = head(level, slot);
+		if (entry.next != NONE) {
+			entries_[entry.next].prev = id;
+		}
+		head(level, slot) = id;
+	}
+
+	void unlink(uint8_t id) {
+		auto& entry = entries_[id];
+		if (entry.prev != NONE) {
+			entries_[entry.prev].next = entry.next;
+		} else if (head(entry.level, entry.slot) == id) {
+			head(entry.level, entry.slot) = entry.next;
+		}
+		if (entry.next != NONE) {
+			entries_[entry.next].prev = entry.prev;
+		}
+	}
+
+	std::array<Entry, MAX_ENTRIES> entries_;
+	// first entry of every slot list
+	std::array<uint8_t, 1u << LEVEL_0_BITS> level0_;
+	std::array<std::array<uint8_t, 1u << LEVEL_BITS>, LEVELS - 1> levels_;
+	uint32_t currentMs_;
+	std::size_t count_ = 0;
+};
+
+}
@@ -9,6 +9,9 @@ public:
 	virtual void up() = 0;
 	virtual void enter() = 0;
 	virtual void exit() = 0;
+	// Polled between frames, true when content shown by draw() changed without input (eg. mount moved).
+	// Input always causes redraw.
+	virtual bool changed() { return false; }
 };
 
 }
\ No newline at end of file
@@ -3,7 +3,11 @@
 #include "CoordsUtils.h"
 #include "Dashboard.h"
 #include "ItemsList.h"
+#include "Menu.h"
 #include "Mount.h"
+#include "Sky.h"
+#include "SkyMap.h"
+#include "TrackingErrorPage.h"
 #include "CelestialObjects/Messier/Messier.h"
 #include "CelestialObjects/Stars/Stars.h"
 
@@ -13,263 +17,255 @@
 namespace ui {
 
 using scope::Mount;
+using scope::Sky;
 
-class ScreenUI {
+// Menus are static tables (Menu.h), catalog lists are object indices. Every menu action goes through dispatch().
+class ScreenUI : public ActionDispatcher {
 public:
-	explicit ScreenUI(U8G2& u8g2, Mount& mount) : u8g2_(u8g2), mount_(mount) {}
-
-	void draw() { currentScreen_->draw(); }
-	void up() { currentScreen_->up(); }
-	void down() { currentScreen_->down(); }
-	void enter() { currentScreen_->enter(); }
-	void exit() { currentScreen_->exit(); }
-
-	template<typename Stars, std::size_t... I>
-	ItemsList::Items unpackStarsForTwoStarAlignmentFirstStar_(const Stars& stars, std::index_sequence<I...>) {
-		return ItemsList::Items{
-			{stars[I].name_, [this, &star=stars[I]]() {
-				selectedCelestialObject_ = &star;
-				twoStarAlignmentFirstStarConfirm_.text_ = {std::string("Move to ") + star.name_ + " and", "press OK"};
-				currentScreen_ = &twoStarAlignmentFirstStarConfirm_;
-			}}...
-		};
+	explicit ScreenUI(U8G2& u8g2, Mount& mount, Sky& sky) : u8g2_(u8g2), mount_(mount), sky_(sky) {
+		openMenu(MenuId::MOUNT_TYPE);
 	}
 
-	ItemsList::Items unpackStarsForTwoStarAlignmentFirstStar() {
-		return unpackStarsForTwoStarAlignmentFirstStar_(coords::STARS, std::make_index_sequence<coords::STARS.size()>{});
+	// Frame is drawn after input, when current screen reports changed content or once per HEARTBEAT_MS
+	bool needsRedraw(unsigned long nowMs) {
+		// changed() refreshes cached values of the screen, call it every poll
+		auto changed = currentScreen_->changed();
+		return changed || dirty_ || currentScreen_ != drawnScreen_ || nowMs - drawnMs_ >= HEARTBEAT_MS;
 	}
-
-	template<typename Stars, std::size_t... I>
-	ItemsList::Items unpackStarsForTwoStarAlignmentSecondStar_(const Stars& stars, std::index_sequence<I...>) {
-		return ItemsList::Items{
-			{stars[I].name_, [this, &star=stars[I]]() {
-				selectedCelestialObject_ = &star;
-				twoStarAlignmentSecondStarConfirm_.text_ = {std::string("Move to ") + star.name_ + " and", "press OK"};
-				currentScreen_ = &twoStarAlignmentSecondStarConfirm_;
-			}}...
-		};
+	// next needsRedraw() returns true, eg. when frame could not be sent
+	void invalidate() { dirty_ = true; }
+
+	void draw() {
+		dirty_ = false;
+		drawnScreen_ = currentScreen_;
+		drawnMs_ = millis();
+		currentScreen_->draw();
 	}
-
-	ItemsList::Items unpackStarsForTwoStarAlignmentSecondStar() {
-		return unpackStarsForTwoStarAlignmentSecondStar_(coords::STARS, std::make_index_sequence<coords::STARS.size()>{});
+	void up() { currentScreen_->up(); dirty_ = true; }
+	void down() { currentScreen_->down(); dirty_ = true; }
+	void enter() { currentScreen_->enter(); dirty_ = true; }
+	void exit() { currentScreen_->exit(); dirty_ = true; }
+
+	void dispatch(Action action, uint16_t arg) override {
+		switch (action) {
+			case Action::NONE:
+				break;
+			case Action::OPEN_MENU:
+				openMenu(static_cast<MenuId>(arg));
+				break;
+			case Action::OPEN_DASHBOARD:
+				currentScreen_ = &dashboard_;
+				break;
+			case Action::OPEN_SKY_MAP:
+				currentScreen_ = &skyMap_;
+				break;
+			case Action::OPEN_TRACKING_ERROR:
+				currentScreen_ = &trackingErrorPage_;
+				break;
+			case Action::BACK_TO_LIST:
+				currentScreen_ = &catalogList_;
+				break;
+			case Action::MOUNT_EQ:
+				mount_.setMountType(Mount::MountType::EQ);
+				openMenu(MenuId::OPERATION_MODE, "EQ Operation mode");
+				break;
+			case Action::MOUNT_AZ:
+				mount_.setMountType(Mount::MountType::AZ);
+				openMenu(MenuId::OPERATION_MODE, "AZ Operation mode");
+				break;
+			case Action::EASY_TRACK_POLE:
+				openMenu(mount_.state().mountType == Mount::MountType::EQ ? MenuId::POLE_ALIGNMENT_EQ : MenuId::POLE_ALIGNMENT_AZ);
+				break;
+			case Action::EASY_TRACK_TWO_STAR:
+				if (mount_.state().mountType == Mount::MountType::EQ) {
+					openMenu(MenuId::POLE_ALIGNMENT_THEN_TWO_STAR_EQ);
+				} else {
+					showRecommendedFirstStars();
+				}
+				break;
+			case Action::POLE_ALIGNMENT_OK:
+				mount_.alignPole();
+				openMenu(MenuId::ALIGNMENT_FINISHED, MENUS[ui::arg(MenuId::POLE_ALIGNMENT_EQ)].title);
+				break;
+			case Action::POLE_ALIGNMENT_THEN_TWO_STAR_OK:
+				mount_.alignPole();
+				showRecommendedFirstStars();
+				break;
+			case Action::POLE_ALIGNMENT_AZ_OK:
+				mount_.alignPole();
+				openMenu(MenuId::ALIGNMENT_FINISHED, MENUS[ui::arg(MenuId::POLE_ALIGNMENT_AZ)].title);
+				break;
+			case Action::POLE_ALIGNMENT_TEST:
+			case Action::POLE_ALIGNMENT_HOME:
+				mount_.moveToXDeg(action == Action::POLE_ALIGNMENT_TEST ? -180 : 0, 600);
+				break;
+			case Action::SELECT_FIRST_STAR:
+			case Action::SELECT_SECOND_STAR:
+				selectedObject_ = {&coords::STARS, arg};
+				snprintf(text_[0].data(), text_[0].size(), "Move to %s and", selectedObject_.name());
+				openMenu(action == Action::SELECT_FIRST_STAR ? MenuId::FIRST_STAR_CONFIRM : MenuId::SECOND_STAR_CONFIRM,
+					nullptr, {text_[0].data(), "press OK"});
+				break;
+			case Action::FIRST_STAR_OK:
+				mount_.setTwoStarAlignmentFirstStar({selectedObject_.raRad(), selectedObject_.decRad()});
+				showRecommendedSecondStars();
+				break;
+			case Action::SECOND_STAR_OK:
+				mount_.setTwoStarAlignmentSecondStar({selectedObject_.raRad(), selectedObject_.decRad()});
+				openMenu(MenuId::ALIGNMENT_FINISHED);
+				break;
+			case Action::GOTO_STARS:
+				showVisibleObjects("GOTO Stars", 0, sky_.starsVisibility_);
+				break;
+			case Action::GOTO_MESSIER:
+				showVisibleObjects("GOTO Messier", coords::STARS.size(), sky_.messierVisibility_);
+				break;
+			case Action::TRANSITS_NEXT:
+				showPlannerItems(false);
+				break;
+			case Action::BEST_NOW:
+				showPlannerItems(true);
+				break;
+			case Action::TOGGLE_VISIBLE_ONLY:
+				visibleOnly_ = !visibleOnly_;
+				break;
+			case Action::SELECT_GOTO_OBJECT:
+				selectedObject_ = Sky::object(arg);
+				snprintf(text_[0].data(), text_[0].size(), "%s", selectedObject_.name());
+				formatLabelled(text_[1], "RA ", selectedObject_.ra());
+				formatLabelled(text_[2], "Dec ", selectedObject_.dec());
+				openMenu(MenuId::GOTO_CONFIRM, nullptr, {text_[0].data(), text_[1].data(), text_[2].data()});
+				break;
+			case Action::GOTO_OK:
+				mount_.moveToRADec({selectedObject_.raRad(), selectedObject_.decRad()}, 400);
+				currentScreen_ = &dashboard_;
+				break;
+		}
 	}
 
-	template<typename Stars, std::size_t... I>
-	ItemsList::Items unpackStarsForGoTo_(const Stars& stars, std::index_sequence<I...>) {
-		return ItemsList::Items{
-			{stars[I].name_, [this, &star=stars[I]]() {
-				selectedCelestialObject_ = &star;
-				gotoObjectConfirm_.text_ = {
-					std::string(star.name_),
-					std::string("RA ").append(star.ra_.str()),
-					std::string("Dec ").append(star.dec_.str())
-				};
-				gotoObjectConfirm_.exitHandler_ = [this]() { currentScreen_ = &gotoStars_; };
-				currentScreen_ = &gotoObjectConfirm_;
-			}}...
-		};
+	const char* label(Action action) const override {
+		if (action == Action::TOGGLE_VISIBLE_ONLY) {
+			return visibleOnly_ ? "Show: visible" : "Show: all";
+		}
+		return "";
 	}
 
-	ItemsList::Items unpackStarsForGoTo() {
-		return unpackStarsForGoTo_(coords::STARS, std::make_index_sequence<coords::STARS.size()>{});
+	// `title` and `text` override the ones from MENUS
+	void openMenu(MenuId id, const char* title = nullptr, const ItemsList::Text& text = {}) {
+		menuList_.open(id);
+		if (title != nullptr || text[0] != nullptr) {
+			menuList_.reset(title != nullptr ? title : menuList_.title_, text[0] != nullptr ? text : menuList_.text_);
+		}
+		currentScreen_ = &menuList_;
 	}
 
-	template<typename Messiers, std::size_t... I>
-	ItemsList::Items unpackMessierForGoTo_(const Messiers& messiers, std::index_sequence<I...>) {
-		return ItemsList::Items{
-			{messiers[I].name_, [this, &messier=messiers[I]]() {
-				selectedCelestialObject_ = &messier;
-				gotoObjectConfirm_.text_ = {
-					std::string(messier.name_),
-					std::string("RA ").append(messier.ra_.str()),
-					std::string("Dec ").append(messier.dec_.str())
-				};
-				gotoObjectConfirm_.exitHandler_ = [this]() { currentScreen_ = &gotoMessier_; };
-				currentScreen_ = &gotoObjectConfirm_;
-			}}...
-		};
+	// `label` is short, coordinates are formatted right after it, truncated to the line
+	template<std::size_t N, typename Coords>
+	static void formatLabelled(std::array<char, N>& line, const char* label, const Coords& coords) {
+		auto length = std::min<std::size_t>(snprintf(line.data(), line.size(), "%s", label), line.size() - 1);
+		coords.format(line.data() + length, line.size() - length);
 	}
 
-	ItemsList::Items unpackMessierForGoTo() {
-		return unpackMessierForGoTo_(coords::MESSIER, std::make_index_sequence<coords::MESSIER.size()>{});
+	// `first` is Sky index of the first catalog object, `visibility` indices are relative to it
+	template<typename Visibility>
+	void showVisibleObjects(const char* title, std::size_t first, const Visibility& visibility) {
+		auto filter = visibleOnly_ && sky_.ready() && visibility.ready();
+		catalogList_.open(title, {}, Action::SELECT_GOTO_OBJECT, {nullptr, Action::OPEN_MENU, ui::arg(MenuId::GOTO_OBJECTS)}, "Nothing visible");
+		for (std::size_t i = 0; i < visibility.size(); ++i) {
+			if (!filter || visibility.visible(i)) {
+				catalogList_.add(first + i);
+			}
+		}
+		currentScreen_ = &catalogList_;
 	}
 
-	U8G2& u8g2_;
-	Mount& mount_;
-
-	ItemsList mountType_{u8g2_, "Mount type", {}, {
-			{"EQ", [this]() {
-				mount_.mountType_ = Mount::MountType::EQ;
-				operationMode_.title_ = "EQ Operation mode";
-				currentScreen_ = &operationMode_;
-			}},
-			{"AZ", [this]() {
-				mount_.mountType_ = Mount::MountType::AZ;
-				operationMode_.title_ = "AZ Operation mode";
-				currentScreen_ = &operationMode_;
-			}}
+	// `byBestNow` selects "best now" ordering, otherwise "transits next"
+	void showPlannerItems(bool byBestNow) {
+		auto title = byBestNow ? "Best now" : "Transits next";
+		MenuItem exit = {nullptr, Action::OPEN_MENU, ui::arg(MenuId::GOTO_OBJECTS)};
+		currentScreen_ = &catalogList_;
+		double now = 0;
+		if (!sky_.riseSetTable_.ready() || !mount_.getTimeOfDaySeconds(now)) {
+			catalogList_.open(title, {}, Action::SELECT_GOTO_OBJECT, exit, "Set site and time");
+			return;
 		}
-	};
-
-	ItemsList operationMode_{u8g2_, "Operation mode", {}, {
-			// Full operation mode features:
-			// - goto rightascension and declination coords
-			// - planets and moon tracking
-			// - manual control
-			// Requires:
-			// - date, time, location
-			// Alignment:
-			// - 2 star
-			// - 3 star
-			{"Full", [this]() {}},
-			// Easy track operation mode features:
-			// - compensate earth rotation
-			// - switch on/off
-			// - manual control
-			// Requires:
-			// - nothing but alignment
-			// Alignment:
-			// - pole
-			// - 2 star
-			{"Easy track", [this]() { currentScreen_ = &easyTrackAlignment_; }}
-		}, [this]() { currentScreen_ = &mountType_; }
-	};
+		catalogList_.open(title, {}, Action::SELECT_GOTO_OBJECT, exit, "Nothing above min alt");
+		std::array<uint16_t, PLANNER_LIST_SIZE> indices;
+		const auto& table = sky_.riseSetTable_;
+		auto count = byBestNow ? table.bestNow(now, indices) : table.transitsNext(now, indices);
+		for (std::size_t i = 0; i < count; ++i) {
+			auto seconds = byBestNow ? table.secondsFromTransit(indices[i], now) : table.secondsToNextTransit(indices[i], now);
+			auto minutes = static_cast<int>(std::fabs(seconds) / 60);
+			snprintf(catalogList_.addLabelled(indices[i]), CatalogList::LABEL_SIZE, "%c%dh%02d %s",
+				seconds < 0 ? '-' : '+', minutes / 60, minutes % 60, Sky::object(indices[i]).name());
+		}
+	}
 
-	ItemsList easyTrackAlignment_{u8g2_, "Easy track alignment", {}, {
-			{"pole", [this]() {
-				if (mount_.mountType_ == Mount::MountType::EQ) {
-					currentScreen_ = &onlyPoleAlignmentEQ_;
-				} else {
-					currentScreen_ = &poleAlignment_;
+	// Recommended stars go first, marked with '*', then all stars alphabetically
+	void showRecommendedFirstStars() {
+		std::array<uint16_t, RECOMMENDED_STARS> stars;
+		std::size_t count = 0;
+		if (sky_.updateAlignmentRecommendation()) {
+			const auto& recommender = sky_.alignmentRecommender_;
+			for (std::size_t i = 0; i < recommender.pairCount() && count < RECOMMENDED_STARS; ++i) {
+				for (auto star : {recommender.pair(i).first, recommender.pair(i).second}) {
+					if (count < RECOMMENDED_STARS && std::find(stars.begin(), stars.begin() + count, star) == stars.begin() + count) {
+						stars[count++] = star;
+					}
 				}
-			}},
-			{"2 star", [this]() {
-				if (mount_.mountType_ == Mount::MountType::EQ) {
-					currentScreen_ = &poleAlignmentThenTwoStarEQ_;
-				} else {
-					currentScreen_ = &twoStarAlignmentFirstStar_;
-				}
-			}}
-		}, [this]() { currentScreen_ = &operationMode_; }
-	};
-
-	ItemsList onlyPoleAlignmentEQ_{u8g2_, "EQ - Pole alignment", {"Move to north pole", "and press OK"}, {
-			{"OK", [this]() {
-				currentScreen_ = &alignmentFinished_;
-				mount_.setAutoTrackPivot();
-				mount_.operationMode_ = Mount::EASY_TRACK;
-			}},
-			{"Test", [this]() {
-				mount_.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO;
-				auto currentPosition = mount_.currentPositionDeg();
-				mount_.safeMoveToPositionDeg({-180, currentPosition.second}, 600);
-			}},
-			{"Home", [this]() {
-				mount_.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO;
-				auto currentPosition = mount_.currentPositionDeg();
-				mount_.safeMoveToPositionDeg({0, currentPosition.second}, 600);
-			}}
-		}, [this]() { currentScreen_ = &easyTrackAlignment_; }
-	};
-
-	ItemsList poleAlignmentThenTwoStarEQ_{u8g2_, "EQ 2S- Pole alignment", {"Move to north pole", "and press OK"}, {
-			{"OK", [this]() {
-				currentScreen_ = &twoStarAlignmentFirstStar_;
-				mount_.setAutoTrackPivot();
-				mount_.operationMode_ = Mount::EASY_TRACK;
-			}},
-			{"Test", [this]() {
-				mount_.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO;
-				auto currentPosition = mount_.currentPositionDeg();
-				mount_.safeMoveToPositionDeg({-180, currentPosition.second}, 600);
-			}},
-			{"Home", [this]() {
-				mount_.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO;
-				auto currentPosition = mount_.currentPositionDeg();
-				mount_.safeMoveToPositionDeg({0, currentPosition.second}, 600);
-			}}
-		}, [this]() { currentScreen_ = &easyTrackAlignment_; }
-	};
-
-	ItemsList poleAlignment_{u8g2_, "AZ - Pole alignment", {"Move to north pole", "and press OK"}, {
-			{"OK", [this]() {
-				alignmentFinished_.title_ = poleAlignment_.title_;
-				currentScreen_ = &alignmentFinished_;
-				mount_.setAutoTrackPivot();
-				mount_.operationMode_ = Mount::EASY_TRACK;
-			}}
-		}, [this]() { currentScreen_ = &easyTrackAlignment_; }
-	};
-
-	const coords::CelestialObjectBase* selectedCelestialObject_ = &coords::STARS[static_cast<unsigned int>(coords::Star::Altair)];
-
-	ItemsList twoStarAlignmentFirstStar_{u8g2_, "2S alignment 1/2", {"Choose first star:"}, {
-			unpackStarsForTwoStarAlignmentFirstStar()
-		}, [this]() { currentScreen_ = &easyTrackAlignment_; }
-	};
-
-	ItemsList twoStarAlignmentFirstStarConfirm_{u8g2_, "2S alignment 1/2", {}, {
-			{"OK", [this]() {
-					mount_.setTwoStarAlignmentFirstStar({selectedCelestialObject_->ra_.rad(), selectedCelestialObject_->dec_.rad()});
-					currentScreen_ = &twoStarAlignmentSecondStar_;
-			}},
-		}, [this]() { currentScreen_ = &twoStarAlignmentFirstStar_; }
-	};
-
-	ItemsList twoStarAlignmentSecondStar_{u8g2_, "2S alignment 2/2", {"Choose second star:"}, {
-			unpackStarsForTwoStarAlignmentSecondStar()
-		}, [this]() { currentScreen_ = &easyTrackAlignment_; }
-	};
+			}
+		}
+		showStars("2S alignment 1/2", "Choose first star:", Action::SELECT_FIRST_STAR, stars, count);
+	}
 
-	ItemsList twoStarAlignmentSecondStarConfirm_{u8g2_, "2S alignment 2/2", {}, {
-			{"OK", [this]() {
-					mount_.setTwoStarAlignmentSecondStar({selectedCelestialObject_->ra_.rad(), selectedCelestialObject_->dec_.rad()});
-					mount_.operationMode_ = Mount::EASY_TRACK_GOTO;
-					currentScreen_ = &alignmentFinished_;
-			}}
-		}, [this]() { currentScreen_ = &twoStarAlignmentSecondStar_; }
-	};
+	void showRecommendedSecondStars() {
+		std::array<uint16_t, RECOMMENDED_STARS> stars;
+		std::size_t count = 0;
+		if (sky_.updateAlignmentRecommendation()) {
+			count = sky_.alignmentRecommender_.bestPartners(selectedObject_.index_, stars);
+		}
+		showStars("2S alignment 2/2", "Choose second star:", Action::SELECT_SECOND_STAR, stars, count);
+	}
 
-	ItemsList alignmentFinished_{u8g2_, "", {"Alignment finished!"}, {
-			{"OK", [this]() { currentScreen_ = &dashboard_; }}
+	template<typename Stars>
+	void showStars(const char* title, const char* text, Action action, const Stars& recommended, std::size_t count) {
+		catalogList_.open(title, {text}, action, {nullptr, Action::OPEN_MENU, ui::arg(MenuId::EASY_TRACK_ALIGNMENT)}, "");
+		for (std::size_t i = 0; i < count; ++i) {
+			snprintf(catalogList_.addLabelled(recommended[i]), CatalogList::LABEL_SIZE, "* %s", coords::STARS.name(recommended[i]));
 		}
-	};
+		for (std::size_t i = 0; i < coords::STARS.size(); ++i) {
+			catalogList_.add(i);
+		}
+		currentScreen_ = &catalogList_;
+	}
 
-	Dashboard dashboard_{u8g2_, mount_,
-			[this]() { currentScreen_ = &gotoObjects_; }
-	};
+	static constexpr const std::size_t PLANNER_LIST_SIZE = 20;
+	static constexpr const std::size_t RECOMMENDED_STARS = 5;
+	static constexpr const unsigned long HEARTBEAT_MS = 1000;
+	static constexpr const std::size_t TEXT_SIZE = 24;
 
-	ItemsList gotoObjects_{u8g2_, "GOTO Objects", {}, {
-			{"Stars", [this]() { currentScreen_ = &gotoStars_; }},
-			{"Messier", [this]() {currentScreen_ = &gotoMessier_; }},
-			{"NGC", []() {}},
-			{"Manual", []() {}},
-		}, [this]() { currentScreen_ = &dashboard_; }
-	};
+	using CatalogList = ui::CatalogList<Sky::OBJECTS_COUNT + RECOMMENDED_STARS, PLANNER_LIST_SIZE, decltype(&Sky::object)>;
 
-	ItemsList gotoStars_{u8g2_, "GOTO Stars", {}, {
-			unpackStarsForGoTo()
-		}, [this]() { currentScreen_ = &gotoObjects_; }
-	};
+	U8G2& u8g2_;
+	Mount& mount_;
+	Sky& sky_;
+	bool visibleOnly_ = true;
 
-	ItemsList gotoMessier_{u8g2_, "GOTO Messier", {}, {
-			unpackMessierForGoTo()
-		}, [this] () { currentScreen_ = &gotoObjects_; }
-	};
+	coords::CatalogObject selectedObject_ = {&coords::STARS, static_cast<std::size_t>(coords::Star::Altair)};
+	// confirm screens text
+	std::array<std::array<char, TEXT_SIZE>, Menu::MAX_TEXT_LINES> text_;
 
-	ItemsList gotoObjectConfirm_{u8g2_, "GOTO Object", {}, {
-			{"OK", [this]() {
-				mount_.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO;
-				mount_.safeMoveToPositionRADec({selectedCelestialObject_->ra_.rad(), selectedCelestialObject_->dec_.rad()}, 400);
-				currentScreen_ = &dashboard_;
-				previousScreen_ = nullptr;
-			}},
-			{"Cancel", [this]() { /*currentScreen_ = previousScreen_;*/ }}
-		}, [this]() { /*currentScreen_ = previousScreen_;*/ }
-	};
+	MenuList menuList_{u8g2_, *this};
+	CatalogList catalogList_{u8g2_, *this, &Sky::object};
+	Dashboard dashboard_{u8g2_, mount_, sky_, *this};
+	SkyMap skyMap_{u8g2_, mount_, sky_, *this};
+	TrackingErrorPage trackingErrorPage_{u8g2_, mount_, *this};
+
+	ScreenItem* currentScreen_ = &menuList_;
 
-	ScreenItem* currentScreen_ = &mountType_;
-	ScreenItem* previousScreen_ = nullptr;
+	bool dirty_ = true;
+	const ScreenItem* drawnScreen_ = nullptr;
+	unsigned long drawnMs_ = 0;
 };
 
-}
\ No newline at end of file
+}
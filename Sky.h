@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoordsUtils.h"
+#include "AlignmentStarRecommender.h"
+#include "Mount.h"
+#include "RiseSetTable.h"
+#include "SkyIndex.h"
+#include "Visibility.h"
+#include "CelestialObjects/Messier/Messier.h"
+#include "CelestialObjects/Stars/Stars.h"
+
+#include <cmath>
+
+namespace scope {
+
+// Catalog state that depends on site and time (what is above the horizon now).
+class Sky {
+public:
+	static constexpr const double VISIBILITY_REFRESH_INTERVAL_S = 180;
+	// stars first, then Messier objects
+	static constexpr const std::size_t OBJECTS_COUNT = coords::STARS.size() + coords::MESSIER.size();
+	using RiseSetTable = coords::RiseSetTable<OBJECTS_COUNT>;
+	static constexpr const std::size_t NEAREST_COUNT = 2;
+	static constexpr const double NEAREST_REQUERY_DEG = 0.25;
+
+	explicit Sky(const Mount& mount) : mount_(mount) {}
+
+	bool ready() const {
+		return mount_.siteSet_ && mount_.clockSet();
+	}
+
+	// call with short interval eg. 100ms, work done per call is bounded
+	void tick() {
+		if (!ready()) {
+			return;
+		}
+		double now = 0;
+		if (!mount_.getTimeOfDaySeconds(now)) {
+			return;
+		}
+
+		auto refreshing = starsVisibility_.refreshing() || messierVisibility_.refreshing();
+		auto siteChanged = mount_.site_.latitude != visibilitySite_.latitude || mount_.site_.longitude != visibilitySite_.longitude;
+		auto due = std::fabs(now - visibilityTimestamp_) >= VISIBILITY_REFRESH_INTERVAL_S
+			|| horizonMask_.version() != visibilityMaskVersion_ || siteChanged;
+		if (due && !refreshing) {
+			visibilityTimestamp_ = now;
+			visibilitySite_ = mount_.site_;
+			visibilityMaskVersion_ = horizonMask_.version();
+			starsVisibility_.beginRefresh(visibilitySite_, now);
+			messierVisibility_.beginRefresh(visibilitySite_, now);
+		}
+
+		starsVisibility_.tick(horizonMask_);
+		messierVisibility_.tick(horizonMask_);
+
+		auto night = RiseSetTable::nightNumber(now, mount_.site_.longitude);
+		auto riseSetSite = riseSetTable_.site();
+		auto riseSetStale = !riseSetTable_.ready() || night != riseSetTable_.night()
+			|| mount_.site_.latitude != riseSetSite.latitude || mount_.site_.longitude != riseSetSite.longitude
+			|| minAltitudeDeg_ * DEG_TO_RAD != riseSetTable_.minAltitudeRad();
+		if (riseSetStale && !riseSetTable_.rebuilding()) {
+			riseSetTable_.beginRebuild(mount_.site_, now, minAltitudeDeg_ * DEG_TO_RAD);
+		}
+		riseSetTable_.tick(&Sky::object);
+	}
+
+	// Nearest objects to current mount pointing. Index is queried again only when pointing moved more than
+	// NEAREST_REQUERY_DEG. Returns number of objects in `nearest_`, 0 when mount is not star aligned.
+	std::size_t updateNearest() {
+		std::pair<double, double> position;
+		if (!mount_.state().positionRADec(position)) {
+			nearestCount_ = 0;
+			return 0;
+		}
+		auto pointing = coords::unitVectorFromRADec(position.first, position.second);
+		auto cosMoved = pointing[0] * nearestQuery_[0] + pointing[1] * nearestQuery_[1] + pointing[2] * nearestQuery_[2];
+		if (nearestCount_ > 0 && cosMoved >= std::cos(NEAREST_REQUERY_DEG * DEG_TO_RAD)) {
+			return nearestCount_;
+		}
+		nearestQuery_ = pointing;
+		nearestCount_ = skyIndex_.nearest(pointing, nearest_);
+		return nearestCount_;
+	}
+
+	// Scores alignment star pairs for current time, returns false when site or time is not set
+	bool updateAlignmentRecommendation() {
+		double now = 0;
+		if (!ready() || !mount_.getTimeOfDaySeconds(now)) {
+			return false;
+		}
+		alignmentRecommender_.update(mount_.site_, now, horizonMask_);
+		return true;
+	}
+
+	// index in range of OBJECTS_COUNT
+	static coords::CatalogObject object(std::size_t i) {
+		if (i < coords::STARS.size()) {
+			return {&coords::STARS, i};
+		}
+		return {&coords::MESSIER, i - coords::STARS.size()};
+	}
+
+	const Mount& mount_;
+	coords::HorizonMask horizonMask_;
+	coords::VisibilityFilter<coords::STARS.size()> starsVisibility_{coords::STARS};
+	coords::VisibilityFilter<coords::MESSIER.size()> messierVisibility_{coords::MESSIER};
+
+	coords::SkyIndex<OBJECTS_COUNT> skyIndex_{&Sky::object};
+	std::array<coords::Neighbour, NEAREST_COUNT> nearest_;
+	std::size_t nearestCount_ = 0;
+	std::array<float, 3> nearestQuery_ = {0, 0, 0};
+
+	coords::AlignmentStarRecommender alignmentRecommender_;
+
+	RiseSetTable riseSetTable_;
+	double minAltitudeDeg_ = 20;
+
+	double visibilityTimestamp_ = 0;
+	coords::Site visibilitySite_ = {0, 0};
+	uint32_t visibilityMaskVersion_ = 0;
+};
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoordsUtils.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace coords {
+
+struct Neighbour {
+	uint16_t index;
+	float distanceRad;
+};
+
+// Cell grid over the celestial sphere: declination bands of `BAND_HEIGHT_DEG`, each split in RA cells of
+// roughly the same width on the sky. Objects are stored sorted by cell (unit vectors in structure of arrays)
+// so a query only scans the few cells around the point.
+template<std::size_t N>
+class SkyIndex {
+public:
+	static constexpr const int BAND_HEIGHT_DEG = 10;
+	static constexpr const int BANDS = 180 / BAND_HEIGHT_DEG;
+
+	// `objectAt(i)` returns CatalogObject
+	template<typename ObjectAt>
+	explicit SkyIndex(ObjectAt objectAt) {
+		std::size_t cells = 0;
+		for (int band = 0; band < BANDS; ++band) {
+			bandFirstCell_[band] = cells;
+			auto widestDec = std::min(std::fabs(bandDecRad(band)), std::fabs(bandDecRad(band + 1)));
+			bandCells_[band] = std::max(1, static_cast<int>(std::lround(360.0 / BAND_HEIGHT_DEG * std::cos(widestDec))));
+			cells += bandCells_[band];
+		}
+		bandFirstCell_[BANDS] = cells;
+
+		std::array<uint16_t, N> objectCell;
+		std::array<uint16_t, MAX_CELLS + 1> cellCount{};
+		for (std::size_t i = 0; i < N; ++i) {
+			const auto& object = objectAt(i);
+			objectCell[i] = cellOf(object.raRad(), object.decRad());
+			++cellCount[objectCell[i] + 1];
+		}
+		// counting sort by cell
+		for (std::size_t cell = 0; cell < MAX_CELLS; ++cell) {
+			cellCount[cell + 1] += cellCount[cell];
+		}
+		cellStart_ = cellCount;
+		for (std::size_t i = 0; i < N; ++i) {
+			auto slot = cellCount[objectCell[i]]++;
+			auto vector = objectAt(i).vector();
+			x_[slot] = vector[0];
+			y_[slot] = vector[1];
+			z_[slot] = vector[2];
+			index_[slot] = i;
+		}
+	}
+
+	// Calls `fn(index, cosDistance)` for every object within `radiusRad` from `center`
+	template<typename Fn>
+	void forEachWithin(const std::array<float, 3>& center, float radiusRad, Fn fn) const {
+		auto cosRadius = std::cos(radiusRad);
+		auto dec = std::asin(std::max(-1.0f, std::min(1.0f, center[2])));
+		auto ra = std::atan2(center[1], center[0]);
+
+		auto firstBand = bandOf(dec - radiusRad);
+		auto lastBand = bandOf(dec + radiusRad);
+		for (auto band = firstBand; band <= lastBand; ++band) {
+			auto cells = bandCells_[band];
+			// RA span of the cap is the widest at the band edge closer to the pole
+			auto poleDec = std::max(std::fabs(bandDecRad(band)), std::fabs(bandDecRad(band + 1)));
+			auto sinRadius = std::sin(radiusRad);
+			auto cosPoleDec = std::cos(poleDec);
+			int firstCell = 0;
+			int lastCell = cells - 1;
+			if (radiusRad < HALF_PI && sinRadius < cosPoleDec) {
+				auto halfSpan = std::asin(sinRadius / cosPoleDec);
+				firstCell = static_cast<int>(std::floor((ra - halfSpan) / TWO_PI * cells));
+				lastCell = static_cast<int>(std::floor((ra + halfSpan) / TWO_PI * cells));
+				lastCell = std::min(lastCell, firstCell + cells - 1);
+			}
+			for (auto cell = firstCell; cell <= lastCell; ++cell) {
+				auto wrapped = (cell % cells + cells) % cells;
+				scanCell(bandFirstCell_[band] + wrapped, center, cosRadius, fn);
+			}
+		}
+	}
+
+	// k nearest objects to `center`, sorted by distance; returns number of written neighbours
+	template<std::size_t K>
+	std::size_t nearest(const std::array<float, 3>& center, std::array<Neighbour, K>& result) const {
+		auto count = std::min(K, N);
+		for (float radius = BAND_HEIGHT_DEG * DEG_TO_RAD; ; radius = std::min(radius * 2, static_cast<float>(PI))) {
+			std::size_t found = 0;
+			// result is kept sorted by distance, insertion sort is fine for small K
+			forEachWithin(center, radius, [&](uint16_t index, float cosDistance) {
+				auto distance = std::acos(std::min(1.0f, cosDistance));
+				if (found == count && distance >= result[count - 1].distanceRad) {
+					return;
+				}
+				std::size_t slot = found < count ? found++ : count - 1;
+				while (slot > 0 && result[slot - 1].distanceRad > distance) {
+					result[slot] = result[slot - 1];
+					--slot;
+				}
+				result[slot] = {index, distance};
+			});
+			if (found == count || radius >= static_cast<float>(PI)) {
+				return found;
+			}
+		}
+	}
+
+private:
+	static constexpr const std::size_t MAX_CELLS = 360 / BAND_HEIGHT_DEG * BANDS;
+
+	static double bandDecRad(int band) {
+		return (band * BAND_HEIGHT_DEG - 90) * DEG_TO_RAD;
+	}
+
+	static int bandOf(double decRad) {
+		auto band = static_cast<int>(std::floor((decRad * RAD_TO_DEG + 90) / BAND_HEIGHT_DEG));
+		return std::max(0, std::min(BANDS - 1, band));
+	}
+
+	uint16_t cellOf(double raRad, double decRad) const {
+		auto band = bandOf(decRad);
+		auto cells = bandCells_[band];
+		auto cell = static_cast<int>(std::floor(raRad / TWO_PI * cells));
+		return bandFirstCell_[band] + (cell % cells + cells) % cells;
+	}
+
+	template<typename Fn>
+	void scanCell(std::size_t cell, const std::array<float, 3>& center, float cosRadius, Fn& fn) const {
+		for (auto slot = cellStart_[cell]; slot < cellStart_[cell + 1]; ++slot) {
+			auto cosDistance = center[0] * x_[slot] + center[1] * y_[slot] + center[2] * z_[slot];
+			if (cosDistance >= cosRadius) {
+				fn(index_[slot], cosDistance);
+			}
+		}
+	}
+
+	std::array<uint16_t, BANDS + 1> bandFirstCell_;
+	std::array<int, BANDS> bandCells_;
+	std::array<uint16_t, MAX_CELLS + 1> cellStart_;
+	std::array<float, N> x_;
+	std::array<float, N> y_;
+	std::array<float, N> z_;
+	std::array<uint16_t, N> index_;
+};
+
+}
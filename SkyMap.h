@@ -0,0 +1,219 @@
+#pragma once
+
+#include "CoordsUtils.h"
+#include "Menu.h"
+#include "Mount.h"
+#include "ScreenItemIfc.h"
+#include "Sky.h"
+
+#include <U8g2lib.h>
+
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace ui {
+
+using scope::Mount;
+using scope::Sky;
+
+// Gnomonic (tangent plane) projection of the catalog around current pointing, north up, east left as seen
+// on the sky. Projected points are cached and computed again only when pointing moved by more than
+// REPROJECT_PIXELS or field of view changed, so a frame is mostly a few hundred pixel writes.
+// up/down changes field of view.
+class SkyMap : public ScreenItem {
+public:
+	static constexpr const std::size_t FOV_LEVELS = 4;
+	// horizontal field of view
+	static constexpr const std::array<float, FOV_LEVELS> FOV_DEG = {10, 20, 40, 80};
+	static constexpr const float REPROJECT_PIXELS = 0.5f;
+	static constexpr const int WIDTH = 128;
+	static constexpr const int HEIGHT = 64;
+
+	SkyMap(U8G2& u8g2, const Mount& mount, Sky& sky, ActionDispatcher& dispatcher)
+		: u8g2_(u8g2), mount_(mount), sky_(sky), dispatcher_(dispatcher) {}
+
+	void draw() override {
+		u8g2_.setFont(u8g2_font_profont11_tf);
+		u8g2_.setFontMode(1);
+		u8g2_.setDrawColor(1);
+
+		auto state = mount_.state();
+		std::pair<double, double> position;
+		if (!state.positionRADec(position)) {
+			u8g2_.drawStr(1, 10, "SKY MAP");
+			u8g2_.drawStr(1, 30, "Star alignment");
+			u8g2_.drawStr(1, 40, "required");
+			pointCount_ = 0;
+			cacheValid_ = false;
+			return;
+		}
+
+		auto pointing = coords::unitVectorFromRADec(position.first, position.second);
+		auto cosMoved = dot(pointing, center_);
+		if (!cacheValid_ || cosMoved < cosReprojectAngle_) {
+			project(pointing);
+		}
+
+		for (std::size_t i = 0; i < pointCount_; ++i) {
+			const auto& point = points_[i];
+			switch (point.symbol) {
+				case Symbol::BRIGHT_STAR:
+					u8g2_.drawDisc(point.x, point.y, 1);
+					break;
+				case Symbol::STAR:
+					u8g2_.drawPixel(point.x, point.y);
+					break;
+				case Symbol::DEEP_SKY:
+					u8g2_.drawCircle(point.x, point.y, 2);
+					break;
+			}
+		}
+
+		// pointing
+		u8g2_.drawHLine(WIDTH / 2 - 2, HEIGHT / 2, 5);
+		u8g2_.drawVLine(WIDTH / 2, HEIGHT / 2 - 2, 5);
+
+		targetSet_ = state.gotoTargetSet;
+		target_ = state.gotoTargetRADec;
+		if (targetSet_) {
+			drawTarget(coords::unitVectorFromRADec(target_.first, target_.second));
+		}
+
+		char s[8];
+		snprintf(s, sizeof(s), "%d", static_cast<int>(FOV_DEG[fovLevel_]));
+		u8g2_.drawStr(1, 10, s);
+	}
+	void down() override {
+		if (fovLevel_ < FOV_LEVELS - 1) {
+			++fovLevel_;
+			cacheValid_ = false;
+		}
+	}
+	void up() override {
+		if (fovLevel_ > 0) {
+			--fovLevel_;
+			cacheValid_ = false;
+		}
+	}
+	void enter() override {}
+	void exit() override { dispatcher_.dispatch(Action::OPEN_DASHBOARD, 0); }
+	bool changed() override {
+		auto state = mount_.state();
+		std::pair<double, double> position;
+		if (!state.positionRADec(position)) {
+			return cacheValid_;
+		}
+		auto pointing = coords::unitVectorFromRADec(position.first, position.second);
+		return !cacheValid_ || dot(pointing, center_) < cosReprojectAngle_
+			|| state.gotoTargetSet != targetSet_ || state.gotoTargetRADec != target_;
+	}
+
+private:
+	enum class Symbol : uint8_t {
+		BRIGHT_STAR,
+		STAR,
+		DEEP_SKY,
+	};
+
+	struct Point {
+		int16_t x;
+		int16_t y;
+		Symbol symbol;
+	};
+
+	static float dot(const std::array<float, 3>& a, const std::array<float, 3>& b) {
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	void project(const std::array<float, 3>& pointing) {
+		center_ = pointing;
+		// tangent plane basis, degenerates only exactly at the poles
+		auto eastNorm = std::sqrt(center_[0] * center_[0] + center_[1] * center_[1]);
+		if (eastNorm < 1e-6f) {
+			east_ = {0, 1, 0};
+		} else {
+			east_ = {-center_[1] / eastNorm, center_[0] / eastNorm, 0};
+		}
+		north_ = {
+			center_[1] * east_[2] - center_[2] * east_[1],
+			center_[2] * east_[0] - center_[0] * east_[2],
+			center_[0] * east_[1] - center_[1] * east_[0]
+		};
+
+		auto halfFov = FOV_DEG[fovLevel_] * static_cast<float>(DEG_TO_RAD) / 2;
+		scale_ = (WIDTH / 2) / std::tan(halfFov);
+		cosReprojectAngle_ = std::cos(REPROJECT_PIXELS / scale_);
+		// circle around the screen rectangle
+		auto radius = std::atan(std::hypot(WIDTH / 2.0f, HEIGHT / 2.0f) / scale_);
+
+		pointCount_ = 0;
+		sky_.skyIndex_.forEachWithin(center_, radius, [this](uint16_t index, float cosDistance) {
+			auto object = Sky::object(index);
+			int16_t x, y;
+			if (!toScreen(object.vector(), cosDistance, x, y)) {
+				return;
+			}
+			auto symbol = object.type() != coords::ObjectType::STAR ? Symbol::DEEP_SKY
+				: object.magnitude() < BRIGHT_MAGNITUDE ? Symbol::BRIGHT_STAR : Symbol::STAR;
+			points_[pointCount_++] = {x, y, symbol};
+		});
+		cacheValid_ = true;
+	}
+
+	bool toScreen(const std::array<float, 3>& vector, float cosDistance, int16_t& x, int16_t& y) const {
+		if (cosDistance <= 0) {
+			return false;
+		}
+		auto projectedX = std::lround(WIDTH / 2 - dot(vector, east_) / cosDistance * scale_);
+		auto projectedY = std::lround(HEIGHT / 2 - dot(vector, north_) / cosDistance * scale_);
+		if (projectedX < 0 || projectedX >= WIDTH || projectedY < 0 || projectedY >= HEIGHT) {
+			return false;
+		}
+		x = projectedX;
+		y = projectedY;
+		return true;
+	}
+
+	// reticle, or a marker on the screen edge in target direction when it is out of view
+	void drawTarget(const std::array<float, 3>& target) {
+		int16_t x, y;
+		auto cosDistance = dot(target, center_);
+		if (toScreen(target, cosDistance, x, y)) {
+			u8g2_.drawCircle(x, y, 4);
+			u8g2_.drawHLine(x - 7, y, 3);
+			u8g2_.drawHLine(x + 5, y, 3);
+			u8g2_.drawVLine(x, y - 7, 3);
+			u8g2_.drawVLine(x, y + 5, 3);
+			return;
+		}
+		auto dx = -dot(target, east_);
+		auto dy = -dot(target, north_);
+		auto length = std::max(std::fabs(dx) / (WIDTH / 2 - 2), std::fabs(dy) / (HEIGHT / 2 - 2));
+		if (length <= 0) {
+			return;
+		}
+		u8g2_.drawBox(WIDTH / 2 + std::lround(dx / length) - 1, HEIGHT / 2 + std::lround(dy / length) - 1, 3, 3);
+	}
+
+	static constexpr const float BRIGHT_MAGNITUDE = 1.5f;
+
+	U8G2& u8g2_;
+	const Mount& mount_;
+	Sky& sky_;
+	ActionDispatcher& dispatcher_;
+
+	std::size_t fovLevel_ = 2;
+	bool cacheValid_ = false;
+	std::array<float, 3> center_ = {0, 0, 0};
+	std::array<float, 3> east_ = {0, 0, 0};
+	std::array<float, 3> north_ = {0, 0, 0};
+	float scale_ = 1;
+	float cosReprojectAngle_ = 1;
+	std::array<Point, Sky::OBJECTS_COUNT> points_;
+	std::size_t pointCount_ = 0;
+	bool targetSet_ = false;
+	std::pair<double, double> target_ = {0, 0};
+};
+
+}
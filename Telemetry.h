@@ -0,0 +1,202 @@
+#pragma once
+
+#include "MpscQueue.h"
+
+#include <Arduino.h>
+#include <Stream.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+namespace telemetry {
+
+// Every channel: id, name, value types (i - int32_t, f - float), value names. telemetry_decode.py reads this
+// table, keep one entry per line and append new ones at the end.
+#define TELEMETRY_CHANNELS(X) \
+	X(POSITION, "position", "iiii", "targetX targetY positionX positionY") \
+	X(VELOCITY, "velocity", "ff", "speedX speedY") \
+	X(TRACKING_ERROR, "error", "ff", "errorX errorY") \
+	X(LOOP, "loop", "ii", "ticks maxGapUs") \
+	X(MODE, "mode", "iii", "trackingMode operationMode mountType")
+
+enum class Channel : uint8_t {
+#define TELEMETRY_CHANNEL_ID(id, name, types, values) id,
+	TELEMETRY_CHANNELS(TELEMETRY_CHANNEL_ID)
+#undef TELEMETRY_CHANNEL_ID
+	count,
+};
+
+constexpr const char* CHANNEL_NAMES[] = {
+#define TELEMETRY_CHANNEL_NAME(id, name, types, values) name,
+	TELEMETRY_CHANNELS(TELEMETRY_CHANNEL_NAME)
+#undef TELEMETRY_CHANNEL_NAME
+};
+
+// Motion task samples channels at SAMPLE_RATE_HZ, a subscription keeps every n-th sample. Samples go through a
+// lock-free ring to a low priority task on core 0 which writes them as binary frames; when the serial link
+// can not keep up samples are dropped and counted, the motion task never waits. MODE sends only changes.
+//
+// Frame, little endian: FRAME_START, channel (u8), value count (u8), timestamp (u32, micros()),
+// values (4 bytes each), checksum (u8, sum of the bytes after FRAME_START).
+class Recorder {
+public:
+	static constexpr const uint32_t SAMPLE_RATE_HZ = 1000;
+	static constexpr const std::size_t QUEUE_SIZE = 64;
+	static constexpr const std::size_t MAX_VALUES = 4;
+	static constexpr const uint8_t FRAME_START = 0x5A;
+	static constexpr const uint32_t DRAIN_INTERVAL_MS = 10;
+	static constexpr const uint32_t TASK_STACK_SIZE = 2048;
+	// below UI and display
+	static constexpr const UBaseType_t TASK_PRIORITY = 0;
+	static constexpr const BaseType_t TASK_CORE = 0;
+
+	union Value {
+		int32_t i;
+		float f;
+	};
+
+	struct Sample {
+		uint32_t timestampUs;
+		Channel channel;
+		uint8_t count;
+		std::array<Value, MAX_VALUES> values;
+	};
+
+	bool begin(Stream& stream) {
+		stream_ = &stream;
+		return xTaskCreatePinnedToCore(&Recorder::taskMain, "telemetry", TASK_STACK_SIZE, this, TASK_PRIORITY, nullptr, TASK_CORE) == pdPASS;
+	}
+
+	// any task. `rateHz` 0 unsubscribes, rates above SAMPLE_RATE_HZ are clamped.
+	void subscribe(Channel channel, uint32_t rateHz) {
+		uint16_t divider = 0;
+		if (rateHz > 0) {
+			divider = SAMPLE_RATE_HZ / std::min(rateHz, SAMPLE_RATE_HZ);
+		}
+		auto& state = channels_[static_cast<std::size_t>(channel)];
+		state.divider.store(divider, std::memory_order_relaxed);
+		// next MODE sample is sent even when unchanged
+		state.generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint32_t rateHz(Channel channel) const {
+		auto divider = channels_[static_cast<std::size_t>(channel)].divider.load(std::memory_order_relaxed);
+		return divider == 0 ? 0 : SAMPLE_RATE_HZ / divider;
+	}
+
+	uint32_t sent() const { return sent_.load(std::memory_order_relaxed); }
+	uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+	// motion task only, call at SAMPLE_RATE_HZ for every channel. Costs a load and a decrement when not due.
+	bool due(Channel channel) {
+		auto& state = channels_[static_cast<std::size_t>(channel)];
+		auto divider = state.divider.load(std::memory_order_relaxed);
+		if (divider == 0) {
+			return false;
+		}
+		// first sample right after subscribing or after the rate went up
+		if (state.countdown == 0 || state.countdown > divider) {
+			state.countdown = 1;
+		}
+		if (--state.countdown > 0) {
+			return false;
+		}
+		state.countdown = divider;
+		return true;
+	}
+
+	// motion task only, after due() returned true
+	template<typename... Values>
+	void record(Channel channel, uint32_t timestampUs, Values... values) {
+		static_assert(sizeof...(Values) <= MAX_VALUES, "Too many telemetry values");
+		Sample sample = {};
+		sample.timestampUs = timestampUs;
+		sample.channel = channel;
+		sample.count = sizeof...(Values);
+		std::size_t i = 0;
+		(void)std::initializer_list<int>{(sample.values[i++] = toValue(values), 0)...};
+
+		if (channel == Channel::MODE) {
+			auto& state = channels_[static_cast<std::size_t>(channel)];
+			auto generation = state.generation.load(std::memory_order_relaxed);
+			if (generation == state.recordedGeneration && std::memcmp(&sample.values, &lastMode_, sizeof(lastMode_)) == 0) {
+				return;
+			}
+			state.recordedGeneration = generation;
+			lastMode_ = sample.values;
+		}
+		if (!queue_.push(sample)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+private:
+	struct ChannelState {
+		std::atomic<uint16_t> divider{0};
+		std::atomic<uint8_t> generation{0};
+		// motion task only
+		uint16_t countdown = 0;
+		uint8_t recordedGeneration = 0;
+	};
+
+	template<typename T>
+	static Value toValue(T value) {
+		Value result;
+		if (std::is_floating_point<T>::value) {
+			result.f = value;
+		} else {
+			result.i = static_cast<int32_t>(value);
+		}
+		return result;
+	}
+
+	static void taskMain(void* self) {
+		auto& recorder = *static_cast<Recorder*>(self);
+		for (;;) {
+			recorder.drain();
+			vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+		}
+	}
+
+	void drain() {
+		Sample sample;
+		while (queue_.pop(sample)) {
+			uint8_t frame[1 + 1 + 1 + 4 + MAX_VALUES * sizeof(Value) + 1];
+			std::size_t length = 0;
+			frame[length++] = FRAME_START;
+			frame[length++] = static_cast<uint8_t>(sample.channel);
+			frame[length++] = sample.count;
+			for (std::size_t i = 0; i < 4; ++i) {
+				frame[length++] = (sample.timestampUs >> (8 * i)) & 0xFF;
+			}
+			// ESP32 is little endian, values go as they are in memory
+			std::memcpy(frame + length, sample.values.data(), sample.count * sizeof(Value));
+			length += sample.count * sizeof(Value);
+			uint8_t checksum = 0;
+			for (std::size_t i = 1; i < length; ++i) {
+				checksum += frame[i];
+			}
+			frame[length++] = checksum;
+			stream_->write(frame, length);
+			sent_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	std::array<ChannelState, static_cast<std::size_t>(Channel::count)> channels_;
+	std::array<Value, MAX_VALUES> lastMode_ = {};
+	scope::MpscQueue<Sample, QUEUE_SIZE> queue_;
+	Stream* stream_ = nullptr;
+	std::atomic<uint32_t> sent_{0};
+	std::atomic<uint32_t> dropped_{0};
+};
+
+inline Recorder& recorder() {
+	static Recorder instance;
+	return instance;
+}
+
+}
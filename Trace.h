@@ -0,0 +1,569 @@
+#pragma once
+
+#include "InputEvents.h"
+#include "MpscQueue.h"
+
+#include <Arduino.h>
+#include <FS.h>
+#include <Stream.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace trace {
+
+// Everything the firmware reads from outside besides the sensors it has not got: serial bytes, controller
+// events and the wall clock. Motion, display and tracking follow from these and micros(), so a trace recorded
+// from boot replays the same commands at the same times. Checkpoints (axis positions once a second) tell where
+// a replay went another way.
+//
+// File, little endian: MAGIC, VERSION (u8), then records: kind (u8), time since the previous record (signed
+// varint, us), payload:
+//   CLOCK       wall clock (signed varint, unix time in us)
+//   SERIAL      length (u8), bytes as read
+//   INPUT_EVENT ui::InputEvent kind, button (u8), x, y (i8)
+//   CHECKPOINT  position X, Y (signed varint, steps)
+//   LOST        records dropped before this one (varint)
+// Signed varints are zigzag encoded LEB128. trace_decode.py prints a trace.
+enum class Kind : uint8_t {
+	CLOCK,
+	SERIAL,
+	INPUT_EVENT,
+	CHECKPOINT,
+	LOST,
+	count,
+};
+
+constexpr const char MAGIC[] = {'S', 'T', 'R', 'C'};
+constexpr const uint8_t VERSION = 1;
+constexpr const std::size_t SERIAL_CHUNK = 16;
+
+struct Record {
+	// micros() of the recording, replay moves it to its own timeline
+	uint32_t timestampUs;
+	Kind kind;
+	// SERIAL bytes
+	uint8_t length;
+	union {
+		std::array<uint8_t, SERIAL_CHUNK> bytes;
+		// CLOCK epoch us, CHECKPOINT positions, LOST count
+		std::array<int64_t, 2> values;
+	};
+
+	ui::InputEvent input() const {
+		return {static_cast<ui::InputEvent::Kind>(bytes[0]), static_cast<ui::Button>(bytes[1]),
+			static_cast<int8_t>(bytes[2]), static_cast<int8_t>(bytes[3]), timestampUs};
+	}
+};
+
+// Records go through a lock-free ring to a low priority task on core 0 which encodes them into the file, the
+// producers never wait for flash. Records that do not fit the ring are dropped and counted, the trace then has
+// a LOST record and does not replay faithfully.
+class Recorder {
+public:
+	static constexpr const std::size_t QUEUE_SIZE = 64;
+	static constexpr const uint32_t DRAIN_INTERVAL_MS = 50;
+	// LittleFS commits written data on flush
+	static constexpr const uint32_t FLUSH_INTERVAL_MS = 1000;
+	// a night of checkpoints and typical command traffic is well below
+	static constexpr const uint32_t MAX_FILE_BYTES = 512 * 1024;
+	// flash writes need more stack than telemetry's serial writes
+	static constexpr const uint32_t TASK_STACK_SIZE = 4096;
+	static constexpr const UBaseType_t TASK_PRIORITY = 0;
+	static constexpr const BaseType_t TASK_CORE = 0;
+
+	// `epochUs` is the wall clock at `startUs`. The file stays open until stop() or MAX_FILE_BYTES.
+	bool begin(fs::File file, uint32_t startUs, int64_t epochUs) {
+		if (state_.load(std::memory_order_relaxed) != State::IDLE) {
+			return false;
+		}
+		file_ = file;
+		lastUs_ = startUs;
+		full_.store(false, std::memory_order_relaxed);
+		records_.store(0, std::memory_order_relaxed);
+		dropped_.store(0, std::memory_order_relaxed);
+		lostWritten_ = 0;
+		uint8_t header[sizeof(MAGIC) + 1];
+		std::memcpy(header, MAGIC, sizeof(MAGIC));
+		header[sizeof(MAGIC)] = VERSION;
+		if (file_.write(header, sizeof(header)) != sizeof(header)) {
+			return false;
+		}
+		bytes_ = sizeof(header);
+		Record record = {};
+		record.timestampUs = startUs;
+		record.kind = Kind::CLOCK;
+		record.values[0] = epochUs;
+		write(record);
+		state_.store(State::RECORDING, std::memory_order_release);
+		if (!taskStarted_) {
+			taskStarted_ = xTaskCreatePinnedToCore(&Recorder::taskMain, "trace", TASK_STACK_SIZE, this, TASK_PRIORITY, nullptr, TASK_CORE) == pdPASS;
+		}
+		if (!taskStarted_) {
+			file_.close();
+			state_.store(State::IDLE, std::memory_order_relaxed);
+		}
+		return taskStarted_;
+	}
+
+	// any task, the file is closed by the recorder task once the ring is written out
+	void stop() {
+		auto expected = State::RECORDING;
+		state_.compare_exchange_strong(expected, State::STOPPING, std::memory_order_relaxed);
+	}
+
+	bool recording() const { return state_.load(std::memory_order_acquire) == State::RECORDING; }
+	bool active() const { return state_.load(std::memory_order_acquire) != State::IDLE; }
+	// stopped at MAX_FILE_BYTES
+	bool full() const { return full_.load(std::memory_order_relaxed); }
+	uint32_t records() const { return records_.load(std::memory_order_relaxed); }
+	uint32_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+	uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+	// any task, bytes in the order the firmware read them
+	void serial(uint32_t timestampUs, const uint8_t* bytes, std::size_t length) {
+		while (length > 0) {
+			Record record = {};
+			record.timestampUs = timestampUs;
+			record.kind = Kind::SERIAL;
+			record.length = std::min(length, SERIAL_CHUNK);
+			std::memcpy(record.bytes.data(), bytes, record.length);
+			push(record);
+			bytes += record.length;
+			length -= record.length;
+		}
+	}
+
+	// any task, an event the input pipeline accepted
+	void input(uint32_t timestampUs, const ui::InputEvent& event) {
+		Record record = {};
+		record.timestampUs = timestampUs;
+		record.kind = Kind::INPUT_EVENT;
+		record.bytes[0] = static_cast<uint8_t>(event.kind);
+		record.bytes[1] = static_cast<uint8_t>(event.button);
+		record.bytes[2] = static_cast<uint8_t>(event.x);
+		record.bytes[3] = static_cast<uint8_t>(event.y);
+		push(record);
+	}
+
+	// any task
+	void checkpoint(uint32_t timestampUs, int32_t positionX, int32_t positionY) {
+		Record record = {};
+		record.timestampUs = timestampUs;
+		record.kind = Kind::CHECKPOINT;
+		record.values = {positionX, positionY};
+		push(record);
+	}
+
+private:
+	enum class State : uint8_t {
+		IDLE,
+		RECORDING,
+		STOPPING,
+	};
+
+	void push(const Record& record) {
+		if (!recording()) {
+			return;
+		}
+		if (!queue_.push(record)) {
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	static void taskMain(void* self) {
+		auto& recorder = *static_cast<Recorder*>(self);
+		for (;;) {
+			recorder.drain();
+			vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+		}
+	}
+
+	void drain() {
+		auto state = state_.load(std::memory_order_acquire);
+		Record record;
+		if (state == State::IDLE) {
+			// pushed while the recorder stopped, must not end up in the next trace
+			while (queue_.pop(record)) {
+			}
+			return;
+		}
+		while (queue_.pop(record)) {
+			auto dropped = dropped_.load(std::memory_order_relaxed);
+			if (dropped != lostWritten_) {
+				Record lost = {};
+				lost.timestampUs = lastUs_;
+				lost.kind = Kind::LOST;
+				lost.values[0] = dropped - lostWritten_;
+				lostWritten_ = dropped;
+				write(lost);
+			}
+			write(record);
+		}
+		if (!full_.load(std::memory_order_relaxed) && bytes_.load(std::memory_order_relaxed) >= MAX_FILE_BYTES) {
+			full_.store(true, std::memory_order_relaxed);
+			state = State::STOPPING;
+		}
+		auto nowMs = millis();
+		if (state == State::STOPPING) {
+			file_.close();
+			state_.store(State::IDLE, std::memory_order_release);
+		} else if (nowMs - lastFlushMs_ >= FLUSH_INTERVAL_MS) {
+			file_.flush();
+			lastFlushMs_ = nowMs;
+		}
+	}
+
+	// recorder task, or begin() before the task runs
+	void write(const Record& record) {
+		uint8_t buffer[1 + 5 + 2 * 10 + SERIAL_CHUNK];
+		std::size_t length = 0;
+		buffer[length++] = static_cast<uint8_t>(record.kind);
+		length += putSigned(buffer + length, static_cast<int32_t>(record.timestampUs - lastUs_));
+		lastUs_ = record.timestampUs;
+		switch (record.kind) {
+			case Kind::CLOCK:
+				length += putSigned(buffer + length, record.values[0]);
+				break;
+			case Kind::SERIAL:
+				buffer[length++] = record.length;
+				std::memcpy(buffer + length, record.bytes.data(), record.length);
+				length += record.length;
+				break;
+			case Kind::INPUT_EVENT:
+				std::memcpy(buffer + length, record.bytes.data(), 4);
+				length += 4;
+				break;
+			case Kind::CHECKPOINT:
+				length += putSigned(buffer + length, record.values[0]);
+				length += putSigned(buffer + length, record.values[1]);
+				break;
+			case Kind::LOST:
+				length += putUnsigned(buffer + length, record.values[0]);
+				break;
+			default:
+				return;
+		}
+		file_.write(buffer, length);
+		bytes_.fetch_add(length, std::memory_order_relaxed);
+		records_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static std::size_t putUnsigned(uint8_t* buffer, uint64_t value) {
+		std::size_t length = 0;
+		while (value >= 0x80) {
+			buffer[length++] = static_cast<uint8_t>(value) | 0x80;
+			value >>= 7;
+		}
+		buffer[length++] = static_cast<uint8_t>(value);
+		return length;
+	}
+
+	static std::size_t putSigned(uint8_t* buffer, int64_t value) {
+		return putUnsigned(buffer, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+	}
+
+	scope::MpscQueue<Record, QUEUE_SIZE> queue_;
+	std::atomic<State> state_{State::IDLE};
+	std::atomic<bool> full_{false};
+	std::atomic<uint32_t> records_{0};
+	std::atomic<uint32_t> bytes_{0};
+	std::atomic<uint32_t> dropped_{0};
+	bool taskStarted_ = false;
+
+	// recorder task only
+	fs::File file_;
+	uint32_t lastUs_ = 0;
+	uint32_t lastFlushMs_ = 0;
+	uint32_t lostWritten_ = 0;
+};
+
+inline Recorder& recorder() {
+	static Recorder instance;
+	return instance;
+}
+
+// Decodes records from a trace file. Timestamps start at 0 with the first record.
+class Reader {
+public:
+	// reads the header
+	bool begin(Stream& stream) {
+		stream_ = &stream;
+		timeUs_ = 0;
+		corrupt_ = false;
+		for (auto expected : MAGIC) {
+			if (stream.read() != expected) {
+				return false;
+			}
+		}
+		return stream.read() == VERSION;
+	}
+
+	// false at the end of the trace or on a damaged record
+	bool next(Record& record) {
+		if (stream_ == nullptr || stream_->available() <= 0) {
+			return false;
+		}
+		auto kind = stream_->read();
+		int64_t delta = 0;
+		if (kind < 0 || kind >= static_cast<int>(Kind::count) || !getSigned(delta)) {
+			return fail();
+		}
+		timeUs_ += static_cast<uint32_t>(delta);
+		record = {};
+		record.timestampUs = timeUs_;
+		record.kind = static_cast<Kind>(kind);
+		switch (record.kind) {
+			case Kind::CLOCK:
+				return getSigned(record.values[0]) || fail();
+			case Kind::SERIAL: {
+				auto length = stream_->read();
+				if (length <= 0 || length > static_cast<int>(SERIAL_CHUNK)) {
+					return fail();
+				}
+				record.length = length;
+				return getBytes(record.bytes.data(), length) || fail();
+			}
+			case Kind::INPUT_EVENT:
+				return getBytes(record.bytes.data(), 4) || fail();
+			case Kind::CHECKPOINT:
+				return (getSigned(record.values[0]) && getSigned(record.values[1])) || fail();
+			case Kind::LOST: {
+				uint64_t count = 0;
+				if (!getUnsigned(count)) {
+					return fail();
+				}
+				record.values[0] = count;
+				return true;
+			}
+			default:
+				return fail();
+		}
+	}
+
+	bool corrupt() const { return corrupt_; }
+
+private:
+	bool fail() {
+		corrupt_ = true;
+		stream_ = nullptr;
+		return false;
+	}
+
+	bool getBytes(uint8_t* bytes, std::size_t length) {
+		for (std::size_t i = 0; i < length; ++i) {
+			auto byte = stream_->read();
+			if (byte < 0) {
+				return false;
+			}
+			bytes[i] = byte;
+		}
+		return true;
+	}
+
+	bool getUnsigned(uint64_t& value) {
+		value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			auto byte = stream_->read();
+			if (byte < 0) {
+				return false;
+			}
+			value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool getSigned(int64_t& value) {
+		uint64_t zigzag = 0;
+		if (!getUnsigned(zigzag)) {
+			return false;
+		}
+		value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+		return true;
+	}
+
+	Stream* stream_ = nullptr;
+	uint32_t timeUs_ = 0;
+	bool corrupt_ = false;
+};
+
+// Plays a trace back on the micros() timeline it was started at. The firmware reads serial input from the
+// replayer instead of the port while it is active, other records come out of poll() when due.
+class Replayer : public Stream {
+public:
+	static constexpr const std::size_t BUFFER_SIZE = 256;
+
+	struct Stats {
+		uint32_t records = 0;
+		uint32_t checkpoints = 0;
+		uint32_t diverged = 0;
+		// since replay start, valid when diverged > 0
+		uint32_t firstDivergenceMs = 0;
+		uint32_t maxDivergenceSteps = 0;
+		// records the recorder dropped
+		uint32_t lost = 0;
+		bool corrupt = false;
+	};
+
+	bool begin(fs::File file, uint32_t startUs) {
+		file_ = file;
+		if (!reader_.begin(file_)) {
+			file_.close();
+			return false;
+		}
+		startUs_ = startUs;
+		stats_ = {};
+		bufferStart_ = 0;
+		bufferLength_ = 0;
+		pending_ = reader_.next(next_);
+		active_.store(pending_, std::memory_order_release);
+		if (!pending_) {
+			file_.close();
+		}
+		return pending_;
+	}
+
+	// any task. Until the last record is due and the last serial byte read.
+	bool active() const { return active_.load(std::memory_order_acquire); }
+	const Stats& stats() const { return stats_; }
+
+	// Reading task. Returns the next due record other than SERIAL, those go to the serial buffer. Timestamp of the
+	// returned record is on the replay timeline.
+	bool poll(uint32_t nowUs, Record& record) {
+		while (pending_ && static_cast<int32_t>(nowUs - (startUs_ + next_.timestampUs)) >= 0) {
+			if (next_.kind == Kind::SERIAL) {
+				if (bufferLength_ + next_.length > BUFFER_SIZE) {
+					// firmware has not read the previous bytes yet
+					return false;
+				}
+				for (std::size_t i = 0; i < next_.length; ++i) {
+					buffer_[(bufferStart_ + bufferLength_++) % BUFFER_SIZE] = next_.bytes[i];
+				}
+				advance();
+				continue;
+			}
+			record = next_;
+			record.timestampUs += startUs_;
+			if (record.kind == Kind::LOST) {
+				stats_.lost += record.values[0];
+			}
+			advance();
+			return true;
+		}
+		finishIfDone();
+		return false;
+	}
+
+	// reading task, with the positions when a CHECKPOINT record came out of poll()
+	void verify(const Record& checkpoint, int32_t positionX, int32_t positionY) {
+		++stats_.checkpoints;
+		auto divergence = static_cast<uint32_t>(std::max(std::abs(positionX - checkpoint.values[0]), std::abs(positionY - checkpoint.values[1])));
+		if (divergence == 0) {
+			return;
+		}
+		if (stats_.diverged++ == 0) {
+			stats_.firstDivergenceMs = (checkpoint.timestampUs - startUs_) / 1000;
+		}
+		stats_.maxDivergenceSteps = std::max(stats_.maxDivergenceSteps, divergence);
+	}
+
+	int available() override { return bufferLength_; }
+	int read() override {
+		if (bufferLength_ == 0) {
+			return -1;
+		}
+		auto byte = buffer_[bufferStart_];
+		bufferStart_ = (bufferStart_ + 1) % BUFFER_SIZE;
+		--bufferLength_;
+		finishIfDone();
+		return byte;
+	}
+	int peek() override { return bufferLength_ == 0 ? -1 : buffer_[bufferStart_]; }
+	// replies go to the port, not here
+	size_t write(uint8_t) override { return 0; }
+	using Print::write;
+
+private:
+	void advance() {
+		++stats_.records;
+		pending_ = reader_.next(next_);
+		if (!pending_) {
+			stats_.corrupt = reader_.corrupt();
+			file_.close();
+		}
+	}
+
+	void finishIfDone() {
+		if (!pending_ && bufferLength_ == 0 && active_.load(std::memory_order_relaxed)) {
+			active_.store(false, std::memory_order_release);
+		}
+	}
+
+	fs::File file_;
+	Reader reader_;
+	Record next_;
+	bool pending_ = false;
+	uint32_t startUs_ = 0;
+	std::atomic<bool> active_{false};
+	Stats stats_;
+	std::array<uint8_t, BUFFER_SIZE> buffer_;
+	std::size_t bufferStart_ = 0;
+	std::size_t bufferLength_ = 0;
+};
+
+// Serial input as the firmware sees it. Bytes read from the port are recorded while the recorder runs, during
+// a replay they come from the trace and the port is left alone. Output always goes to the port.
+class SerialTap : public Stream {
+public:
+	SerialTap(Stream& port, Recorder& recorder) : port_(port), recorder_(recorder) {}
+
+	// reading task, nullptr goes back to the port
+	void replayFrom(Stream* replay) { replay_ = replay; }
+
+	int available() override { return source().available(); }
+	int read() override {
+		auto byte = source().read();
+		if (byte >= 0 && replay_ == nullptr && recorder_.recording()) {
+			if (chunkLength_ == 0) {
+				chunkUs_ = micros();
+			}
+			chunk_[chunkLength_++] = byte;
+			if (chunkLength_ == chunk_.size()) {
+				commit();
+			}
+		}
+		return byte;
+	}
+	int peek() override { return source().peek(); }
+	size_t write(uint8_t byte) override { return port_.write(byte); }
+	size_t write(const uint8_t* buffer, size_t size) override { return port_.write(buffer, size); }
+	void flush() override { port_.flush(); }
+	using Print::write;
+
+	// reading task, after a read pass. Bytes read since the last call become one record with the time of the
+	// first one, a replay hands them over together.
+	void commit() {
+		if (chunkLength_ > 0) {
+			recorder_.serial(chunkUs_, chunk_.data(), chunkLength_);
+			chunkLength_ = 0;
+		}
+	}
+
+private:
+	Stream& source() { return replay_ != nullptr ? *replay_ : port_; }
+
+	Stream& port_;
+	Recorder& recorder_;
+	Stream* replay_ = nullptr;
+	std::array<uint8_t, 64> chunk_;
+	std::size_t chunkLength_ = 0;
+	uint32_t chunkUs_ = 0;
+};
+
+}
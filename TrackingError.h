@@ -0,0 +1,200 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace scope {
+
+// Tracking error (ideal minus actual axis position, steps) sampled at a fixed interval: running RMS, mean and peak
+// per axis and a periodogram at PERIODS log spaced periods, to find periodic error of the drive (a worm or motor
+// revolution, microstep cycles).
+//
+// Every period runs a Goertzel filter over Hann windowed blocks of CYCLES_PER_BLOCK periods, so its band reaches the
+// neighbouring periods and slow drifts do not leak into it, and averages the power of completed blocks. A filter on
+// the window alone removes the block's mean exactly. The amplitude of a period is the one of a sine of that period
+// with the same power.
+//
+// add() runs in the motion task: the window comes from a float rotation per band instead of a cosine per sample,
+// square roots are left to summary() on the reading side.
+class TrackingError {
+public:
+	static constexpr const std::size_t AXES = 2;
+	static constexpr const std::size_t PERIODS = 33;
+	// 2 s to about 54 min (a worm revolution), 3 periods per octave
+	static constexpr const double MIN_PERIOD_S = 2;
+	static constexpr const double PERIOD_RATIO = 1.2599210498948732;
+	static constexpr const uint32_t CYCLES_PER_BLOCK = 4;
+
+	// Goertzel state: s[n-1], s[n-2]
+	struct Filter {
+		double s1 = 0;
+		double s2 = 0;
+
+		void add(double coefficient, double value) {
+			auto s = value + coefficient * s1 - s2;
+			s2 = s1;
+			s1 = s;
+		}
+	};
+
+	struct Band {
+		double coefficient = 0;
+		double cosine = 0;
+		double sine = 0;
+		uint32_t blockSamples = 0;
+		uint32_t samples = 0;
+		// cos and sin of the window phase, rotated by one sample's step
+		float phaseCosine = 1;
+		float phaseSine = 0;
+		float stepCosine = 1;
+		float stepSine = 0;
+		// Goertzel of the window, sum of the window
+		Filter window;
+		double weights = 0;
+		std::array<Filter, AXES> filters;
+		std::array<double, AXES> sums = {};
+	};
+
+	// Accumulated statistics in steps, small enough to copy for other tasks
+	struct Totals {
+		uint32_t samples = 0;
+		double sampleIntervalS = 0;
+		std::array<double, AXES> sums = {};
+		std::array<double, AXES> sumSquares = {};
+		std::array<double, AXES> peaks = {};
+		// completed blocks per period, sum of their amplitude squared
+		std::array<uint32_t, PERIODS> blocks = {};
+		std::array<std::array<double, PERIODS>, AXES> powers = {};
+	};
+
+	struct Component {
+		double periodS = 0;
+		// steps, 0 when no block of the period completed yet
+		double amplitude = 0;
+	};
+
+	// Statistics in steps
+	struct Summary {
+		uint32_t samples = 0;
+		float durationS = 0;
+		std::array<float, AXES> rms = {};
+		std::array<float, AXES> mean = {};
+		std::array<float, AXES> peak = {};
+		std::array<std::array<float, PERIODS>, AXES> amplitudes = {};
+
+		// largest amplitude of `axis` among the periods with a completed block
+		Component dominant(std::size_t axis) const {
+			Component best;
+			for (std::size_t i = 0; i < PERIODS; ++i) {
+				if (amplitudes[axis][i] > best.amplitude) {
+					best = {period(i), amplitudes[axis][i]};
+				}
+			}
+			return best;
+		}
+	};
+
+	explicit TrackingError(double sampleIntervalS = 0.25) { reset(sampleIntervalS); }
+
+	void reset(double sampleIntervalS) {
+		totals_ = Totals{};
+		totals_.sampleIntervalS = sampleIntervalS;
+		for (std::size_t i = 0; i < PERIODS; ++i) {
+			auto omega = TWO_PI * sampleIntervalS / period(i);
+			auto& band = bands_[i];
+			band = Band{};
+			band.cosine = std::cos(omega);
+			band.sine = std::sin(omega);
+			band.coefficient = 2 * band.cosine;
+			band.blockSamples = std::max<uint32_t>(2, std::lround(CYCLES_PER_BLOCK * period(i) / sampleIntervalS));
+			band.stepCosine = std::cos(TWO_PI / band.blockSamples);
+			band.stepSine = std::sin(TWO_PI / band.blockSamples);
+		}
+	}
+
+	void add(double errorX, double errorY) {
+		std::array<double, AXES> errors = {errorX, errorY};
+		for (std::size_t axis = 0; axis < AXES; ++axis) {
+			totals_.sums[axis] += errors[axis];
+			totals_.sumSquares[axis] += errors[axis] * errors[axis];
+			totals_.peaks[axis] = std::max(totals_.peaks[axis], std::fabs(errors[axis]));
+		}
+		for (std::size_t i = 0; i < PERIODS; ++i) {
+			auto& band = bands_[i];
+			double weight = 0.5f - 0.5f * band.phaseCosine;
+			band.window.add(band.coefficient, weight);
+			band.weights += weight;
+			for (std::size_t axis = 0; axis < AXES; ++axis) {
+				band.filters[axis].add(band.coefficient, weight * errors[axis]);
+				band.sums[axis] += errors[axis];
+			}
+			auto phaseCosine = band.phaseCosine * band.stepCosine - band.phaseSine * band.stepSine;
+			band.phaseSine = band.phaseSine * band.stepCosine + band.phaseCosine * band.stepSine;
+			band.phaseCosine = phaseCosine;
+			if (++band.samples == band.blockSamples) {
+				endBlock(i);
+			}
+		}
+		++totals_.samples;
+	}
+
+	uint32_t samples() const { return totals_.samples; }
+	const Totals& totals() const { return totals_; }
+
+	static double period(std::size_t index) { return MIN_PERIOD_S * std::pow(PERIOD_RATIO, index); }
+
+	// RMS, mean, peak and amplitudes of `totals`
+	static Summary summary(const Totals& totals) {
+		Summary summary;
+		summary.samples = totals.samples;
+		summary.durationS = totals.samples * totals.sampleIntervalS;
+		if (totals.samples == 0) {
+			return summary;
+		}
+		for (std::size_t axis = 0; axis < AXES; ++axis) {
+			summary.rms[axis] = std::sqrt(totals.sumSquares[axis] / totals.samples);
+			summary.mean[axis] = totals.sums[axis] / totals.samples;
+			summary.peak[axis] = totals.peaks[axis];
+			for (std::size_t i = 0; i < PERIODS; ++i) {
+				auto blocks = totals.blocks[i];
+				summary.amplitudes[axis][i] = blocks > 0 ? std::sqrt(totals.powers[axis][i] / blocks) : 0;
+			}
+		}
+		return summary;
+	}
+
+	Summary summary() const { return summary(totals_); }
+
+private:
+	// Goertzel output y = s1 - e^(-i w) s2, the window's output subtracted `mean` times
+	void endBlock(std::size_t index) {
+		auto& band = bands_[index];
+		for (std::size_t axis = 0; axis < AXES; ++axis) {
+			auto mean = band.sums[axis] / band.samples;
+			const auto& filter = band.filters[axis];
+			auto s1 = filter.s1 - mean * band.window.s1;
+			auto s2 = filter.s2 - mean * band.window.s2;
+			auto re = s1 - band.cosine * s2;
+			auto im = band.sine * s2;
+			// amplitude squared, 2 |y| / weights
+			totals_.powers[axis][index] += 4 * (re * re + im * im) / (band.weights * band.weights);
+			band.filters[axis] = Filter{};
+			band.sums[axis] = 0;
+		}
+		band.window = Filter{};
+		band.weights = 0;
+		band.samples = 0;
+		band.phaseCosine = 1;
+		band.phaseSine = 0;
+		++totals_.blocks[index];
+	}
+
+	Totals totals_;
+	std::array<Band, PERIODS> bands_;
+};
+
+}
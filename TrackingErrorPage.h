@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Menu.h"
+#include "Mount.h"
+#include "ScreenItemIfc.h"
+#include "TrackingError.h"
+
+#include <U8g2lib.h>
+
+#include <array>
+
+namespace ui {
+
+using scope::Mount;
+using scope::TrackingError;
+
+// Tracking error since auto tracking started, in arc seconds: RMS, peak and mean per axis and the strongest period
+// of each axis. Enter starts the statistics again, exit goes back to the dashboard.
+class TrackingErrorPage : public ScreenItem {
+public:
+	static constexpr const std::size_t LINES = 6;
+	static constexpr const std::array<double, TrackingError::AXES> ARCSEC_PER_STEP = {
+		Mount::X_AXIS_STEPS_TO_ANGLE_DEG * 3600, Mount::Y_AXIS_STEPS_TO_ANGLE_DEG * 3600
+	};
+
+	TrackingErrorPage(U8G2& u8g2, Mount& mount, ActionDispatcher& dispatcher)
+		: u8g2_(u8g2), mount_(mount), dispatcher_(dispatcher) {}
+
+	void draw() override {
+		u8g2_.setFont(u8g2_font_profont11_tf);
+		u8g2_.setFontMode(1);
+		u8g2_.setDrawColor(1);
+		for (std::size_t i = 0; i < LINES; ++i) {
+			u8g2_.drawStr(1, 10 + i * 10, lines_[i].data());
+		}
+	}
+	// new text only with a new sample, 4 times a second while tracking
+	bool changed() override {
+		auto totals = mount_.trackingError();
+		if (formatted_ && totals.samples == samples_) {
+			return false;
+		}
+		formatted_ = true;
+		samples_ = totals.samples;
+		format(TrackingError::summary(totals));
+		return true;
+	}
+	void down() override {}
+	void up() override {}
+	void enter() override { mount_.resetTrackingError(); }
+	void exit() override { dispatcher_.dispatch(Action::OPEN_DASHBOARD, 0); }
+
+private:
+	static constexpr const char* AXIS_NAMES[TrackingError::AXES] = {"X", "Y"};
+
+	void format(const TrackingError::Summary& summary) {
+		auto minutes = static_cast<unsigned>(summary.durationS / 60);
+		snprintf(lines_[0].data(), lines_[0].size(), "TRACK ERR %3uh%02um", minutes / 60, minutes % 60);
+		if (summary.samples == 0) {
+			snprintf(lines_[1].data(), lines_[1].size(), "Start auto tracking");
+			for (std::size_t i = 2; i < LINES; ++i) {
+				lines_[i][0] = '\0';
+			}
+			return;
+		}
+		snprintf(lines_[1].data(), lines_[1].size(), "\"   RMS  PEAK  MEAN");
+		for (std::size_t axis = 0; axis < TrackingError::AXES; ++axis) {
+			auto scale = ARCSEC_PER_STEP[axis];
+			snprintf(lines_[2 + axis].data(), lines_[2 + axis].size(), "%s %5.0f %5.0f %5.0f", AXIS_NAMES[axis],
+				summary.rms[axis] * scale, summary.peak[axis] * scale, summary.mean[axis] * scale);
+			auto dominant = summary.dominant(axis);
+			if (dominant.amplitude > 0) {
+				snprintf(lines_[4 + axis].data(), lines_[4 + axis].size(), "%s ~%.0fs %.0f\"", AXIS_NAMES[axis],
+					dominant.periodS, dominant.amplitude * scale);
+			} else {
+				snprintf(lines_[4 + axis].data(), lines_[4 + axis].size(), "%s period -", AXIS_NAMES[axis]);
+			}
+		}
+	}
+
+	U8G2& u8g2_;
+	Mount& mount_;
+	ActionDispatcher& dispatcher_;
+
+	bool formatted_ = false;
+	uint32_t samples_ = 0;
+	std::array<std::array<char, 24>, LINES> lines_;
+};
+
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoordsUtils.h"
+
+#include <Arduino.h>
+
+#include <array>
+#include <bitset>
+#include <cmath>
+
+namespace coords {
+
+// Minimum altitude per azimuth bin (trees, buildings). Azimuth is measured from north towards east.
+class HorizonMask {
+public:
+	static constexpr const std::size_t BINS = 36;
+	static constexpr const float BIN_WIDTH_DEG = 360.0f / BINS;
+
+	HorizonMask() { setAll(0); }
+
+	void setAll(float minAltitudeDeg) {
+		for (std::size_t i = 0; i < BINS; ++i) {
+			setBin(i, minAltitudeDeg);
+		}
+	}
+
+	// sets the bin containing `azimuthDeg`
+	void set(float azimuthDeg, float minAltitudeDeg) {
+		setBin(binFromAzimuthDeg(azimuthDeg), minAltitudeDeg);
+	}
+
+	float minAltitudeDeg(std::size_t bin) const {
+		return minAltitudeDeg_[bin];
+	}
+
+	// O(1) lookup, compared directly with dot product of unit vectors
+	float minAltitudeSin(float azimuthRad) const {
+		return minAltitudeSin_[binFromAzimuthDeg(azimuthRad * static_cast<float>(RAD_TO_DEG))];
+	}
+
+	// lowest value of the whole mask, lets callers skip azimuth computation for objects below it
+	float lowestAltitudeSin() const {
+		return lowestAltitudeSin_;
+	}
+
+	std::size_t binFromAzimuthDeg(float azimuthDeg) const {
+		auto bin = static_cast<int>(std::floor(azimuthDeg / BIN_WIDTH_DEG)) % static_cast<int>(BINS);
+		return bin < 0 ? bin + BINS : bin;
+	}
+
+	uint32_t version() const {
+		return version_;
+	}
+
+private:
+	void setBin(std::size_t bin, float minAltitudeDeg) {
+		minAltitudeDeg_[bin] = minAltitudeDeg;
+		minAltitudeSin_[bin] = std::sin(minAltitudeDeg * static_cast<float>(DEG_TO_RAD));
+		lowestAltitudeSin_ = minAltitudeSin_[0];
+		for (auto altitudeSin : minAltitudeSin_) {
+			lowestAltitudeSin_ = std::min(lowestAltitudeSin_, altitudeSin);
+		}
+		++version_;
+	}
+
+	std::array<float, BINS> minAltitudeDeg_;
+	std::array<float, BINS> minAltitudeSin_;
+	float lowestAltitudeSin_ = 0;
+	uint32_t version_ = 0;
+};
+
+// Horizontal frame axes expressed in equatorial unit vector coordinates for given site and time
+struct HorizonFrame {
+	HorizonFrame(const Site& site, double unixSeconds) {
+		auto lst = localSiderealTimeRad(unixSeconds, site.longitude);
+		auto sinLst = static_cast<float>(std::sin(lst));
+		auto cosLst = static_cast<float>(std::cos(lst));
+		auto sinLat = static_cast<float>(std::sin(site.latitude));
+		auto cosLat = static_cast<float>(std::cos(site.latitude));
+		zenith = {cosLat * cosLst, cosLat * sinLst, sinLat};
+		north = {-sinLat * cosLst, -sinLat * sinLst, cosLat};
+		east = {-sinLst, cosLst, 0};
+	}
+
+	std::array<float, 3> zenith;
+	std::array<float, 3> north;
+	std::array<float, 3> east;
+};
+
+// Tracks which objects of a catalog are above the horizon mask. Altitude of every object is a single dot
+// product with catalog unit vectors. Refresh is spread over several `tick()` calls, `CHUNK_SIZE` objects each.
+template<std::size_t N>
+class VisibilityFilter {
+public:
+	static constexpr const std::size_t CHUNK_SIZE = 32;
+
+	explicit VisibilityFilter(const Catalog& catalog) : x_(catalog.x_), y_(catalog.y_), z_(catalog.z_) {}
+
+	// Starts new pass over the catalog. Result of the previous pass stays valid until this one finishes.
+	void beginRefresh(const Site& site, double unixSeconds) {
+		frame_ = HorizonFrame(site, unixSeconds);
+		next_.reset();
+		cursor_ = 0;
+		refreshing_ = true;
+	}
+
+	// returns true when pass finished with this call
+	bool tick(const HorizonMask& mask) {
+		if (!refreshing_) {
+			return false;
+		}
+		auto end = std::min(cursor_ + CHUNK_SIZE, N);
+		auto count = end - cursor_;
+
+		std::array<float, CHUNK_SIZE> altitudeSin;
+		const auto& zenith = frame_.zenith;
+		for (std::size_t i = 0; i < count; ++i) {
+			auto j = cursor_ + i;
+			altitudeSin[i] = zenith[0] * x_[j] + zenith[1] * y_[j] + zenith[2] * z_[j];
+		}
+
+		const auto& north = frame_.north;
+		const auto& east = frame_.east;
+		for (std::size_t i = 0; i < count; ++i) {
+			if (altitudeSin[i] < mask.lowestAltitudeSin()) {
+				continue;
+			}
+			auto j = cursor_ + i;
+			auto n = north[0] * x_[j] + north[1] * y_[j] + north[2] * z_[j];
+			auto e = east[0] * x_[j] + east[1] * y_[j];
+			auto azimuth = std::atan2(e, n);
+			if (altitudeSin[i] >= mask.minAltitudeSin(azimuth < 0 ? azimuth + static_cast<float>(TWO_PI) : azimuth)) {
+				next_.set(j);
+			}
+		}
+
+		cursor_ = end;
+		if (cursor_ < N) {
+			return false;
+		}
+		visible_ = next_;
+		refreshing_ = false;
+		ready_ = true;
+		return true;
+	}
+
+	bool ready() const { return ready_; }
+	bool refreshing() const { return refreshing_; }
+	bool visible(std::size_t i) const { return visible_.test(i); }
+	std::size_t visibleCount() const { return visible_.count(); }
+	static constexpr std::size_t size() { return N; }
+
+private:
+	const float* x_;
+	const float* y_;
+	const float* z_;
+
+	HorizonFrame frame_{{0, 0}, J2000_UNIX_SECONDS};
+	std::bitset<N> visible_;
+	std::bitset<N> next_;
+	std::size_t cursor_ = 0;
+	bool refreshing_ = false;
+	bool ready_ = false;
+};
+
+}
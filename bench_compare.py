@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Compares two benchmark runs (JSON lines from `make -C sim bench` or the board's `bench` serial command, see
+# Benchmark.h) by median time, exits with 1 when a benchmark got slower than the threshold.
+#
+# python bench_compare.py before.jsonl after.jsonl
+# python bench_compare.py before.jsonl after.jsonl --threshold 5
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Returns {benchmark name: result}, skips lines that are not results (eg. serial log around them)."""
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+            try:
+                result = json.loads(line)
+            except ValueError:
+                continue
+            if 'benchmark' in result and 'median_ns' in result:
+                results[result['benchmark']] = result
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare two benchmark runs')
+    parser.add_argument('baseline', help='JSON lines of the reference run')
+    parser.add_argument('current', help='JSON lines of the run to check')
+    parser.add_argument('--threshold', type=float, default=10, help='slowdown in %% that fails, default 10')
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    if not baseline or not current:
+        sys.exit('no benchmark results in %s' % (args.baseline if not baseline else args.current))
+
+    regressions = 0
+    print('%-36s %12s %12s %8s' % ('benchmark', 'before ns', 'after ns', 'change'))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in baseline or name not in current:
+            print('%-36s %s' % (name, 'only in ' + (args.current if name in current else args.baseline)))
+            continue
+        before = baseline[name]['median_ns']
+        after = current[name]['median_ns']
+        change = (after - before) / before * 100 if before > 0 else 0
+        flag = ''
+        if change > args.threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+        if baseline[name].get('platform') != current[name].get('platform'):
+            flag += '  (platforms differ)'
+        print('%-36s %12.2f %12.2f %+7.1f%%%s' % (name, before, after, change, flag))
+    if regressions:
+        print('%d benchmark(s) slower than %g%%' % (regressions, args.threshold))
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
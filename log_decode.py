@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+# Decodes binary log frames (`log binary` serial command) using the message table in Log.h.
+# Bytes outside frames (command replies etc.) are passed through.
+#
+# python log_decode.py capture.bin
+# python log_decode.py /dev/ttyUSB0 --baud 115200    (needs pyserial)
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+FRAME_START = 0xA5
+HEADER_SIZE = 2 + 1 + 4
+ARG_SIZE = 8
+MAX_ARGS = 4
+FLOAT_CONVERSIONS = 'fFeEgGaA'
+CONVERSION = re.compile(r'%[-+ #0-9.]*([diouxXcfeEgGaA%])')
+MESSAGE = re.compile(r'X\((\w+),\s*(\w+),\s*(\w+),\s*"((?:[^"\\]|\\.)*)"\)')
+
+
+def load_messages(path):
+    with open(path, encoding='utf-8') as f:
+        text = f.read()
+    table = text[text.index('#define LOG_MESSAGES(X)'):]
+    table = table[:table.index('\n\n')]
+    return [(name, category, level, fmt) for name, category, level, fmt in MESSAGE.findall(table)]
+
+
+def format_message(fmt, args):
+    values = []
+    conversions = [c for c in CONVERSION.findall(fmt) if c != '%']
+    for conversion, raw in zip(conversions, args):
+        if conversion in FLOAT_CONVERSIONS:
+            values.append(struct.unpack('<d', raw)[0])
+        else:
+            value = struct.unpack('<i', raw[:4])[0]
+            values.append(chr(value & 0xFF) if conversion == 'c' else value)
+    if conversions and len(values) < len(conversions):
+        return fmt + ' <missing arguments>'
+    return fmt % tuple(values) if conversions else fmt.replace('%%', '%')
+
+
+def decode(data, messages, out):
+    """Decodes complete frames from `data`, returns bytes not consumed yet."""
+    i = 0
+    while i < len(data):
+        if data[i] != FRAME_START:
+            out.write(data[i:i + 1].decode('latin-1'))
+            i += 1
+            continue
+        if len(data) - i < 1 + HEADER_SIZE:
+            break
+        message_id, arg_count, timestamp = struct.unpack_from('<HBI', data, i + 1)
+        size = 1 + HEADER_SIZE + arg_count * ARG_SIZE + 1
+        if message_id >= len(messages) or arg_count > MAX_ARGS:
+            out.write(data[i:i + 1].decode('latin-1'))
+            i += 1
+            continue
+        if len(data) - i < size:
+            break
+        frame = data[i:i + size]
+        if sum(frame[1:-1]) & 0xFF != frame[-1]:
+            out.write(data[i:i + 1].decode('latin-1'))
+            i += 1
+            continue
+        name, category, level, fmt = messages[message_id]
+        args = [frame[1 + HEADER_SIZE + n * ARG_SIZE:1 + HEADER_SIZE + (n + 1) * ARG_SIZE] for n in range(arg_count)]
+        out.write('%10.6f %-5s %-9s %s\n' % (timestamp / 1e6, level.lower(), category.lower(), format_message(fmt, args)))
+        i += size
+    return data[i:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode binary log frames')
+    parser.add_argument('input', help='capture file, serial port or - for stdin')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--table', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'Log.h'))
+    args = parser.parse_args()
+
+    messages = load_messages(args.table)
+    if args.input == '-':
+        source = sys.stdin.buffer
+    elif os.path.isfile(args.input):
+        source = open(args.input, 'rb')
+    else:
+        import serial
+        source = serial.Serial(args.input, args.baud, timeout=0.1)
+
+    pending = b''
+    try:
+        while True:
+            chunk = source.read(256)
+            if not chunk:
+                if os.path.isfile(args.input) or args.input == '-':
+                    break
+                continue
+            pending = decode(pending + chunk, messages, sys.stdout)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
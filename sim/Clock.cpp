@@ -0,0 +1,53 @@
+#include "Sim.h"
+
+#include <Arduino.h>
+
+namespace sim {
+
+namespace {
+
+uint64_t now = 0;
+int64_t bootEpoch = 0;
+
+}
+
+uint64_t nowUs() { return now; }
+
+void advanceTo(uint64_t us) {
+	if (us > now) {
+		now = us;
+	}
+}
+
+int64_t bootEpochUs() { return bootEpoch; }
+void setBootEpochUs(int64_t us) { bootEpoch = us; }
+
+}
+
+// the ESP32 counters are 32 bit, micros() wraps every 71.6 minutes
+unsigned long micros() {
+	return static_cast<uint32_t>(sim::nowUs());
+}
+
+unsigned long millis() {
+	return static_cast<uint32_t>(sim::nowUs() / 1000);
+}
+
+uint32_t EspClass::getCycleCount() {
+	return static_cast<uint32_t>(sim::nowUs() * 240);
+}
+
+EspClass ESP;
+
+extern "C" {
+
+// called by the gettimeofday() and settimeofday() replacements in Time.c
+int64_t simEpochUs() {
+	return sim::bootEpochUs() + static_cast<int64_t>(sim::nowUs());
+}
+
+void simSetEpochUs(int64_t us) {
+	sim::setBootEpochUs(us - static_cast<int64_t>(sim::nowUs()));
+}
+
+}
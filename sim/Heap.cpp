@@ -0,0 +1,52 @@
+// Replaces malloc and free to count the firmware's allocations per region (HeapTracker.h), glibc's allocator does
+// the work. Catches operator new, exceptions and C code alike; the board counts operator new only.
+
+#include "HeapTracker.h"
+
+#include <cstddef>
+
+extern "C" {
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+void __libc_free(void* pointer);
+
+void* malloc(std::size_t size) noexcept {
+	auto* pointer = __libc_malloc(size);
+	if (pointer != nullptr) {
+		heap::tracker().allocated(size);
+	}
+	return pointer;
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+	auto* pointer = __libc_calloc(count, size);
+	if (pointer != nullptr) {
+		heap::tracker().allocated(count * size);
+	}
+	return pointer;
+}
+
+// a move counts as a free and an allocation
+void* realloc(void* pointer, std::size_t size) noexcept {
+	auto* moved = __libc_realloc(pointer, size);
+	if (moved != nullptr || size == 0) {
+		if (pointer != nullptr) {
+			heap::tracker().freed();
+		}
+		if (moved != nullptr) {
+			heap::tracker().allocated(size);
+		}
+	}
+	return moved;
+}
+
+void free(void* pointer) noexcept {
+	if (pointer != nullptr) {
+		heap::tracker().freed();
+	}
+	__libc_free(pointer);
+}
+
+}
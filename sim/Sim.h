@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Simulator core shared by the stubs and the driver in main.cpp. Nothing here runs on the ESP32.
+namespace sim {
+
+// Virtual clock, microseconds since boot. Only the driver advances it, firmware code never sees it move while it
+// runs, so a night of tracking takes as long as the work done in it.
+uint64_t nowUs();
+void advanceTo(uint64_t us);
+
+// gettimeofday() reads boot time plus the virtual clock, settimeofday() moves boot time
+int64_t bootEpochUs();
+void setBootEpochUs(int64_t us);
+
+// Cooperative FreeRTOS: a task runs until it blocks in vTaskDelay() or ulTaskNotifyTake(), the Arduino loop()
+// runs in the driver's own context. Runs every task ready at nowUs(), highest priority first.
+void runReadyTasks();
+// earliest wake up of a blocked task, UINT64_MAX when all wait for notifications
+uint64_t nextTaskWakeUs();
+
+}
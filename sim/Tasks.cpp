@@ -0,0 +1,178 @@
+#include "Sim.h"
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ucontext.h>
+
+namespace sim {
+
+namespace {
+
+// host code needs more than the firmware stack sizes, printf of a double alone takes a few kB
+constexpr const std::size_t STACK_SIZE = 256 * 1024;
+// CONFIG_FREERTOS_HZ of the ESP32 Arduino core is 1000
+constexpr const uint64_t TICK_US = 1000;
+constexpr const uint64_t NEVER = std::numeric_limits<uint64_t>::max();
+// the Arduino loop() task
+constexpr const UBaseType_t LOOP_PRIORITY = 1;
+constexpr const BaseType_t LOOP_CORE = 1;
+
+struct Task {
+	TaskFunction_t function;
+	void* parameter;
+	const char* name;
+	UBaseType_t priority;
+	BaseType_t core;
+	uint64_t wakeUs;
+	bool waitingNotification = false;
+	uint32_t notifications = 0;
+	std::unique_ptr<char[]> stack;
+	ucontext_t context;
+};
+
+std::vector<std::unique_ptr<Task>> tasks;
+Task* current = nullptr;
+ucontext_t driverContext;
+UBaseType_t loopPriority = LOOP_PRIORITY;
+
+void taskEntry() {
+	current->function(current->parameter);
+	// a FreeRTOS task must not return, park it
+	current->wakeUs = NEVER;
+	for (;;) {
+		swapcontext(&current->context, &driverContext);
+	}
+}
+
+// back to the driver until runReadyTasks() resumes the task
+void block() {
+	swapcontext(&current->context, &driverContext);
+}
+
+// vTaskDelay() wakes on a tick interrupt, not a full tick later
+uint64_t tickAfter(TickType_t ticks) {
+	return (nowUs() / TICK_US + ticks) * TICK_US;
+}
+
+}
+
+void runReadyTasks() {
+	for (;;) {
+		Task* next = nullptr;
+		for (auto& task : tasks) {
+			if (task->wakeUs <= nowUs() && (next == nullptr || task->priority > next->priority)) {
+				next = task.get();
+			}
+		}
+		if (next == nullptr) {
+			return;
+		}
+		current = next;
+		swapcontext(&driverContext, &next->context);
+		current = nullptr;
+	}
+}
+
+uint64_t nextTaskWakeUs() {
+	auto next = NEVER;
+	for (const auto& task : tasks) {
+		next = std::min(next, task->wakeUs);
+	}
+	return next;
+}
+
+}
+
+using sim::current;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t, void* parameter,
+		UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+	auto task = std::make_unique<sim::Task>();
+	task->function = function;
+	task->parameter = parameter;
+	task->name = name;
+	task->priority = priority;
+	task->core = core;
+	task->wakeUs = sim::nowUs();
+	task->stack = std::make_unique<char[]>(sim::STACK_SIZE);
+	if (getcontext(&task->context) != 0) {
+		return pdFAIL;
+	}
+	task->context.uc_stack.ss_sp = task->stack.get();
+	task->context.uc_stack.ss_size = sim::STACK_SIZE;
+	task->context.uc_link = nullptr;
+	makecontext(&task->context, &sim::taskEntry, 0);
+	if (handle != nullptr) {
+		*handle = task.get();
+	}
+	sim::tasks.push_back(std::move(task));
+	return pdPASS;
+}
+
+// 0 ticks yields until the next tick, the simulator has no time slices to give away
+void vTaskDelay(TickType_t ticks) {
+	if (current == nullptr) {
+		sim::advanceTo(sim::tickAfter(std::max<TickType_t>(ticks, 1)));
+		return;
+	}
+	current->wakeUs = sim::tickAfter(std::max<TickType_t>(ticks, 1));
+	sim::block();
+}
+
+void delay(unsigned long ms) {
+	vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+	auto* task = current;
+	if (task == nullptr) {
+		return 0;
+	}
+	if (task->notifications == 0 && ticks != 0) {
+		task->waitingNotification = true;
+		task->wakeUs = ticks == portMAX_DELAY ? sim::NEVER : sim::nowUs() + ticks * sim::TICK_US;
+		sim::block();
+		task->waitingNotification = false;
+	}
+	auto notifications = task->notifications;
+	if (notifications > 0) {
+		task->notifications = clearOnExit ? 0 : notifications - 1;
+	}
+	return notifications;
+}
+
+// the notified task runs once the notifying one blocks, there is no preemption
+void xTaskNotifyGive(TaskHandle_t handle) {
+	auto* task = static_cast<sim::Task*>(handle);
+	++task->notifications;
+	if (task->waitingNotification) {
+		task->wakeUs = sim::nowUs();
+	}
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+	return current;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t handle) {
+	auto* task = handle != nullptr ? static_cast<sim::Task*>(handle) : current;
+	return task != nullptr ? task->priority : sim::loopPriority;
+}
+
+void vTaskPrioritySet(TaskHandle_t handle, UBaseType_t priority) {
+	auto* task = handle != nullptr ? static_cast<sim::Task*>(handle) : current;
+	if (task != nullptr) {
+		task->priority = priority;
+	} else {
+		sim::loopPriority = priority;
+	}
+}
+
+BaseType_t xPortGetCoreID() {
+	return current != nullptr ? current->core : sim::LOOP_CORE;
+}
@@ -0,0 +1,34 @@
+// Replaces the libc wall clock with the virtual one. <sys/time.h> is not included, its prototypes differ
+// between libc versions, the layout below is the one of 64 bit Linux.
+
+#include <stdint.h>
+
+struct timeval {
+	long tv_sec;
+	long tv_usec;
+};
+
+int64_t simEpochUs(void);
+void simSetEpochUs(int64_t us);
+
+int gettimeofday(struct timeval* tv, void* tz) {
+	(void)tz;
+	if (tv != 0) {
+		int64_t us = simEpochUs();
+		tv->tv_sec = us / 1000000;
+		tv->tv_usec = us % 1000000;
+		if (tv->tv_usec < 0) {
+			tv->tv_sec -= 1;
+			tv->tv_usec += 1000000;
+		}
+	}
+	return 0;
+}
+
+int settimeofday(const struct timeval* tv, const void* tz) {
+	(void)tz;
+	if (tv != 0) {
+		simSetEpochUs((int64_t)tv->tv_sec * 1000000 + tv->tv_usec);
+	}
+	return 0;
+}
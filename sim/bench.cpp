@@ -0,0 +1,132 @@
+// Runs the firmware's benchmark suite (BenchmarkSuite.h) on the host, timed with the steady clock. The same suite
+// runs on the board with the `bench` serial command. See sim/README.md.
+
+#include "Sim.h"
+
+#include <AccelStepper.h>
+#include <Arduino.h>
+#include <PS4Controller.h>
+#include <U8g2lib.h>
+
+#include "BenchmarkSuite.h"
+#include "ScreenUI.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+HardwareSerial Serial;
+PS4Controller PS4;
+
+namespace {
+
+struct Options {
+	const char* filter = nullptr;
+	const char* outPath = nullptr;
+	std::size_t samples = 21;
+	double sampleMs = 1;
+};
+
+// writes the JSON lines to stdout or a file
+class FilePrint : public Print {
+public:
+	explicit FilePrint(std::FILE* file) : file_(file) {}
+
+	size_t write(uint8_t byte) override { return std::fputc(byte, file_) == EOF ? 0 : 1; }
+	size_t write(const uint8_t* buffer, size_t size) override { return std::fwrite(buffer, 1, size, file_); }
+	using Print::write;
+
+private:
+	std::FILE* file_;
+};
+
+void usage() {
+	std::fprintf(stderr,
+		"Usage: stars-tracker-bench [options]\n"
+		"  --filter <prefix>     only benchmarks whose name starts with it\n"
+		"  --samples <n>         timed batches per benchmark, default 21\n"
+		"  --sample-ms <ms>      minimum batch duration, default 1\n"
+		"  --out <file>          JSON lines, default stdout\n");
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string option = argv[i];
+		auto value = [&]() -> const char* {
+			return i + 1 < argc ? argv[++i] : nullptr;
+		};
+		if (option == "--filter") {
+			if ((options.filter = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--samples") {
+			auto* text = value();
+			if (text == nullptr || std::atoi(text) <= 0) {
+				return false;
+			}
+			options.samples = std::atoi(text);
+		} else if (option == "--sample-ms") {
+			auto* text = value();
+			if (text == nullptr || (options.sampleMs = std::atof(text)) <= 0) {
+				return false;
+			}
+		} else if (option == "--out") {
+			if ((options.outPath = value()) == nullptr) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t steadyClockNs() {
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		usage();
+		return 2;
+	}
+	std::FILE* out = stdout;
+	if (options.outPath != nullptr && (out = std::fopen(options.outPath, "w")) == nullptr) {
+		std::perror(options.outPath);
+		return 1;
+	}
+
+	U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI u8g2(U8G2_R0, 5, 17, 16);
+	u8g2.begin();
+	AccelStepper stepperX([]() {}, []() {});
+	AccelStepper stepperY([]() {}, []() {});
+	scope::Mount mount(stepperX, stepperY);
+	scope::Sky sky(mount);
+	ui::ScreenUI screen(u8g2, mount, sky);
+	bench::Fixture fixture = {u8g2, mount, sky, screen};
+
+	FilePrint print(out);
+	bench::Runner::Options runnerOptions;
+	runnerOptions.platform = "host";
+	runnerOptions.clock = steadyClockNs;
+	runnerOptions.nsPerTick = 1;
+	runnerOptions.sampleNs = static_cast<uint32_t>(options.sampleMs * 1e6);
+	runnerOptions.samples = options.samples;
+	runnerOptions.filter = options.filter;
+	bench::Runner runner(print, runnerOptions);
+	bench::runSuite(runner, fixture);
+
+	if (out != stdout) {
+		std::fclose(out);
+	}
+	if (runner.completed() == 0) {
+		std::fprintf(stderr, "No benchmark matches\n");
+		return 1;
+	}
+	return 0;
+}
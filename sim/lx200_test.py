@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+# Drives the LX200 server (Lx200.h) of the simulator through its pseudo terminal like a planetarium client and checks
+# the replies: position, target, goto, sync, stop, guide pulses, precision toggle and the ACK query, with a serial
+# command in between. Exits with 1 on the first wrong reply. Runs in real time, about half a minute.
+#
+# make -C sim lx200-test
+# python sim/lx200_test.py sim/build/stars-tracker-sim
+
+import argparse
+import os
+import re
+import select
+import subprocess
+import sys
+import time
+import tty
+
+UTC = '2026-10-19T20:00:00'
+# Betelgeuse, then a goto to Bellatrix
+SYNC_RA, SYNC_DEC = '05:55:10', '+07*24\'25'
+GOTO_RA, GOTO_DEC = '05:25:08', '+06*20\'59'
+GOTO_TIMEOUT_S = 60
+# RA moves on 1 s per s until tracking starts, allow for the test's pace and slew accuracy
+RA_TOLERANCE_S = 30
+DEC_TOLERANCE_ARCSEC = 120
+
+
+class Failure(Exception):
+    pass
+
+
+class Port:
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+
+    def send(self, text):
+        os.write(self.fd, text.encode('ascii'))
+
+    def read(self, timeout_s, until=None, count=None):
+        """Bytes until `until` is read, `count` bytes are read or `timeout_s` passed."""
+        data = b''
+        deadline = time.monotonic() + timeout_s
+        while True:
+            if until is not None and data.endswith(until):
+                break
+            if count is not None and len(data) >= count:
+                break
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                break
+            ready, _, _ = select.select([self.fd], [], [], remaining)
+            if ready:
+                data += os.read(self.fd, 1)
+        return data.decode('ascii', 'replace')
+
+    def command(self, text, reply=None, pattern=None, count=None, timeout_s=2):
+        """Sends `text`, checks the reply equals `reply` or matches `pattern`, returns it."""
+        self.send(text)
+        if reply is not None:
+            count = len(reply)
+        until = None if count is not None else b'#'
+        answer = self.read(timeout_s, until=until, count=count)
+        if reply is not None and answer != reply:
+            raise Failure('%r: expected %r, got %r' % (text, reply, answer))
+        if pattern is not None and not re.fullmatch(pattern, answer):
+            raise Failure('%r: %r does not match %s' % (text, answer, pattern))
+        return answer
+
+    def silent(self, text):
+        self.send(text)
+        answer = self.read(0.3)
+        if answer:
+            raise Failure('%r: expected no reply, got %r' % (text, answer))
+
+
+def ra_seconds(text):
+    hours, minutes, seconds = re.fullmatch(r'(\d\d):(\d\d):(\d\d)#?', text).groups()
+    return int(hours) * 3600 + int(minutes) * 60 + int(seconds)
+
+
+def dec_arcsec(text):
+    sign, degrees, minutes, seconds = re.fullmatch(r"([+-])(\d\d)\*(\d\d)'(\d\d)#?", text).groups()
+    value = int(degrees) * 3600 + int(minutes) * 60 + int(seconds)
+    return -value if sign == '-' else value
+
+
+def near(port, ra, dec):
+    """True when the reported position is within the tolerances of `ra` and `dec` (LX200 text)."""
+    ra_delta = abs(ra_seconds(port.command(':GR#', pattern=r'\d\d:\d\d:\d\d#')) - ra_seconds(ra))
+    dec_delta = abs(dec_arcsec(port.command(':GD#', pattern=r"[+-]\d\d\*\d\d'\d\d#")) - dec_arcsec(dec))
+    return min(ra_delta, 86400 - ra_delta) <= RA_TOLERANCE_S and dec_delta <= DEC_TOLERANCE_ARCSEC
+
+
+def run(port):
+    # EQ mount by default, nothing aligned yet
+    port.command('\x06', reply='P')
+    port.command(':GVP#', reply='stars-tracker#')
+    port.command(':GR#', reply='00:00:00#')
+    port.command(':GD#', reply="+00*00'00#")
+    port.command(':MS#', reply='2Not aligned#')
+    port.command(':CM#', reply='Sync failed#')
+
+    port.command(':Sr25:00:00#', reply='0')
+    port.command(':Sd+91*00\'00#', reply='0')
+    port.command(':Sdabc#', reply='0')
+    port.command(':MS#', reply='2Not aligned#')
+
+    port.command(':Sr%s#' % SYNC_RA, reply='1')
+    port.command(':Sd%s#' % SYNC_DEC, reply='1')
+    port.command(':CM#', reply='Coordinates matched#')
+    time.sleep(0.2)
+    if not near(port, SYNC_RA, SYNC_DEC):
+        raise Failure('position after sync is not the synced target')
+
+    # low precision, then back
+    port.silent(':U#')
+    port.command(':GR#', pattern=r'\d\d:\d\d\.\d#')
+    port.command(':GD#', pattern=r'[+-]\d\d\*\d\d#')
+    port.silent(':U#')
+    port.command(':GR#', pattern=r'\d\d:\d\d:\d\d#')
+
+    # a serial command line shares the port
+    port.send('heap\r\n')
+    line = port.read(2, until=b'\n')
+    if not line.startswith('heap:'):
+        raise Failure('heap: expected a heap line, got %r' % line)
+    port.command(':GVP#', reply='stars-tracker#')
+
+    port.command(':Sr%s#' % GOTO_RA, reply='1')
+    port.command(':Sd%s#' % GOTO_DEC, reply='1')
+    port.command(':MS#', reply='0')
+    deadline = time.monotonic() + GOTO_TIMEOUT_S
+    while not near(port, GOTO_RA, GOTO_DEC):
+        if time.monotonic() > deadline:
+            raise Failure('goto did not reach %s %s in %d s' % (GOTO_RA, GOTO_DEC, GOTO_TIMEOUT_S))
+        time.sleep(0.5)
+
+    # jog, stop, guide pulses: no replies, the server keeps answering
+    port.silent(':RC#')
+    port.silent(':Mn#')
+    port.silent(':Qn#')
+    port.silent(':Q#')
+    port.silent(':Mgn500#')
+    port.silent(':Mgw500#')
+    port.silent(':Mgx500#')
+    port.command(':GVP#', reply='stars-tracker#')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check the LX200 server of the simulator through its pseudo terminal')
+    parser.add_argument('sim', help='stars-tracker-sim binary')
+    args = parser.parse_args()
+
+    process = subprocess.Popen([args.sim, '--pty', '--utc', UTC, '--duration', str(GOTO_TIMEOUT_S + 60)],
+        stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    try:
+        path = None
+        for line in process.stderr:
+            match = re.match(r'Serial port: (\S+)', line)
+            if match:
+                path = match.group(1)
+                break
+        if path is None:
+            sys.exit('simulator did not open a serial port')
+        port = Port(path)
+        # let the firmware boot
+        time.sleep(1)
+        port.read(0.5)
+        run(port)
+    except Failure as failure:
+        print('FAIL %s' % failure)
+        sys.exit(1)
+    finally:
+        process.terminate()
+        process.wait()
+    print('lx200: all replies as expected')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,650 @@
+// Runs the firmware on the host: setup(), then loop() and the FreeRTOS tasks on a virtual clock that jumps from
+// one event (task wake up, step pulse, script entry) to the next. See sim/README.md.
+
+#include "Sim.h"
+
+#include <AccelStepper.h>
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <PS4Controller.h>
+#include <U8g2lib.h>
+
+#include "HeapTracker.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+void setup();
+void loop();
+
+HardwareSerial Serial;
+PS4Controller PS4;
+
+// the sketch's display, for screenshots
+extern U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI u8g2;
+extern trace::Replayer replayer;
+
+namespace {
+
+// the sketch's trace files on the simulated flash
+constexpr const char* TRACE_MODE_FILE = "trace.mode";
+constexpr const char* TRACE_FILE = "trace.bin";
+constexpr const char* REPLAY_FILE = "sim-replay.bin";
+
+struct Options {
+	double durationS = 60;
+	bool durationSet = false;
+	// wall clock at boot, unix time in us, the board starts at 0
+	int64_t bootEpochUs = 0;
+	const char* scriptPath = nullptr;
+	const char* stepsPath = nullptr;
+	const char* screenshotPath = nullptr;
+	// host directory of the flash, a temporary one when not given
+	const char* fsPath = nullptr;
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+	// regions that must not allocate, bit per heap::RegionId
+	uint32_t noAllocRegions = 0;
+	bool interactive = false;
+	bool pty = false;
+	bool realtime = false;
+	bool quiet = false;
+};
+
+// one script line: at `timeUs` send `text` as a serial line, or run a '!' directive
+struct ScriptEntry {
+	uint64_t timeUs;
+	std::string text;
+	int line;
+};
+
+void usage() {
+	std::fprintf(stderr,
+		"Usage: stars-tracker-sim [options]\n"
+		"  --duration <s>        simulated time, default 60\n"
+		"  --utc <yyyy-mm-ddThh:mm:ss>  wall clock at boot, default 1970 as on the board\n"
+		"  --script <file>       timed serial lines and controller input\n"
+		"  --steps <file>        step log, CSV: us,axis,position\n"
+		"  --screenshot <file>   display content at the end, PBM\n"
+		"  --fs <dir>            flash (LittleFS) content, default a temporary directory\n"
+		"  --record <file>       record a trace from boot into file\n"
+		"  --replay <file>       replay a trace from boot, duration defaults to the trace's\n"
+		"  --no-allocs <regions> fail when these regions (motion,input,screen,..) allocated since boot or `allocs reset`\n"
+		"  --stdin               serial input from stdin, runs in real time\n"
+		"  --pty                 serial port on a pseudo terminal (LX200 clients), runs in real time\n"
+		"  --realtime            pace the virtual clock to the wall clock\n"
+		"  --quiet               do not print serial output\n");
+}
+
+bool parseUtc(const char* text, int64_t& result) {
+	std::tm time{};
+	char* end = strptime(text, "%Y-%m-%dT%H:%M:%S", &time);
+	if (end == nullptr || *end != '\0') {
+		return false;
+	}
+	result = static_cast<int64_t>(timegm(&time)) * 1000000;
+	return true;
+}
+
+// comma separated heap region names
+bool parseRegions(const char* text, uint32_t& mask) {
+	std::stringstream list(text);
+	std::string name;
+	while (std::getline(list, name, ',')) {
+		auto* names = std::begin(heap::REGION_NAMES);
+		auto* found = std::find_if(names, std::end(heap::REGION_NAMES), [&](const char* region) { return name == region; });
+		if (found == std::end(heap::REGION_NAMES)) {
+			std::fprintf(stderr, "Unknown region %s\n", name.c_str());
+			return false;
+		}
+		mask |= 1u << (found - names);
+	}
+	return mask != 0;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string option = argv[i];
+		auto value = [&]() -> const char* {
+			return i + 1 < argc ? argv[++i] : nullptr;
+		};
+		if (option == "--duration") {
+			auto* text = value();
+			if (text == nullptr || (options.durationS = std::atof(text)) <= 0) {
+				return false;
+			}
+			options.durationSet = true;
+		} else if (option == "--utc") {
+			auto* text = value();
+			if (text == nullptr || !parseUtc(text, options.bootEpochUs)) {
+				return false;
+			}
+		} else if (option == "--script") {
+			if ((options.scriptPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--steps") {
+			if ((options.stepsPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--screenshot") {
+			if ((options.screenshotPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--fs") {
+			if ((options.fsPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--record") {
+			if ((options.recordPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--replay") {
+			if ((options.replayPath = value()) == nullptr) {
+				return false;
+			}
+		} else if (option == "--no-allocs") {
+			auto* text = value();
+			if (text == nullptr || !parseRegions(text, options.noAllocRegions)) {
+				return false;
+			}
+		} else if (option == "--stdin") {
+			options.interactive = true;
+			options.realtime = true;
+		} else if (option == "--pty") {
+			options.pty = true;
+			options.realtime = true;
+		} else if (option == "--realtime") {
+			options.realtime = true;
+		} else if (option == "--quiet") {
+			options.quiet = true;
+		} else {
+			return false;
+		}
+	}
+	return options.recordPath == nullptr || options.replayPath == nullptr;
+}
+
+// "<s> text" at `s` seconds after boot, "+<s> text" after the previous entry, '#' starts a comment line
+bool loadScript(const char* path, std::vector<ScriptEntry>& entries) {
+	std::ifstream file(path);
+	if (!file) {
+		std::fprintf(stderr, "Can not open %s\n", path);
+		return false;
+	}
+	std::string line;
+	double previousS = 0;
+	for (int number = 1; std::getline(file, line); ++number) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		auto start = line.find_first_not_of(" \t");
+		if (start == std::string::npos || line[start] == '#') {
+			continue;
+		}
+		auto relative = line[start] == '+';
+		char* end = nullptr;
+		auto timeS = std::strtod(line.c_str() + start + (relative ? 1 : 0), &end);
+		if (end == line.c_str() + start || (*end != ' ' && *end != '\t' && *end != '\0')) {
+			std::fprintf(stderr, "%s:%d: missing time\n", path, number);
+			return false;
+		}
+		timeS += relative ? previousS : 0;
+		if (timeS < previousS) {
+			std::fprintf(stderr, "%s:%d: time goes back\n", path, number);
+			return false;
+		}
+		previousS = timeS;
+		std::string text = end;
+		text.erase(0, text.find_first_not_of(" \t"));
+		entries.push_back({static_cast<uint64_t>(timeS * 1e6), text, number});
+	}
+	return true;
+}
+
+// \r \n \\ and \xHH
+std::string unescape(const std::string& text) {
+	std::string result;
+	for (std::size_t i = 0; i < text.size(); ++i) {
+		if (text[i] != '\\' || i + 1 == text.size()) {
+			result += text[i];
+			continue;
+		}
+		auto next = text[++i];
+		if (next == 'r') {
+			result += '\r';
+		} else if (next == 'n') {
+			result += '\n';
+		} else if (next == 'x' && i + 2 < text.size()) {
+			result += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+			i += 2;
+		} else {
+			result += next;
+		}
+	}
+	return result;
+}
+
+bool buttonBit(const std::string& name, ps4_button_t& buttons) {
+	if (name == "up") {
+		buttons.up = 1;
+	} else if (name == "down") {
+		buttons.down = 1;
+	} else if (name == "left") {
+		buttons.left = 1;
+	} else if (name == "right") {
+		buttons.right = 1;
+	} else if (name == "cross") {
+		buttons.cross = 1;
+	} else if (name == "circle") {
+		buttons.circle = 1;
+	} else if (name == "square") {
+		buttons.square = 1;
+	} else if (name == "triangle") {
+		buttons.triangle = 1;
+	} else if (name == "l1") {
+		buttons.l1 = 1;
+	} else if (name == "r1") {
+		buttons.r1 = 1;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+// P4 bitmap of what the display shows
+bool writeScreenshot(const char* path) {
+	auto* file = std::fopen(path, "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	auto width = u8g2.getDisplayWidth();
+	auto height = u8g2.getDisplayHeight();
+	std::fprintf(file, "P4\n%d %d\n", width, height);
+	for (int y = 0; y < height; ++y) {
+		for (int x = 0; x < width; x += 8) {
+			uint8_t byte = 0;
+			for (int bit = 0; bit < 8; ++bit) {
+				byte |= u8g2.displayPixel(x + bit, y) ? 0x80 >> bit : 0;
+			}
+			std::fputc(byte, file);
+		}
+	}
+	return std::fclose(file) == 0;
+}
+
+FILE* stepLog = nullptr;
+uint64_t stepCounts[AccelStepper::MAX_INSTANCES] = {};
+
+std::size_t stepperIndex(const AccelStepper& stepper) {
+	for (std::size_t i = 0; i < AccelStepper::instanceCount(); ++i) {
+		if (&AccelStepper::instance(i) == &stepper) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+void onStep(const AccelStepper& stepper, long position) {
+	auto index = stepperIndex(stepper);
+	++stepCounts[index];
+	if (stepLog != nullptr) {
+		// sketch order: stepper1 is the X axis, stepper2 the Y axis
+		std::fprintf(stepLog, "%" PRIu64 ",%c,%ld\n", sim::nowUs(), index == 0 ? 'x' : 'y', position);
+	}
+}
+
+class Driver {
+public:
+	explicit Driver(const Options& options) : options_(options), durationS_(options.durationS) {}
+
+	~Driver() {
+		if (temporaryFs_) {
+			std::error_code error;
+			std::filesystem::remove_all(LittleFS.root(), error);
+		}
+	}
+
+	bool begin() {
+		sim::setBootEpochUs(options_.bootEpochUs);
+		heap::tracker().enable(options_.noAllocRegions != 0);
+		if (!setupFlash()) {
+			return false;
+		}
+		if (options_.scriptPath != nullptr && !loadScript(options_.scriptPath, script_)) {
+			return false;
+		}
+		if (options_.stepsPath != nullptr) {
+			stepLog = std::fopen(options_.stepsPath, "w");
+			if (stepLog == nullptr) {
+				std::fprintf(stderr, "Can not open %s\n", options_.stepsPath);
+				return false;
+			}
+			std::fputs("us,axis,position\n", stepLog);
+		}
+		AccelStepper::setStepListener(&onStep);
+		outputFd_ = STDOUT_FILENO;
+		if (options_.pty && !openPty()) {
+			return false;
+		}
+		if (options_.interactive) {
+			fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+		}
+		return true;
+	}
+
+	// false when a replay went another way than its recording
+	bool run() {
+		auto endUs = static_cast<uint64_t>(durationS_ * 1e6);
+		wallStart_ = std::chrono::steady_clock::now();
+		setup();
+		while (!stopped_ && sim::nowUs() < endUs) {
+			readInput();
+			loop();
+			sim::runReadyTasks();
+			writeOutput();
+			auto next = std::min(nextEventUs(), endUs);
+			if (options_.realtime) {
+				std::this_thread::sleep_until(wallStart_ + std::chrono::microseconds(next));
+			}
+			sim::advanceTo(std::max(next, sim::nowUs() + 1));
+		}
+		writeOutput();
+		if (options_.screenshotPath != nullptr && !writeScreenshot(options_.screenshotPath)) {
+			std::fprintf(stderr, "Can not write %s\n", options_.screenshotPath);
+		}
+		if (stepLog != nullptr) {
+			std::fclose(stepLog);
+		}
+		auto traceOk = finishTrace();
+		auto allocationsOk = checkAllocations();
+		summary();
+		return traceOk && allocationsOk;
+	}
+
+private:
+	// The sketch reads its trace mode from the flash in setup(), a recording or replay is set up like the
+	// `trace` command does it on the board.
+	bool setupFlash() {
+		std::string root;
+		if (options_.fsPath != nullptr) {
+			root = options_.fsPath;
+		} else {
+			char temporary[] = "/tmp/stars-tracker-sim-XXXXXX";
+			if (mkdtemp(temporary) == nullptr) {
+				std::perror("mkdtemp");
+				return false;
+			}
+			root = temporary;
+			temporaryFs_ = true;
+		}
+		LittleFS.setRoot(root);
+		std::error_code error;
+		auto modePath = std::filesystem::path(root) / TRACE_MODE_FILE;
+		if (options_.replayPath != nullptr) {
+			std::filesystem::copy_file(options_.replayPath, std::filesystem::path(root) / REPLAY_FILE,
+				std::filesystem::copy_options::overwrite_existing, error);
+			if (error) {
+				std::fprintf(stderr, "Can not copy %s: %s\n", options_.replayPath, error.message().c_str());
+				return false;
+			}
+			std::ofstream(modePath) << "replay /" << REPLAY_FILE << "\n";
+			if (!options_.durationSet && !traceDuration(durationS_)) {
+				std::fprintf(stderr, "%s is not a trace\n", options_.replayPath);
+				return false;
+			}
+		} else if (options_.recordPath != nullptr) {
+			std::ofstream(modePath) << "record\n";
+		}
+		return true;
+	}
+
+	// time of the last record plus a second for the firmware to act on it
+	bool traceDuration(double& durationS) const {
+		auto file = LittleFS.open((std::string("/") + REPLAY_FILE).c_str(), "r");
+		trace::Reader reader;
+		if (!file || !reader.begin(file)) {
+			return false;
+		}
+		trace::Record record;
+		uint32_t lastUs = 0;
+		while (reader.next(record)) {
+			lastUs = record.timestampUs;
+		}
+		durationS = lastUs / 1e6 + 1;
+		return !reader.corrupt();
+	}
+
+	// Stops the recorder, lets its task write the rest and copies the trace out. Reports the replay.
+	bool finishTrace() {
+		if (options_.recordPath != nullptr) {
+			AccelStepper::setStepListener(nullptr);
+			trace::recorder().stop();
+			while (trace::recorder().active()) {
+				sim::advanceTo(std::max(sim::nextTaskWakeUs(), sim::nowUs() + 1));
+				sim::runReadyTasks();
+			}
+			std::error_code error;
+			std::filesystem::copy_file(std::filesystem::path(LittleFS.root()) / TRACE_FILE, options_.recordPath,
+				std::filesystem::copy_options::overwrite_existing, error);
+			if (error) {
+				std::fprintf(stderr, "Can not copy trace to %s: %s\n", options_.recordPath, error.message().c_str());
+				return false;
+			}
+			std::fprintf(stderr, "trace: %lu records, %lu bytes, %lu dropped\n", static_cast<unsigned long>(trace::recorder().records()),
+				static_cast<unsigned long>(trace::recorder().bytes()), static_cast<unsigned long>(trace::recorder().dropped()));
+			return trace::recorder().dropped() == 0;
+		}
+		if (options_.replayPath != nullptr) {
+			const auto& stats = replayer.stats();
+			std::fprintf(stderr, "replay: %lu records, checkpoints %lu diverged %lu, lost %lu%s%s\n",
+				static_cast<unsigned long>(stats.records), static_cast<unsigned long>(stats.checkpoints),
+				static_cast<unsigned long>(stats.diverged), static_cast<unsigned long>(stats.lost),
+				stats.corrupt ? ", trace damaged" : "", replayer.active() ? ", not finished" : "");
+			return stats.diverged == 0 && stats.lost == 0 && !stats.corrupt;
+		}
+		return true;
+	}
+
+	// regions of --no-allocs that allocated
+	bool checkAllocations() const {
+		auto ok = true;
+		for (std::size_t i = 0; i < static_cast<std::size_t>(heap::RegionId::count); ++i) {
+			if ((options_.noAllocRegions & (1u << i)) == 0) {
+				continue;
+			}
+			auto counts = heap::tracker().counts(static_cast<heap::RegionId>(i));
+			if (counts.allocations > 0) {
+				std::fprintf(stderr, "allocs: %s allocated %lu times, %lu bytes\n", heap::REGION_NAMES[i],
+					static_cast<unsigned long>(counts.allocations), static_cast<unsigned long>(counts.bytes));
+				ok = false;
+			}
+		}
+		if (ok && options_.noAllocRegions != 0) {
+			std::fprintf(stderr, "allocs: none in the checked regions\n");
+		}
+		return ok;
+	}
+
+	bool openPty() {
+		ptyFd_ = posix_openpt(O_RDWR | O_NOCTTY);
+		if (ptyFd_ < 0 || grantpt(ptyFd_) != 0 || unlockpt(ptyFd_) != 0) {
+			std::perror("pty");
+			return false;
+		}
+		termios settings;
+		tcgetattr(ptyFd_, &settings);
+		cfmakeraw(&settings);
+		tcsetattr(ptyFd_, TCSANOW, &settings);
+		fcntl(ptyFd_, F_SETFL, fcntl(ptyFd_, F_GETFL) | O_NONBLOCK);
+		std::fprintf(stderr, "Serial port: %s\n", ptsname(ptyFd_));
+		outputFd_ = ptyFd_;
+		return true;
+	}
+
+	void readInput() {
+		while (nextEntry_ < script_.size() && script_[nextEntry_].timeUs <= sim::nowUs()) {
+			execute(script_[nextEntry_++]);
+		}
+		char buffer[256];
+		if (options_.interactive) {
+			ssize_t length;
+			while ((length = ::read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+				// terminals end lines with "\n", the firmware expects the serial monitor's "\r\n"
+				for (ssize_t i = 0; i < length; ++i) {
+					if (buffer[i] == '\n') {
+						Serial.feed("\r", 1);
+					}
+					Serial.feed(buffer + i, 1);
+				}
+			}
+			if (length == 0) {
+				stopped_ = true;
+			}
+		}
+		if (ptyFd_ >= 0) {
+			ssize_t length;
+			while ((length = ::read(ptyFd_, buffer, sizeof(buffer))) > 0) {
+				Serial.feed(buffer, length);
+			}
+		}
+	}
+
+	void execute(const ScriptEntry& entry) {
+		if (entry.text.empty() || entry.text[0] != '!') {
+			auto line = entry.text + "\r\n";
+			Serial.feed(line.data(), line.size());
+			return;
+		}
+		std::istringstream words(entry.text.substr(1));
+		std::string directive;
+		words >> directive;
+		std::string argument;
+		if (directive == "press" || directive == "down" || directive == "up") {
+			ps4_button_t down{};
+			ps4_button_t up{};
+			words >> argument;
+			if (!buttonBit(argument, directive == "up" ? up : down)) {
+				return fail(entry, "unknown button");
+			}
+			PS4.report(down, up, PS4.stick(0), PS4.stick(1), PS4.stick(2), PS4.stick(3));
+			if (directive == "press") {
+				PS4.report(up, down, PS4.stick(0), PS4.stick(1), PS4.stick(2), PS4.stick(3));
+			}
+		} else if (directive == "sticks") {
+			int sticks[4];
+			for (auto& stick : sticks) {
+				if (!(words >> stick) || stick < -128 || stick > 127) {
+					return fail(entry, "sticks need 4 values -128 : 127");
+				}
+			}
+			PS4.report({}, {}, sticks[0], sticks[1], sticks[2], sticks[3]);
+		} else if (directive == "disconnect") {
+			PS4.disconnect();
+		} else if (directive == "raw") {
+			std::getline(words >> std::ws, argument);
+			auto bytes = unescape(argument);
+			Serial.feed(bytes.data(), bytes.size());
+		} else if (directive == "screenshot") {
+			words >> argument;
+			if (argument.empty() || !writeScreenshot(argument.c_str())) {
+				return fail(entry, "can not write screenshot");
+			}
+		} else if (directive == "end") {
+			stopped_ = true;
+		} else {
+			fail(entry, "unknown directive");
+		}
+	}
+
+	void fail(const ScriptEntry& entry, const char* message) {
+		std::fprintf(stderr, "%s:%d: %s\n", options_.scriptPath, entry.line, message);
+	}
+
+	void writeOutput() {
+		auto output = Serial.takeOutput();
+		if (options_.quiet && ptyFd_ < 0) {
+			return;
+		}
+		std::size_t written = 0;
+		while (written < output.size()) {
+			auto length = ::write(outputFd_, output.data() + written, output.size() - written);
+			if (length <= 0) {
+				// nobody reads the pty
+				break;
+			}
+			written += length;
+		}
+	}
+
+	uint64_t nextEventUs() const {
+		auto now = sim::nowUs();
+		auto next = sim::nextTaskWakeUs();
+		for (std::size_t i = 0; i < AccelStepper::instanceCount(); ++i) {
+			uint32_t stepUs = 0;
+			if (AccelStepper::instance(i).nextStepUs(stepUs)) {
+				auto delay = static_cast<int32_t>(stepUs - static_cast<uint32_t>(now));
+				next = std::min(next, now + std::max(delay, 0));
+			}
+		}
+		if (nextEntry_ < script_.size()) {
+			next = std::min(next, script_[nextEntry_].timeUs);
+		}
+		if (options_.interactive || ptyFd_ >= 0) {
+			// poll the input every tick
+			next = std::min(next, now + 1000);
+		}
+		return next;
+	}
+
+	void summary() const {
+		auto wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart_).count();
+		auto simulatedS = sim::nowUs() / 1e6;
+		std::fprintf(stderr, "simulated %.3f s in %.3f s (%.0fx)\n", simulatedS, wallS, wallS > 0 ? simulatedS / wallS : 0);
+		for (std::size_t i = 0; i < AccelStepper::instanceCount(); ++i) {
+			auto& stepper = AccelStepper::instance(i);
+			std::fprintf(stderr, "%c axis: %" PRIu64 " steps, position %ld\n", i == 0 ? 'x' : 'y', stepCounts[i],
+				stepper.currentPosition());
+		}
+	}
+
+	const Options& options_;
+	double durationS_;
+	bool temporaryFs_ = false;
+	std::vector<ScriptEntry> script_;
+	std::size_t nextEntry_ = 0;
+	int outputFd_ = STDOUT_FILENO;
+	int ptyFd_ = -1;
+	bool stopped_ = false;
+	std::chrono::steady_clock::time_point wallStart_;
+};
+
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		usage();
+		return 2;
+	}
+	Driver driver(options);
+	if (!driver.begin()) {
+		return 1;
+	}
+	return driver.run() ? 0 : 1;
+}
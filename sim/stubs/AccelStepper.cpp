@@ -0,0 +1,158 @@
+#include "AccelStepper.h"
+
+#include <algorithm>
+#include <cmath>
+
+AccelStepper* AccelStepper::instances_[MAX_INSTANCES];
+std::size_t AccelStepper::instanceCount_ = 0;
+AccelStepper::StepListener AccelStepper::stepListener_ = nullptr;
+
+AccelStepper::AccelStepper(uint8_t, uint8_t stepPin, uint8_t, uint8_t, uint8_t, bool) : stepPin_(stepPin) {
+	if (instanceCount_ < MAX_INSTANCES) {
+		instances_[instanceCount_++] = this;
+	}
+	setAcceleration(1);
+}
+
+AccelStepper::AccelStepper(void (*forward)(), void (*backward)()) : stepPin_(0xFF), forward_(forward), backward_(backward) {
+	setAcceleration(1);
+}
+
+void AccelStepper::moveTo(long absolute) {
+	if (targetPosition_ != absolute) {
+		targetPosition_ = absolute;
+		computeNewSpeed();
+	}
+}
+
+void AccelStepper::move(long relative) {
+	moveTo(currentPosition_ + relative);
+}
+
+bool AccelStepper::runSpeed() {
+	if (stepInterval_ == 0) {
+		return false;
+	}
+	uint32_t now = micros();
+	if (now - lastStepUs_ < stepInterval_) {
+		return false;
+	}
+	currentPosition_ += direction_ == CW ? 1 : -1;
+	if (forward_ != nullptr) {
+		(direction_ == CW ? forward_ : backward_)();
+	} else if (stepListener_ != nullptr) {
+		stepListener_(*this, currentPosition_);
+	}
+	lastStepUs_ = now;
+	return true;
+}
+
+bool AccelStepper::run() {
+	if (runSpeed()) {
+		computeNewSpeed();
+	}
+	return speed_ != 0 || distanceToGo() != 0;
+}
+
+void AccelStepper::computeNewSpeed() {
+	auto distance = distanceToGo();
+	auto stepsToStop = static_cast<long>((speed_ * speed_) / (2.0f * acceleration_));
+	if (distance == 0 && stepsToStop <= 1) {
+		stepInterval_ = 0;
+		speed_ = 0;
+		n_ = 0;
+		return;
+	}
+	if (distance > 0) {
+		if (n_ > 0) {
+			if (stepsToStop >= distance || direction_ == CCW) {
+				n_ = -stepsToStop;
+			}
+		} else if (n_ < 0) {
+			if (stepsToStop < distance && direction_ == CW) {
+				n_ = -n_;
+			}
+		}
+	} else if (distance < 0) {
+		if (n_ > 0) {
+			if (stepsToStop >= -distance || direction_ == CW) {
+				n_ = -stepsToStop;
+			}
+		} else if (n_ < 0) {
+			if (stepsToStop < -distance && direction_ == CCW) {
+				n_ = -n_;
+			}
+		}
+	}
+	if (n_ == 0) {
+		cn_ = c0_;
+		direction_ = distance > 0 ? CW : CCW;
+	} else {
+		cn_ = cn_ - (2.0f * cn_) / (4.0f * n_ + 1);
+		cn_ = std::max(cn_, cmin_);
+	}
+	++n_;
+	stepInterval_ = static_cast<uint32_t>(cn_);
+	speed_ = 1000000.0f / cn_;
+	if (direction_ == CCW) {
+		speed_ = -speed_;
+	}
+}
+
+void AccelStepper::setMaxSpeed(float speed) {
+	speed = std::fabs(speed);
+	if (maxSpeed_ == speed) {
+		return;
+	}
+	maxSpeed_ = speed;
+	cmin_ = 1000000.0f / speed;
+	if (n_ > 0) {
+		n_ = static_cast<long>((speed_ * speed_) / (2.0f * acceleration_));
+		computeNewSpeed();
+	}
+}
+
+void AccelStepper::setAcceleration(float acceleration) {
+	if (acceleration == 0) {
+		return;
+	}
+	acceleration = std::fabs(acceleration);
+	if (acceleration_ == acceleration) {
+		return;
+	}
+	// new n_ keeps the current speed
+	n_ = static_cast<long>(n_ * (acceleration_ / acceleration));
+	// Equation 15 of the speed profile paper
+	c0_ = 0.676f * std::sqrt(2.0f / acceleration) * 1000000.0f;
+	acceleration_ = acceleration;
+	computeNewSpeed();
+}
+
+void AccelStepper::setSpeed(float speed) {
+	if (speed == speed_) {
+		return;
+	}
+	speed = std::max(-maxSpeed_, std::min(maxSpeed_, speed));
+	if (speed == 0) {
+		stepInterval_ = 0;
+	} else {
+		stepInterval_ = static_cast<uint32_t>(std::fabs(1000000.0f / speed));
+		direction_ = speed > 0 ? CW : CCW;
+	}
+	speed_ = speed;
+}
+
+void AccelStepper::setCurrentPosition(long position) {
+	targetPosition_ = currentPosition_ = position;
+	n_ = 0;
+	stepInterval_ = 0;
+	speed_ = 0;
+}
+
+void AccelStepper::stop() {
+	if (speed_ == 0) {
+		return;
+	}
+	auto stepsToStop = static_cast<long>((speed_ * speed_) / (2.0f * acceleration_)) + 1;
+	move(speed_ > 0 ? stepsToStop : -stepsToStop);
+}
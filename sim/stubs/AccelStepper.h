@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Behaves like AccelStepper 1.61 in DRIVER mode: same speed profile (David Austin's stepper timing), same
+// step timing against micros(). Step pulses go to a listener instead of pins.
+class AccelStepper {
+public:
+	enum MotorInterfaceType : uint8_t {
+		FUNCTION = 0,
+		DRIVER = 1,
+	};
+
+	// simulator: called for every step with the new position
+	using StepListener = void (*)(const AccelStepper& stepper, long position);
+
+	AccelStepper(uint8_t interface = DRIVER, uint8_t stepPin = 2, uint8_t directionPin = 3, uint8_t pin3 = 4,
+		uint8_t pin4 = 5, bool enable = true);
+	// steps call the functions, the simulator does not list these steppers
+	AccelStepper(void (*forward)(), void (*backward)());
+
+	void moveTo(long absolute);
+	void move(long relative);
+	bool run();
+	bool runSpeed();
+	void setMaxSpeed(float speed);
+	float maxSpeed() { return maxSpeed_; }
+	void setAcceleration(float acceleration);
+	void setSpeed(float speed);
+	float speed() { return speed_; }
+	long distanceToGo() { return targetPosition_ - currentPosition_; }
+	long targetPosition() { return targetPosition_; }
+	long currentPosition() { return currentPosition_; }
+	void setCurrentPosition(long position);
+	void stop();
+	bool isRunning() { return !(speed_ == 0 && targetPosition_ == currentPosition_); }
+	void disableOutputs() { enabled_ = false; }
+	void enableOutputs() { enabled_ = true; }
+	void setPinsInverted(bool direction = false, bool step = false, bool enable = false) {
+		directionInverted_ = direction;
+		(void)step;
+		(void)enable;
+	}
+	void setEnablePin(uint8_t enablePin = 0xff) { (void)enablePin; }
+	void setMinPulseWidth(unsigned int) {}
+
+	// simulator, steppers are listed in construction order
+	static constexpr const std::size_t MAX_INSTANCES = 4;
+	static std::size_t instanceCount() { return instanceCount_; }
+	static AccelStepper& instance(std::size_t index) { return *instances_[index]; }
+	static void setStepListener(StepListener listener) { stepListener_ = listener; }
+	uint8_t stepPin() const { return stepPin_; }
+	bool outputsEnabled() const { return enabled_; }
+	bool directionInverted() const { return directionInverted_; }
+	// runSpeed() steps at this micros() value or later, false when not moving
+	bool nextStepUs(uint32_t& result) const {
+		if (stepInterval_ == 0) {
+			return false;
+		}
+		result = lastStepUs_ + stepInterval_;
+		return true;
+	}
+
+private:
+	enum Direction : uint8_t {
+		CCW,
+		CW,
+	};
+
+	void computeNewSpeed();
+
+	static AccelStepper* instances_[MAX_INSTANCES];
+	static std::size_t instanceCount_;
+	static StepListener stepListener_;
+
+	uint8_t stepPin_;
+	void (*forward_)() = nullptr;
+	void (*backward_)() = nullptr;
+	bool enabled_ = true;
+	bool directionInverted_ = false;
+	Direction direction_ = CCW;
+	long currentPosition_ = 0;
+	long targetPosition_ = 0;
+	float speed_ = 0;
+	float maxSpeed_ = 1;
+	float acceleration_ = 0;
+	// unsigned long of the ESP32, wraps with micros()
+	uint32_t stepInterval_ = 0;
+	uint32_t lastStepUs_ = 0;
+	// step counter of the acceleration ramp, negative while decelerating
+	long n_ = 0;
+	// initial, current and minimum step interval (us)
+	float c0_ = 0;
+	float cn_ = 0;
+	float cmin_ = 1;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+// Host build of the parts of the ESP32 Arduino core the firmware uses. Time comes from the simulator's virtual
+// clock, FreeRTOS tasks run cooperatively and switch only where the firmware blocks (see sim/Tasks.cpp).
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/time.h>
+
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+
+using std::floor;
+using std::fmod;
+using std::pow;
+
+#define PI 3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+// pin modes and levels as the esp32 core defines them, names that clash with them do not build for the board
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+
+#define IRAM_ATTR
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+// FreeRTOS, tick is 1 ms as on the ESP32
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY 0xffffffffu
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter,
+	UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+void xTaskNotifyGive(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority);
+BaseType_t xPortGetCoreID();
+
+class EspClass {
+public:
+	// there is no heap limit on the host, sizes are reported as on an idle ESP32
+	uint32_t getHeapSize() { return 320 * 1024; }
+	uint32_t getFreeHeap() { return 320 * 1024; }
+	uint32_t getMinFreeHeap() { return 320 * 1024; }
+	uint32_t getMaxAllocHeap() { return 110 * 1024; }
+	// 240 MHz core clock on the virtual clock
+	uint32_t getCycleCount();
+	uint32_t getCpuFreqMHz() { return 240; }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,102 @@
+#include "FS.h"
+#include "LittleFS.h"
+
+#include <cstring>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+File::File(std::FILE* file, std::string name) : file_(file, &std::fclose), name_(std::move(name)) {}
+
+int File::available() {
+	if (!file_) {
+		return 0;
+	}
+	auto remaining = size() - position();
+	return static_cast<int>(remaining);
+}
+
+int File::read() {
+	return file_ ? std::fgetc(file_.get()) : -1;
+}
+
+int File::peek() {
+	if (!file_) {
+		return -1;
+	}
+	auto byte = std::fgetc(file_.get());
+	if (byte != EOF) {
+		std::ungetc(byte, file_.get());
+	}
+	return byte;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+	return file_ ? std::fread(buffer, 1, size, file_.get()) : 0;
+}
+
+size_t File::write(uint8_t byte) {
+	return write(&byte, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+	return file_ ? std::fwrite(buffer, 1, size, file_.get()) : 0;
+}
+
+void File::flush() {
+	if (file_) {
+		std::fflush(file_.get());
+	}
+}
+
+size_t File::size() const {
+	if (!file_) {
+		return 0;
+	}
+	auto position = std::ftell(file_.get());
+	std::fseek(file_.get(), 0, SEEK_END);
+	auto size = std::ftell(file_.get());
+	std::fseek(file_.get(), position, SEEK_SET);
+	return size;
+}
+
+size_t File::position() const {
+	return file_ ? std::ftell(file_.get()) : 0;
+}
+
+void File::close() {
+	file_.reset();
+}
+
+File FS::open(const char* path, const char* mode) {
+	if (root_.empty()) {
+		return File();
+	}
+	const char* hostMode = std::strcmp(mode, "w") == 0 ? "wb" : std::strcmp(mode, "a") == 0 ? "ab" : "rb";
+	auto* file = std::fopen(hostPath(path).c_str(), hostMode);
+	return file != nullptr ? File(file, path) : File();
+}
+
+bool FS::exists(const char* path) {
+	auto* file = root_.empty() ? nullptr : std::fopen(hostPath(path).c_str(), "rb");
+	if (file == nullptr) {
+		return false;
+	}
+	std::fclose(file);
+	return true;
+}
+
+bool FS::remove(const char* path) {
+	return !root_.empty() && std::remove(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+	return !root_.empty() && std::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+std::string FS::hostPath(const char* path) const {
+	return root_ + (path[0] == '/' ? "" : "/") + path;
+}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Stream.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace fs {
+
+// File of the simulated flash, a host file below the root directory given to LittleFS, see sim/main.cpp.
+// Copies share the handle like the ESP32 ones.
+class File : public Stream {
+public:
+	File() = default;
+	File(std::FILE* file, std::string name);
+
+	explicit operator bool() const { return file_ != nullptr; }
+
+	int available() override;
+	int read() override;
+	int peek() override;
+	size_t read(uint8_t* buffer, size_t size);
+	size_t write(uint8_t byte) override;
+	size_t write(const uint8_t* buffer, size_t size) override;
+	using Print::write;
+	void flush() override;
+
+	size_t size() const;
+	size_t position() const;
+	const char* name() const { return name_.c_str(); }
+	void close();
+
+private:
+	std::shared_ptr<std::FILE> file_;
+	std::string name_;
+};
+
+class FS {
+public:
+	// "r", "w" or "a"
+	File open(const char* path, const char* mode = "r");
+	bool exists(const char* path);
+	bool remove(const char* path);
+	bool rename(const char* from, const char* to);
+
+	// simulator side, host directory holding the files, none means the flash is not mounted
+	void setRoot(const std::string& root) { root_ = root; }
+	const std::string& root() const { return root_; }
+
+protected:
+	std::string hostPath(const char* path) const;
+
+	std::string root_;
+};
+
+}
+
+using fs::File;
+using fs::FS;
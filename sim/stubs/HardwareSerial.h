@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Stream.h"
+
+#include <deque>
+#include <string>
+
+// Serial port of the simulated board. The simulator feeds the input and drains the output, see sim/main.cpp.
+class HardwareSerial : public Stream {
+public:
+	void begin(unsigned long) {}
+
+	int available() override { return static_cast<int>(input_.size()); }
+	int read() override {
+		if (input_.empty()) {
+			return -1;
+		}
+		auto byte = input_.front();
+		input_.pop_front();
+		return byte;
+	}
+	int peek() override { return input_.empty() ? -1 : input_.front(); }
+
+	size_t write(uint8_t byte) override {
+		output_.push_back(static_cast<char>(byte));
+		return 1;
+	}
+	size_t write(const uint8_t* buffer, size_t size) override {
+		output_.append(reinterpret_cast<const char*>(buffer), size);
+		return size;
+	}
+	using Print::write;
+
+	// simulator side
+	void feed(const char* data, size_t size) { input_.insert(input_.end(), data, data + size); }
+	std::string takeOutput() {
+		std::string output;
+		output.swap(output_);
+		return output;
+	}
+
+private:
+	std::deque<uint8_t> input_;
+	std::string output_;
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+	// the host directory needs no formatting, it only has to be set
+	bool begin(bool formatOnFail = false) {
+		(void)formatOnFail;
+		return !root_.empty();
+	}
+	void end() {}
+};
+
+}
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Arduino.h>
+
+struct ps4_button_t {
+	uint8_t right : 1;
+	uint8_t down : 1;
+	uint8_t up : 1;
+	uint8_t left : 1;
+	uint8_t square : 1;
+	uint8_t cross : 1;
+	uint8_t circle : 1;
+	uint8_t triangle : 1;
+	uint8_t l1 : 1;
+	uint8_t r1 : 1;
+	uint8_t l2 : 1;
+	uint8_t r2 : 1;
+	uint8_t share : 1;
+	uint8_t options : 1;
+	uint8_t l3 : 1;
+	uint8_t r3 : 1;
+	uint8_t ps : 1;
+	uint8_t touchpad : 1;
+};
+
+struct ps4_event_t {
+	ps4_button_t button_down;
+	ps4_button_t button_up;
+};
+
+// PS4Controller 2.1 callback API. The simulator delivers reports, the firmware sees them as from the Bluetooth task.
+class PS4Controller {
+public:
+	using Callback = void (*)();
+
+	ps4_event_t event{};
+
+	bool begin(const char*) { return true; }
+	bool isConnected() { return connected_; }
+
+	bool Right() { return held_.right; }
+	bool Down() { return held_.down; }
+	bool Up() { return held_.up; }
+	bool Left() { return held_.left; }
+	bool Square() { return held_.square; }
+	bool Cross() { return held_.cross; }
+	bool Circle() { return held_.circle; }
+	bool Triangle() { return held_.triangle; }
+	bool L1() { return held_.l1; }
+	bool R1() { return held_.r1; }
+	int8_t LStickX() { return sticks_[0]; }
+	int8_t LStickY() { return sticks_[1]; }
+	int8_t RStickX() { return sticks_[2]; }
+	int8_t RStickY() { return sticks_[3]; }
+
+	void attach(Callback callback) { onReport_ = callback; }
+	void attachOnConnect(Callback callback) { onConnect_ = callback; }
+	void attachOnDisconnect(Callback callback) { onDisconnect_ = callback; }
+
+	// simulator: one controller report, `down` and `up` are the button edges since the previous one
+	void report(ps4_button_t down, ps4_button_t up, int8_t lStickX, int8_t lStickY, int8_t rStickX, int8_t rStickY) {
+		if (!connected_) {
+			connected_ = true;
+			if (onConnect_ != nullptr) {
+				onConnect_();
+			}
+		}
+		event.button_down = down;
+		event.button_up = up;
+		held_ = merge(held_, down, up);
+		sticks_[0] = lStickX;
+		sticks_[1] = lStickY;
+		sticks_[2] = rStickX;
+		sticks_[3] = rStickY;
+		if (onReport_ != nullptr) {
+			onReport_();
+		}
+		event = ps4_event_t{};
+	}
+
+	void disconnect() {
+		if (!connected_) {
+			return;
+		}
+		connected_ = false;
+		held_ = ps4_button_t{};
+		for (auto& stick : sticks_) {
+			stick = 0;
+		}
+		if (onDisconnect_ != nullptr) {
+			onDisconnect_();
+		}
+	}
+
+	int8_t stick(std::size_t index) const { return sticks_[index]; }
+
+private:
+	static ps4_button_t merge(ps4_button_t held, ps4_button_t down, ps4_button_t up) {
+		uint32_t bits = 0;
+		uint32_t downBits = 0;
+		uint32_t upBits = 0;
+		static_assert(sizeof(ps4_button_t) <= sizeof(bits), "Buttons fit a word");
+		std::memcpy(&bits, &held, sizeof(held));
+		std::memcpy(&downBits, &down, sizeof(down));
+		std::memcpy(&upBits, &up, sizeof(up));
+		bits = (bits | downBits) & ~upBits;
+		std::memcpy(&held, &bits, sizeof(held));
+		return held;
+	}
+
+	bool connected_ = false;
+	ps4_button_t held_{};
+	int8_t sticks_[4] = {0, 0, 0, 0};
+	Callback onReport_ = nullptr;
+	Callback onConnect_ = nullptr;
+	Callback onDisconnect_ = nullptr;
+};
+
+extern PS4Controller PS4;
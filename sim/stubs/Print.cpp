@@ -0,0 +1,84 @@
+#include "Print.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+	size_t written = 0;
+	for (size_t i = 0; i < size; ++i) {
+		written += write(buffer[i]);
+	}
+	return written;
+}
+
+size_t Print::write(const char* text) {
+	return write(reinterpret_cast<const uint8_t*>(text), std::strlen(text));
+}
+
+size_t Print::printf(const char* format, ...) {
+	char buffer[64];
+	va_list args;
+	va_start(args, format);
+	va_list copy;
+	va_copy(copy, args);
+	auto length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	if (length < 0) {
+		va_end(copy);
+		return 0;
+	}
+	if (static_cast<size_t>(length) < sizeof(buffer)) {
+		va_end(copy);
+		return write(reinterpret_cast<const uint8_t*>(buffer), length);
+	}
+	// longer output is allocated, as on the ESP32
+	std::vector<char> longBuffer(length + 1);
+	std::vsnprintf(longBuffer.data(), longBuffer.size(), format, copy);
+	va_end(copy);
+	return write(reinterpret_cast<const uint8_t*>(longBuffer.data()), length);
+}
+
+size_t Print::print(const char* text) { return write(text); }
+size_t Print::print(char value) { return write(static_cast<uint8_t>(value)); }
+size_t Print::print(int value, int base) { return print(static_cast<long>(value), base); }
+size_t Print::print(unsigned int value, int base) { return print(static_cast<unsigned long>(value), base); }
+
+size_t Print::print(long value, int base) {
+	if (base == 10) {
+		return printf("%ld", value);
+	}
+	return value < 0 ? print('-') + print(static_cast<unsigned long>(-value), base) : print(static_cast<unsigned long>(value), base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+	if (base == 16) {
+		return printf("%lX", value);
+	}
+	if (base == 8) {
+		return printf("%lo", value);
+	}
+	if (base != 2) {
+		return printf("%lu", value);
+	}
+	char digits[sizeof(value) * 8 + 1];
+	auto* next = digits + sizeof(digits) - 1;
+	*next = '\0';
+	do {
+		*--next = '0' + (value & 1);
+		value >>= 1;
+	} while (value != 0);
+	return write(next);
+}
+
+size_t Print::print(double value, int digits) { return printf("%.*f", digits, value); }
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const char* text) { return print(text) + println(); }
+size_t Print::println(char value) { return print(value) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class Print {
+public:
+	virtual ~Print() = default;
+
+	virtual size_t write(uint8_t byte) = 0;
+	virtual size_t write(const uint8_t* buffer, size_t size);
+	size_t write(const char* text);
+
+	size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+	size_t print(const char* text);
+	size_t print(char value);
+	size_t print(int value, int base = 10);
+	size_t print(unsigned int value, int base = 10);
+	size_t print(long value, int base = 10);
+	size_t print(unsigned long value, int base = 10);
+	size_t print(double value, int digits = 2);
+
+	size_t println();
+	size_t println(const char* text);
+	size_t println(char value);
+	size_t println(int value, int base = 10);
+	size_t println(unsigned int value, int base = 10);
+	size_t println(long value, int base = 10);
+	size_t println(unsigned long value, int base = 10);
+	size_t println(double value, int digits = 2);
+
+	virtual void flush() {}
+};
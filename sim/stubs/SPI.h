@@ -0,0 +1,3 @@
+#pragma once
+
+// display bus, U8g2 does the transfers
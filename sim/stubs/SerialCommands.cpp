@@ -0,0 +1,71 @@
+#include "SerialCommands.h"
+
+#include <strings.h>
+
+void SerialCommands::AddCommand(SerialCommand* command) {
+	command->next = nullptr;
+	auto** last = &commands_;
+	while (*last != nullptr) {
+		last = &(*last)->next;
+	}
+	*last = command;
+}
+
+void SerialCommands::ClearBuffer() {
+	buffer_[0] = '\0';
+	length_ = 0;
+	termMatched_ = 0;
+}
+
+bool SerialCommands::runOneKey(char byte) {
+	for (auto* command = commands_; command != nullptr; command = command->next) {
+		if (command->oneKey && command->command[0] == byte) {
+			command->function(this);
+			return true;
+		}
+	}
+	return false;
+}
+
+SERIAL_COMMANDS_ERRORS SerialCommands::ReadSerial() {
+	if (serial_ == nullptr) {
+		return SERIAL_COMMANDS_ERROR_NO_SERIAL;
+	}
+	while (serial_->available() > 0) {
+		auto byte = serial_->read();
+		if (byte <= 0) {
+			continue;
+		}
+		if (length_ == 0 && runOneKey(byte)) {
+			continue;
+		}
+		if (length_ >= bufferSize_ - 1) {
+			ClearBuffer();
+			return SERIAL_COMMANDS_ERROR_BUFFER_FULL;
+		}
+		buffer_[length_++] = byte;
+		buffer_[length_] = '\0';
+		if (term_[termMatched_] != byte) {
+			termMatched_ = term_[0] == byte ? 1 : 0;
+			continue;
+		}
+		if (term_[++termMatched_] != '\0') {
+			continue;
+		}
+		buffer_[length_ - termMatched_] = '\0';
+		auto* name = strtok_r(buffer_, delimiter_, &lastToken_);
+		if (name != nullptr) {
+			auto* command = commands_;
+			while (command != nullptr && (command->oneKey || strcasecmp(command->command, name) != 0)) {
+				command = command->next;
+			}
+			if (command != nullptr) {
+				command->function(this);
+			} else if (defaultHandler_ != nullptr) {
+				defaultHandler_(this, name);
+			}
+		}
+		ClearBuffer();
+	}
+	return SERIAL_COMMANDS_SUCCESS;
+}
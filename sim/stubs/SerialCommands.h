@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+
+typedef enum ternary {
+	SERIAL_COMMANDS_SUCCESS = 0,
+	SERIAL_COMMANDS_ERROR_NO_SERIAL,
+	SERIAL_COMMANDS_ERROR_BUFFER_FULL,
+} SERIAL_COMMANDS_ERRORS;
+
+class SerialCommands;
+
+// SerialCommands 1.1 behaviour: lines end with `term`, first token is matched case insensitive, one key commands
+// run on their character at a line start.
+class SerialCommand {
+public:
+	SerialCommand(const char* command, void (*function)(SerialCommands*), bool oneKey = false)
+		: command(command), function(function), oneKey(oneKey) {}
+
+	const char* command;
+	void (*function)(SerialCommands*);
+	bool oneKey;
+	SerialCommand* next = nullptr;
+};
+
+class SerialCommands {
+public:
+	SerialCommands(Stream* serial, char* buffer, int16_t bufferSize, const char* term = "\r\n", const char* delimiter = " ")
+		: serial_(serial), buffer_(buffer), bufferSize_(bufferSize), term_(term), delimiter_(delimiter) {
+		ClearBuffer();
+	}
+
+	void AddCommand(SerialCommand* command);
+	SERIAL_COMMANDS_ERRORS ReadSerial();
+	Stream* GetSerial() { return serial_; }
+	void AttachSerial(Stream* serial) { serial_ = serial; }
+	char* Next() { return strtok_r(nullptr, delimiter_, &lastToken_); }
+	void SetDefaultHandler(void (*function)(SerialCommands*, const char*)) { defaultHandler_ = function; }
+	void ClearBuffer();
+
+private:
+	bool runOneKey(char byte);
+
+	Stream* serial_;
+	char* buffer_;
+	int16_t bufferSize_;
+	const char* term_;
+	const char* delimiter_;
+	int16_t length_ = 0;
+	std::size_t termMatched_ = 0;
+	char* lastToken_ = nullptr;
+	SerialCommand* commands_ = nullptr;
+	void (*defaultHandler_)(SerialCommands*, const char*) = nullptr;
+};
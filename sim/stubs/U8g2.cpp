@@ -0,0 +1,276 @@
+#include "U8g2lib.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+constexpr const int GLYPH_WIDTH = 5;
+constexpr const int GLYPH_HEIGHT = 7;
+constexpr const int CELL_WIDTH = GLYPH_WIDTH + 1;
+
+// printable ASCII, one byte per column, LSB on top
+constexpr const uint8_t FONT_5X7[][GLYPH_WIDTH] = {
+	{0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00}, {0x14, 0x7F, 0x14, 0x7F, 0x14},
+	{0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62}, {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00},
+	{0x00, 0x1C, 0x22, 0x41, 0x00}, {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x08, 0x2A, 0x1C, 0x2A, 0x08}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+	{0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00}, {0x20, 0x10, 0x08, 0x04, 0x02},
+	{0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00}, {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31},
+	{0x18, 0x14, 0x12, 0x7F, 0x10}, {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+	{0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00}, {0x00, 0x56, 0x36, 0x00, 0x00},
+	{0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14}, {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06},
+	{0x32, 0x49, 0x79, 0x41, 0x3E}, {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+	{0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x01, 0x01}, {0x3E, 0x41, 0x41, 0x51, 0x32},
+	{0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00}, {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41},
+	{0x7F, 0x40, 0x40, 0x40, 0x40}, {0x7F, 0x02, 0x04, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+	{0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46}, {0x46, 0x49, 0x49, 0x49, 0x31},
+	{0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F}, {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x7F, 0x20, 0x18, 0x20, 0x7F},
+	{0x63, 0x14, 0x08, 0x14, 0x63}, {0x03, 0x04, 0x78, 0x04, 0x03}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+	{0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04}, {0x40, 0x40, 0x40, 0x40, 0x40},
+	{0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78}, {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20},
+	{0x38, 0x44, 0x44, 0x48, 0x7F}, {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x08, 0x14, 0x54, 0x54, 0x3C},
+	{0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00}, {0x00, 0x7F, 0x10, 0x28, 0x44},
+	{0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78}, {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38},
+	{0x7C, 0x14, 0x14, 0x14, 0x08}, {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+	{0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C}, {0x3C, 0x40, 0x30, 0x40, 0x3C},
+	{0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C}, {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00},
+	{0x00, 0x00, 0x7F, 0x00, 0x00}, {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},
+};
+static_assert(sizeof(FONT_5X7) / GLYPH_WIDTH == '~' - ' ' + 1, "Font covers printable ASCII");
+constexpr const uint8_t DEGREE_GLYPH[GLYPH_WIDTH] = {0x00, 0x06, 0x09, 0x09, 0x06};
+constexpr const uint8_t UNKNOWN_GLYPH[GLYPH_WIDTH] = {0x7F, 0x41, 0x41, 0x41, 0x7F};
+
+const uint8_t* glyph(uint8_t code) {
+	if (code >= ' ' && code <= '~') {
+		return FONT_5X7[code - ' '];
+	}
+	// Latin-1 degree sign, and 0xDF which the LX200 protocol uses for it
+	if (code == 0xB0 || code == 0xDF) {
+		return DEGREE_GLYPH;
+	}
+	return UNKNOWN_GLYPH;
+}
+
+}
+
+const uint8_t u8g2_font_profont11_tf[] = {0};
+const uint8_t u8g2_font_4x6_tf[] = {0};
+const uint8_t u8g2_font_6x10_tf[] = {0};
+
+void u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t count, uint8_t* tiles) {
+	if (y >= U8G2_TILE_HEIGHT || x >= U8G2_TILE_WIDTH) {
+		return;
+	}
+	count = std::min<uint8_t>(count, U8G2_TILE_WIDTH - x);
+	std::memcpy(u8x8->ram + (y * U8G2_TILE_WIDTH + x) * 8, tiles, count * 8);
+	u8x8->tilesDrawn += count;
+}
+
+U8G2::U8G2() {
+	std::memset(&u8g2_.u8x8, 0, sizeof(u8g2_.u8x8));
+	std::memset(buffer_, 0, sizeof(buffer_));
+	u8g2_.tile_buf_ptr = buffer_;
+}
+
+bool U8G2::begin() {
+	clearBuffer();
+	clearDisplay();
+	return true;
+}
+
+void U8G2::clearBuffer() {
+	std::memset(u8g2_.tile_buf_ptr, 0, U8G2_BUFFER_SIZE);
+}
+
+void U8G2::sendBuffer() {
+	for (uint8_t row = 0; row < U8G2_TILE_HEIGHT; ++row) {
+		u8x8_DrawTile(&u8g2_.u8x8, 0, row, U8G2_TILE_WIDTH, u8g2_.tile_buf_ptr + row * U8G2_TILE_WIDTH * 8);
+	}
+}
+
+void U8G2::clearDisplay() {
+	std::memset(u8g2_.u8x8.ram, 0, sizeof(u8g2_.u8x8.ram));
+}
+
+bool U8G2::displayPixel(int x, int y) const {
+	if (x < 0 || y < 0 || x >= U8G2_TILE_WIDTH * 8 || y >= U8G2_TILE_HEIGHT * 8) {
+		return false;
+	}
+	return (u8g2_.u8x8.ram[(y / 8) * U8G2_TILE_WIDTH * 8 + x] >> (y % 8)) & 1;
+}
+
+void U8G2::setPixel(int x, int y, uint8_t color) {
+	if (x < 0 || y < 0 || x >= U8G2_TILE_WIDTH * 8 || y >= U8G2_TILE_HEIGHT * 8) {
+		return;
+	}
+	auto& byte = u8g2_.tile_buf_ptr[(y / 8) * U8G2_TILE_WIDTH * 8 + x];
+	uint8_t bit = 1 << (y % 8);
+	switch (color) {
+		case 0: byte &= ~bit; break;
+		case 1: byte |= bit; break;
+		default: byte ^= bit; break;
+	}
+}
+
+int U8G2::drawStr(int x, int y, const char* text) {
+	auto start = x;
+	// baseline at `y`, the font has no descent
+	auto top = y - GLYPH_HEIGHT;
+	for (; *text != '\0'; ++text) {
+		const auto* columns = glyph(static_cast<uint8_t>(*text));
+		for (int column = 0; column < CELL_WIDTH; ++column) {
+			uint8_t bits = column < GLYPH_WIDTH ? columns[column] : 0;
+			for (int row = 0; row < GLYPH_HEIGHT; ++row) {
+				if ((bits >> row) & 1) {
+					setPixel(x + column, top + row, drawColor_);
+				} else if (fontMode_ == 0 && drawColor_ < 2) {
+					setPixel(x + column, top + row, drawColor_ ^ 1);
+				}
+			}
+		}
+		x += CELL_WIDTH;
+	}
+	return x - start;
+}
+
+int U8G2::getStrWidth(const char* text) {
+	return static_cast<int>(std::strlen(text)) * CELL_WIDTH;
+}
+
+void U8G2::drawPixel(int x, int y) {
+	setPixel(x, y, drawColor_);
+}
+
+void U8G2::drawHLine(int x, int y, int width) {
+	for (int i = 0; i < width; ++i) {
+		setPixel(x + i, y, drawColor_);
+	}
+}
+
+void U8G2::drawVLine(int x, int y, int height) {
+	for (int i = 0; i < height; ++i) {
+		setPixel(x, y + i, drawColor_);
+	}
+}
+
+void U8G2::drawLine(int x0, int y0, int x1, int y1) {
+	auto dx = std::abs(x1 - x0);
+	auto dy = -std::abs(y1 - y0);
+	auto stepX = x0 < x1 ? 1 : -1;
+	auto stepY = y0 < y1 ? 1 : -1;
+	auto error = dx + dy;
+	for (;;) {
+		setPixel(x0, y0, drawColor_);
+		if (x0 == x1 && y0 == y1) {
+			return;
+		}
+		if (2 * error >= dy) {
+			error += dy;
+			x0 += stepX;
+		}
+		if (2 * error <= dx) {
+			error += dx;
+			y0 += stepY;
+		}
+	}
+}
+
+void U8G2::drawBox(int x, int y, int width, int height) {
+	for (int i = 0; i < height; ++i) {
+		drawHLine(x, y + i, width);
+	}
+}
+
+void U8G2::drawFrame(int x, int y, int width, int height) {
+	if (width <= 0 || height <= 0) {
+		return;
+	}
+	drawHLine(x, y, width);
+	if (height > 1) {
+		drawHLine(x, y + height - 1, width);
+	}
+	if (height > 2) {
+		drawVLine(x, y + 1, height - 2);
+		drawVLine(x + width - 1, y + 1, height - 2);
+	}
+}
+
+void U8G2::circlePoints(int x, int y, int dx, int dy, uint8_t option) {
+	if (option & U8G2_DRAW_UPPER_RIGHT) {
+		setPixel(x + dx, y - dy, drawColor_);
+		setPixel(x + dy, y - dx, drawColor_);
+	}
+	if (option & U8G2_DRAW_UPPER_LEFT) {
+		setPixel(x - dx, y - dy, drawColor_);
+		setPixel(x - dy, y - dx, drawColor_);
+	}
+	if (option & U8G2_DRAW_LOWER_RIGHT) {
+		setPixel(x + dx, y + dy, drawColor_);
+		setPixel(x + dy, y + dx, drawColor_);
+	}
+	if (option & U8G2_DRAW_LOWER_LEFT) {
+		setPixel(x - dx, y + dy, drawColor_);
+		setPixel(x - dy, y + dx, drawColor_);
+	}
+}
+
+// same midpoint walk as u8g2, one octant mirrored to the requested quadrants
+void U8G2::drawCircle(int x, int y, int radius, uint8_t option) {
+	auto f = 1 - radius;
+	auto ddFx = 1;
+	auto ddFy = -2 * radius;
+	auto dx = 0;
+	auto dy = radius;
+	circlePoints(x, y, dx, dy, option);
+	while (dx < dy) {
+		if (f >= 0) {
+			--dy;
+			ddFy += 2;
+			f += ddFy;
+		}
+		++dx;
+		ddFx += 2;
+		f += ddFx;
+		circlePoints(x, y, dx, dy, option);
+	}
+}
+
+void U8G2::discLines(int x, int y, int dx, int dy, uint8_t option) {
+	if (option & U8G2_DRAW_UPPER_RIGHT) {
+		drawVLine(x + dx, y - dy, dy + 1);
+		drawVLine(x + dy, y - dx, dx + 1);
+	}
+	if (option & U8G2_DRAW_UPPER_LEFT) {
+		drawVLine(x - dx, y - dy, dy + 1);
+		drawVLine(x - dy, y - dx, dx + 1);
+	}
+	if (option & U8G2_DRAW_LOWER_RIGHT) {
+		drawVLine(x + dx, y, dy + 1);
+		drawVLine(x + dy, y, dx + 1);
+	}
+	if (option & U8G2_DRAW_LOWER_LEFT) {
+		drawVLine(x - dx, y, dy + 1);
+		drawVLine(x - dy, y, dx + 1);
+	}
+}
+
+void U8G2::drawDisc(int x, int y, int radius, uint8_t option) {
+	auto f = 1 - radius;
+	auto ddFx = 1;
+	auto ddFy = -2 * radius;
+	auto dx = 0;
+	auto dy = radius;
+	discLines(x, y, dx, dy, option);
+	while (dx < dy) {
+		if (f >= 0) {
+			--dy;
+			ddFy += 2;
+			f += ddFy;
+		}
+		++dx;
+		ddFx += 2;
+		f += ddFx;
+		discLines(x, y, dx, dy, option);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+
+// The U8g2 full buffer API the firmware draws with. Pixels land in the tile buffer in the SH1106 layout (tile
+// rows of 8 pixel high columns, LSB on top), tiles sent with u8x8_DrawTile() land in the simulated display RAM.
+// Every font renders as a fixed 5x7 font in 6 pixel cells.
+
+#define U8G2_R0 nullptr
+#define U8G2_DRAW_UPPER_RIGHT 0x01
+#define U8G2_DRAW_UPPER_LEFT 0x02
+#define U8G2_DRAW_LOWER_LEFT 0x04
+#define U8G2_DRAW_LOWER_RIGHT 0x08
+#define U8G2_DRAW_ALL 0x0f
+
+constexpr const uint8_t U8G2_TILE_WIDTH = 16;
+constexpr const uint8_t U8G2_TILE_HEIGHT = 8;
+constexpr const std::size_t U8G2_BUFFER_SIZE = U8G2_TILE_WIDTH * U8G2_TILE_HEIGHT * 8;
+
+typedef struct u8x8_struct {
+	uint8_t ram[U8G2_BUFFER_SIZE];
+	uint32_t tilesDrawn;
+} u8x8_t;
+
+typedef struct u8g2_struct {
+	u8x8_t u8x8;
+	uint8_t* tile_buf_ptr;
+} u8g2_t;
+
+extern const uint8_t u8g2_font_profont11_tf[];
+extern const uint8_t u8g2_font_4x6_tf[];
+extern const uint8_t u8g2_font_6x10_tf[];
+
+inline u8x8_t* u8g2_GetU8x8(u8g2_t* u8g2) { return &u8g2->u8x8; }
+void u8x8_DrawTile(u8x8_t* u8x8, uint8_t x, uint8_t y, uint8_t count, uint8_t* tiles);
+
+class U8G2 {
+public:
+	U8G2();
+	virtual ~U8G2() = default;
+
+	u8g2_t* getU8g2() { return &u8g2_; }
+	uint8_t* getBufferPtr() { return u8g2_.tile_buf_ptr; }
+	uint8_t getBufferTileWidth() { return U8G2_TILE_WIDTH; }
+	uint8_t getBufferTileHeight() { return U8G2_TILE_HEIGHT; }
+	int getDisplayWidth() { return U8G2_TILE_WIDTH * 8; }
+	int getDisplayHeight() { return U8G2_TILE_HEIGHT * 8; }
+
+	bool begin();
+	void clearBuffer();
+	void sendBuffer();
+	void clearDisplay();
+
+	void setFont(const uint8_t* font) { font_ = font; }
+	void setFontMode(uint8_t mode) { fontMode_ = mode; }
+	void setDrawColor(uint8_t color) { drawColor_ = color; }
+
+	int drawStr(int x, int y, const char* text);
+	int getStrWidth(const char* text);
+	void drawPixel(int x, int y);
+	void drawHLine(int x, int y, int width);
+	void drawVLine(int x, int y, int height);
+	void drawLine(int x0, int y0, int x1, int y1);
+	void drawBox(int x, int y, int width, int height);
+	void drawFrame(int x, int y, int width, int height);
+	void drawCircle(int x, int y, int radius, uint8_t option = U8G2_DRAW_ALL);
+	void drawDisc(int x, int y, int radius, uint8_t option = U8G2_DRAW_ALL);
+
+	// simulator: what the panel shows, row major, true for a lit pixel
+	bool displayPixel(int x, int y) const;
+
+private:
+	void setPixel(int x, int y, uint8_t color);
+	void circlePoints(int x, int y, int dx, int dy, uint8_t option);
+	void discLines(int x, int y, int dx, int dy, uint8_t option);
+
+	u8g2_t u8g2_;
+	uint8_t buffer_[U8G2_BUFFER_SIZE];
+	const uint8_t* font_ = nullptr;
+	uint8_t fontMode_ = 0;
+	uint8_t drawColor_ = 1;
+};
+
+class U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI : public U8G2 {
+public:
+	U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI(const void*, uint8_t, uint8_t, uint8_t = 0xff) {}
+};
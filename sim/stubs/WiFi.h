@@ -0,0 +1,3 @@
+#pragma once
+
+// nothing of WiFi is used
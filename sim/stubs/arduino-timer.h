@@ -0,0 +1,105 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#ifndef TIMER_MAX_TASKS
+#define TIMER_MAX_TASKS 0x10
+#endif
+
+// arduino-timer 2.3 behaviour: a handler returning false is removed, repeating tasks restart from the tick
+// that ran them.
+template<size_t max_tasks = TIMER_MAX_TASKS, unsigned long (*time_func)() = millis, typename T = void*>
+class Timer {
+public:
+	typedef uintptr_t Task;
+	typedef bool (*handler_t)(T opaque);
+
+	Task in(unsigned long delay, handler_t handler, T opaque = T()) {
+		return add(time_func(), delay, handler, opaque, false);
+	}
+
+	Task at(unsigned long time, handler_t handler, T opaque = T()) {
+		auto now = time_func();
+		return add(now, time - now, handler, opaque, false);
+	}
+
+	Task every(unsigned long interval, handler_t handler, T opaque = T()) {
+		return add(time_func(), interval, handler, opaque, true);
+	}
+
+	void cancel(Task& task) {
+		if (task == 0) {
+			return;
+		}
+		tasks_[task - 1].handler = nullptr;
+		task = 0;
+	}
+
+	void cancel() {
+		for (auto& task : tasks_) {
+			task.handler = nullptr;
+		}
+	}
+
+	// Runs due tasks, returns time until the next one
+	unsigned long tick() {
+		unsigned long next = static_cast<unsigned long>(-1);
+		for (auto& task : tasks_) {
+			if (task.handler == nullptr) {
+				continue;
+			}
+			auto now = time_func();
+			auto elapsed = now - task.start;
+			if (elapsed >= task.expires) {
+				auto repeat = task.handler(task.opaque) && task.repeat;
+				if (!repeat) {
+					task.handler = nullptr;
+					continue;
+				}
+				task.start = now;
+				elapsed = 0;
+			}
+			next = std::min(next, task.expires - elapsed);
+		}
+		return next == static_cast<unsigned long>(-1) ? 0 : next;
+	}
+
+	size_t size() const {
+		size_t count = 0;
+		for (const auto& task : tasks_) {
+			count += task.handler != nullptr;
+		}
+		return count;
+	}
+
+	bool empty() const { return size() == 0; }
+
+private:
+	struct Entry {
+		handler_t handler = nullptr;
+		T opaque;
+		unsigned long start = 0;
+		unsigned long expires = 0;
+		bool repeat = false;
+	};
+
+	Task add(unsigned long start, unsigned long expires, handler_t handler, T opaque, bool repeat) {
+		for (size_t i = 0; i < max_tasks; ++i) {
+			auto& task = tasks_[i];
+			if (task.handler == nullptr) {
+				task = Entry{handler, opaque, start, expires, repeat};
+				return i + 1;
+			}
+		}
+		return 0;
+	}
+
+	Entry tasks_[max_tasks];
+};
+
+inline Timer<> timer_create_default() {
+	return Timer<>();
+}
@@ -7,13 +7,26 @@
 #include <arduino-timer.h>
 #include <PS4Controller.h>
 #include <SerialCommands.h>
+#include <LittleFS.h>
 
 #include <exception>
 #include <stdexcept>
 
-#include "ButtonProcessor.h"
+#include <sys/time.h>
+
+#include "BenchmarkSuite.h"
+#include "DirtyTileDisplay.h"
+#include "HeapTracker.h"
+#include "InputEvents.h"
+#include "Log.h"
+#include "Lx200.h"
 #include "Mount.h"
+#include "Profiler.h"
+#include "Scheduler.h"
 #include "ScreenUI.h"
+#include "Sky.h"
+#include "Telemetry.h"
+#include "Trace.h"
 
 
 auto timer = timer_create_default();
@@ -24,11 +37,19 @@ auto stepper2 = AccelStepper(AccelStepper::DRIVER, 2, 4);
 
 //SCK - 18, MOSI - 23, SS - 5
 U8G2_SH1106_128X64_NONAME_F_4W_HW_SPI u8g2(U8G2_R0, 5, 17, 16);
-scope::Mount mount(stepper1, stepper2, Serial);
-ui::ScreenUI screen(u8g2, mount);
+scope::Mount mount(stepper1, stepper2);
+scope::Sky sky(mount);
+ui::ScreenUI screen(u8g2, mount, sky);
+ui::DirtyTileDisplay display(u8g2);
 
-char serialCommandBuffer[64];
-SerialCommands serialCommands(&Serial, serialCommandBuffer, sizeof(serialCommandBuffer), "\r\n", " ");
+// LX200 commands (planetarium software) and text commands share the serial port, its input goes through the
+// trace recorder and comes from the trace during a replay
+trace::SerialTap serialTap(Serial, trace::recorder());
+scope::Lx200Server lx200(mount, Serial);
+scope::SerialDemux serialDemux(serialTap, lx200);
+// room for a scheduled command behind "at hh:mm:ss "
+char serialCommandBuffer[96];
+SerialCommands serialCommands(&serialDemux, serialCommandBuffer, sizeof(serialCommandBuffer), "\r\n", " ");
 void unrecognizedCmdCb(SerialCommands* sender, const char* cmd) {
 	sender->GetSerial()->print("Unrecognized command [");
 	sender->GetSerial()->print(cmd);
@@ -60,8 +81,9 @@ void moveToCmdCb(SerialCommands* sender) {
 	}
 	auto positionX = atoi(positionXStr);
 	auto positionY = atoi(positionYStr);
-	mount.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO; //TODO make a wrapper to include this in safeMoveTo public method
- 	mount.safeMoveTo({positionX, positionY}, speed);
+	if (!mount.moveTo({positionX, positionY}, speed)) {
+		sender->GetSerial()->println("Motion queue full");
+	}
 }
 SerialCommand moveToCmd("moveto", &moveToCmdCb);
 void moveToDegCmdCb(SerialCommands* sender) {
@@ -90,8 +112,9 @@ void moveToDegCmdCb(SerialCommands* sender) {
 	}
 	auto positionX = atof(positionXStr);
 	auto positionY = atof(positionYStr);
-	mount.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO; //TODO make a wrapper to include this in safeMoveTo public method
-	mount.safeMoveToPositionDeg({positionX, positionY}, speed);
+	if (!mount.moveToDeg({positionX, positionY}, speed)) {
+		sender->GetSerial()->println("Motion queue full");
+	}
 }
 SerialCommand moveToDegCmd("movetodeg", &moveToDegCmdCb);
 void moveToRADecCmdCb(SerialCommands* sender) {
@@ -118,18 +141,33 @@ void moveToRADecCmdCb(SerialCommands* sender) {
 		sender->GetSerial()->println("Invalid speed");
 		return;
 	}
-	try {
-		auto ra = coords::RA(positionXStr);
-		auto dec = coords::Dec(positionYStr);
-		mount.trackingMode_ = scope::Mount::TrackingMode::MOVE_TO; //TODO make a wrapper to include this in safeMoveTo public method
-		sender->GetSerial()->printf("movetoradec: RA{%f, %f, %f}, Dec{%f, %f, %f}\n", ra.h, ra.m, ra.s, dec.d, dec.m, dec.s);
-		sender->GetSerial()->printf("movetoradec: RA: %s, Dec: %s}\n", ra.str().c_str(), dec.str().c_str());
-		mount.safeMoveToPositionRADec({ra.rad(), dec.rad()}, speed);
-	} catch (const std::invalid_argument& e) {
-		sender->GetSerial()->println(e.what());
+	auto ra = coords::parseRA(positionXStr);
+	if (!ra) {
+		sender->GetSerial()->printf("Invalid RA: %s\n", ra.message());
+		return;
+	}
+	auto dec = coords::parseDec(positionYStr);
+	if (!dec) {
+		sender->GetSerial()->printf("Invalid Dec: %s\n", dec.message());
+		return;
+	}
+	char raText[24];
+	char decText[24];
+	ra.value.format(raText, sizeof(raText));
+	dec.value.format(decText, sizeof(decText));
+	sender->GetSerial()->printf("movetoradec: RA{%f, %f, %f}, Dec{%f, %f, %f}\n", ra.value.h, ra.value.m, ra.value.s, dec.value.d, dec.value.m, dec.value.s);
+	sender->GetSerial()->printf("movetoradec: RA: %s, Dec: %s}\n", raText, decText);
+	if (!mount.moveToRADec({ra.value.rad(), dec.value.rad()}, speed)) {
+		sender->GetSerial()->println("Motion queue full");
 	}
 }
 SerialCommand moveToRADecCmd("movetoradec", &moveToRADecCmdCb);
+void stopCmdCb(SerialCommands* sender) {
+	if (!mount.stop()) {
+		sender->GetSerial()->println("Motion queue full");
+	}
+}
+SerialCommand stopCmd("stop", &stopCmdCb);
 void menuCmdCb(SerialCommands* sender) {
 	auto param = sender->Next();
 	if (param == nullptr) {
@@ -150,55 +188,812 @@ void menuCmdCb(SerialCommands* sender) {
 	}
 }
 SerialCommand menuCmd("menu", &menuCmdCb);
+void siteCmdCb(SerialCommands* sender) {
+	auto latitudeStr = sender->Next();
+	if (latitudeStr == nullptr) {
+		sender->GetSerial()->printf("site: lat %f, lon %f (deg)\n", mount.site_.latitude * RAD_TO_DEG, mount.site_.longitude * RAD_TO_DEG);
+		return;
+	}
+
+	auto longitudeStr = sender->Next();
+	if (longitudeStr == nullptr) {
+		sender->GetSerial()->println("Missing longitude (deg, east positive)");
+		return;
+	}
+
+	auto latitude = atof(latitudeStr);
+	auto longitude = atof(longitudeStr);
+	if (latitude < -90 || latitude > 90 || longitude < -180 || longitude > 360) {
+		sender->GetSerial()->println("Invalid site");
+		return;
+	}
+	mount.setSite({latitude * DEG_TO_RAD, longitude * DEG_TO_RAD});
+}
+SerialCommand siteCmd("site", &siteCmdCb);
+void setTimeCmdCb(SerialCommands* sender) {
+	auto secondsStr = sender->Next();
+	if (secondsStr == nullptr) {
+		sender->GetSerial()->println("Missing UTC unix time (s)");
+		return;
+	}
+
+	auto seconds = atof(secondsStr);
+	if (seconds < coords::J2000_UNIX_SECONDS) {
+		sender->GetSerial()->println("Invalid time");
+		return;
+	}
+	if (!mount.setTimeOfDaySeconds(seconds)) {
+		sender->GetSerial()->println("Motion queue full");
+	}
+}
+SerialCommand setTimeCmd("settime", &setTimeCmdCb);
+void horizonCmdCb(SerialCommands* sender) {
+	auto firstStr = sender->Next();
+	if (firstStr == nullptr) {
+		for (std::size_t i = 0; i < coords::HorizonMask::BINS; ++i) {
+			sender->GetSerial()->printf("horizon: az %3.0f alt %3.1f\n", i * coords::HorizonMask::BIN_WIDTH_DEG, sky.horizonMask_.minAltitudeDeg(i));
+		}
+		return;
+	}
+
+	auto secondStr = sender->Next();
+	if (secondStr == nullptr) {
+		// single value sets whole mask
+		sky.horizonMask_.setAll(atof(firstStr));
+		return;
+	}
+	sky.horizonMask_.set(atof(firstStr), atof(secondStr));
+}
+SerialCommand horizonCmd("horizon", &horizonCmdCb);
+void printUtcTime(Stream* serial, const scope::Sky::RiseSetTable& table, int16_t minutes) {
+	if (minutes == coords::RiseSetEntry::NONE) {
+		serial->print("--:--");
+		return;
+	}
+	auto secondsOfDay = static_cast<long>(std::fmod(table.timeAt(minutes), 86400.0));
+	serial->printf("%02ld:%02ld", secondsOfDay / 3600, secondsOfDay / 60 % 60);
+}
+void tonightCmdCb(SerialCommands* sender) {
+	auto minAltitudeStr = sender->Next();
+	if (minAltitudeStr != nullptr) {
+		// table is rebuilt by sky.tick()
+		sky.minAltitudeDeg_ = atof(minAltitudeStr);
+		return;
+	}
 
+	const auto& table = sky.riseSetTable_;
+	auto serial = sender->GetSerial();
+	if (!table.ready()) {
+		serial->println("Rise/set table not ready. Set site and time first.");
+		return;
+	}
+	serial->print("tonight (UTC): dusk ");
+	printUtcTime(serial, table, table.dusk());
+	serial->print(" dawn ");
+	printUtcTime(serial, table, table.dawn());
+	serial->printf(" min alt %.0f\n", table.minAltitudeRad() * RAD_TO_DEG);
+	for (std::size_t i = 0; i < table.size(); ++i) {
+		const auto& entry = table[i];
+		serial->printf("%-24s rise ", sky.object(i).name());
+		printUtcTime(serial, table, entry.rise);
+		serial->print(" transit ");
+		printUtcTime(serial, table, entry.transit);
+		serial->print(" set ");
+		printUtcTime(serial, table, entry.rise == coords::RiseSetEntry::NONE ? coords::RiseSetEntry::NONE : entry.set);
+		serial->printf(" dark above min %dh%02d\n", entry.darkAboveMin / 60, entry.darkAboveMin % 60);
+	}
+}
+SerialCommand tonightCmd("tonight", &tonightCmdCb);
+void displayStatsCmdCb(SerialCommands* sender) {
+	auto argStr = sender->Next();
+	if (argStr != nullptr && strcmp(argStr, "reset") == 0) {
+		display.resetStats();
+		return;
+	}
 
-ButtonProcessor ps4ButtonDown([]() { return PS4.Down(); });
-ButtonProcessor ps4ButtonUp([]() { return PS4.Up(); });
-ButtonProcessor ps4ButtonCross([]() { return PS4.Cross(); });
-ButtonProcessor ps4ButtonCircle([]() { return PS4.Circle(); });
+	const auto& stats = display.stats();
+	auto sent = static_cast<double>(stats.bytesSent);
+	auto total = sent + stats.bytesSaved;
+	sender->GetSerial()->printf("display: frames %lu unchanged %lu dropped %lu tiles %lu\n",
+		static_cast<unsigned long>(stats.frames), static_cast<unsigned long>(stats.unchangedFrames),
+		static_cast<unsigned long>(stats.droppedFrames), static_cast<unsigned long>(stats.tilesSent));
+	sender->GetSerial()->printf("display: bytes sent %lu saved %lu (%.1f%%)\n",
+		static_cast<unsigned long>(stats.bytesSent), static_cast<unsigned long>(stats.bytesSaved), total > 0 ? 100 * stats.bytesSaved / total : 0.0);
+	sender->GetSerial()->printf("display: render %lu us (max %lu), flush %lu us (max %lu), latency %lu us (max %lu)\n",
+		static_cast<unsigned long>(stats.lastRenderUs), static_cast<unsigned long>(stats.maxRenderUs),
+		static_cast<unsigned long>(stats.lastFlushUs), static_cast<unsigned long>(stats.maxFlushUs),
+		static_cast<unsigned long>(stats.lastLatencyUs), static_cast<unsigned long>(stats.maxLatencyUs));
+}
+SerialCommand displayStatsCmd("displaystats", &displayStatsCmdCb);
+void heapCmdCb(SerialCommands* sender) {
+	// largest block shows fragmentation
+	sender->GetSerial()->printf("heap: free %lu, min free %lu, largest block %lu\n",
+		static_cast<unsigned long>(ESP.getFreeHeap()), static_cast<unsigned long>(ESP.getMinFreeHeap()),
+		static_cast<unsigned long>(ESP.getMaxAllocHeap()));
+}
+SerialCommand heapCmd("heap", &heapCmdCb);
+void motionStatsCmdCb(SerialCommands* sender) {
+	auto argStr = sender->Next();
+	if (argStr != nullptr && strcmp(argStr, "reset") == 0) {
+		if (!mount.resetCommandStats()) {
+			sender->GetSerial()->println("Motion queue full");
+		}
+		return;
+	}
+
+	auto stats = mount.commandStats();
+	sender->GetSerial()->printf("motion: commands %lu rejected %lu max queued %lu\n",
+		static_cast<unsigned long>(stats.commands), static_cast<unsigned long>(stats.rejected),
+		static_cast<unsigned long>(stats.maxQueued));
+	sender->GetSerial()->printf("motion: latency %lu us (max %lu), apply %lu us (max %lu)\n",
+		static_cast<unsigned long>(stats.lastLatencyUs), static_cast<unsigned long>(stats.maxLatencyUs),
+		static_cast<unsigned long>(stats.lastApplyUs), static_cast<unsigned long>(stats.maxApplyUs));
+}
+SerialCommand motionStatsCmd("motionstats", &motionStatsCmdCb);
+// tracking error since auto tracking started, arc seconds, with the periodogram
+void trackingStatsCmdCb(SerialCommands* sender) {
+	auto argStr = sender->Next();
+	if (argStr != nullptr && strcmp(argStr, "reset") == 0) {
+		if (!mount.resetTrackingError()) {
+			sender->GetSerial()->println("Motion queue full");
+		}
+		return;
+	}
+
+	const auto& scale = ui::TrackingErrorPage::ARCSEC_PER_STEP;
+	auto summary = scope::TrackingError::summary(mount.trackingError());
+	sender->GetSerial()->printf("tracking: samples %lu over %.1f s\n", static_cast<unsigned long>(summary.samples), summary.durationS);
+	for (std::size_t axis = 0; axis < scope::TrackingError::AXES; ++axis) {
+		sender->GetSerial()->printf("tracking: %c rms %.1f\" peak %.1f\" mean %.1f\"\n", axis == 0 ? 'X' : 'Y',
+			summary.rms[axis] * scale[axis], summary.peak[axis] * scale[axis], summary.mean[axis] * scale[axis]);
+	}
+	for (std::size_t i = 0; i < scope::TrackingError::PERIODS; ++i) {
+		if (summary.amplitudes[0][i] > 0 || summary.amplitudes[1][i] > 0) {
+			sender->GetSerial()->printf("period %7.1f s: X %.2f\" Y %.2f\"\n", scope::TrackingError::period(i),
+				summary.amplitudes[0][i] * scale[0], summary.amplitudes[1][i] * scale[1]);
+		}
+	}
+}
+SerialCommand trackingStatsCmd("trackingstats", &trackingStatsCmdCb);
+void statsCmdCb(SerialCommands* sender) {
+	auto argStr = sender->Next();
+	if (argStr != nullptr && strcmp(argStr, "reset") == 0) {
+		profile::profiler().reset();
+		return;
+	}
+	profile::profiler().print(*sender->GetSerial());
+}
+SerialCommand statsCmd("stats", &statsCmdCb);
+// heap allocations per region, counted while on
+void allocsCmdCb(SerialCommands* sender) {
+	auto argStr = sender->Next();
+	if (argStr == nullptr) {
+		heap::tracker().print(*sender->GetSerial());
+	} else if (strcmp(argStr, "on") == 0 || strcmp(argStr, "off") == 0) {
+		heap::tracker().enable(strcmp(argStr, "on") == 0);
+	} else if (strcmp(argStr, "reset") == 0) {
+		heap::tracker().reset();
+	} else {
+		sender->GetSerial()->println("allocs [on|off|reset]");
+	}
+}
+SerialCommand allocsCmd("allocs", &allocsCmdCb);
+template<std::size_t N>
+int findName(const char* const (&names)[N], const char* name) {
+	for (std::size_t i = 0; i < N; ++i) {
+		if (strcmp(names[i], name) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+// `message` followed by the valid names, "(a,b,c)"
+template<std::size_t N>
+void printInvalidName(Stream* serial, const char* message, const char* const (&names)[N]) {
+	serial->print(message);
+	serial->print(" (");
+	for (std::size_t i = 0; i < N; ++i) {
+		serial->print(i == 0 ? "" : ",");
+		serial->print(names[i]);
+	}
+	serial->println(")");
+}
+void logCmdCb(SerialCommands* sender) {
+	auto& logger = logging::logger();
+	auto serial = sender->GetSerial();
+	auto param = sender->Next();
+	if (param == nullptr) {
+		serial->printf("log: level %s, output %s, written %lu dropped %lu\n",
+			logging::LEVEL_NAMES[static_cast<std::size_t>(logger.level())], logger.output() == logging::Logger::Output::BINARY ? "binary" : "text",
+			static_cast<unsigned long>(logger.written()), static_cast<unsigned long>(logger.dropped()));
+		for (std::size_t i = 0; i <= static_cast<std::size_t>(logging::Category::last); ++i) {
+			serial->printf("log: %s %s\n", logging::CATEGORY_NAMES[i], logger.categoryEnabled(static_cast<logging::Category>(i)) ? "on" : "off");
+		}
+		return;
+	}
+	if (strcmp(param, "text") == 0 || strcmp(param, "binary") == 0) {
+		logger.setOutput(param[0] == 'b' ? logging::Logger::Output::BINARY : logging::Logger::Output::TEXT);
+		return;
+	}
+
+	auto value = sender->Next();
+	if (value == nullptr) {
+		serial->println("Use log [text|binary|level <name>|on <category>|off <category>]");
+		return;
+	}
+	if (strcmp(param, "level") == 0) {
+		auto level = findName(logging::LEVEL_NAMES, value);
+		if (level < 0) {
+			printInvalidName(serial, "Invalid level", logging::LEVEL_NAMES);
+			return;
+		}
+		logger.setLevel(static_cast<logging::Level>(level));
+	} else if (strcmp(param, "on") == 0 || strcmp(param, "off") == 0) {
+		auto category = findName(logging::CATEGORY_NAMES, value);
+		if (category < 0) {
+			printInvalidName(serial, "Invalid category", logging::CATEGORY_NAMES);
+			return;
+		}
+		logger.setCategoryEnabled(static_cast<logging::Category>(category), strcmp(param, "on") == 0);
+	} else {
+		serial->println("Use log [text|binary|level <name>|on <category>|off <category>]");
+	}
+}
+SerialCommand logCmd("log", &logCmdCb);
+void telemetryCmdCb(SerialCommands* sender) {
+	auto& recorder = telemetry::recorder();
+	auto serial = sender->GetSerial();
+	auto param = sender->Next();
+	if (param == nullptr) {
+		for (std::size_t i = 0; i < static_cast<std::size_t>(telemetry::Channel::count); ++i) {
+			serial->printf("telemetry: %s %lu Hz\n", telemetry::CHANNEL_NAMES[i],
+				static_cast<unsigned long>(recorder.rateHz(static_cast<telemetry::Channel>(i))));
+		}
+		serial->printf("telemetry: sent %lu dropped %lu\n",
+			static_cast<unsigned long>(recorder.sent()), static_cast<unsigned long>(recorder.dropped()));
+		return;
+	}
+
+	auto channelStr = sender->Next();
+	if (channelStr == nullptr) {
+		serial->println("Use telemetry [subscribe <channel> <rate Hz>|unsubscribe <channel>]");
+		return;
+	}
+	auto channel = findName(telemetry::CHANNEL_NAMES, channelStr);
+	if (channel < 0) {
+		serial->println("Invalid channel (position,velocity,error,loop,mode)");
+		return;
+	}
+	if (strcmp(param, "unsubscribe") == 0) {
+		recorder.subscribe(static_cast<telemetry::Channel>(channel), 0);
+		return;
+	}
+	if (strcmp(param, "subscribe") != 0) {
+		serial->println("Use telemetry [subscribe <channel> <rate Hz>|unsubscribe <channel>]");
+		return;
+	}
+	auto rateStr = sender->Next();
+	if (rateStr == nullptr) {
+		serial->println("Missing rate (Hz)");
+		return;
+	}
+	auto rate = atoi(rateStr);
+	if (rate < 0) {
+		serial->println("Invalid rate");
+		return;
+	}
+	recorder.subscribe(static_cast<telemetry::Channel>(channel), rate);
+}
+SerialCommand telemetryCmd("telemetry", &telemetryCmdCb);
+scope::ScriptScheduler scheduler;
+// Joins the remaining tokens back to the scheduled command line. `skipUnit` drops a leading "s" token, the unit of
+// a delay written apart ("every 300 s <command>").
+bool remainingCommand(SerialCommands* sender, char* buffer, std::size_t size, bool skipUnit) {
+	std::size_t length = 0;
+	auto token = sender->Next();
+	if (skipUnit && token != nullptr && strcmp(token, "s") == 0) {
+		token = sender->Next();
+	}
+	for (; token != nullptr; token = sender->Next()) {
+		auto count = snprintf(buffer + length, size - length, length == 0 ? "%s" : " %s", token);
+		if (count < 0 || length + count >= size) {
+			return false;
+		}
+		length += count;
+	}
+	return length > 0;
+}
+// `delayStr` is the delay as typed, without a glued unit the command may start with it
+void schedule(SerialCommands* sender, uint32_t delayMs, uint32_t periodMs, const char* delayStr) {
+	char command[scope::ScriptScheduler::COMMAND_SIZE];
+	auto unitApart = delayStr != nullptr && delayStr[strlen(delayStr) - 1] != 's';
+	if (!remainingCommand(sender, command, sizeof(command), unitApart)) {
+		sender->GetSerial()->println("Missing or too long command");
+		return;
+	}
+	auto id = scheduler.add(millis(), delayMs, periodMs, command);
+	if (id == scope::ScriptScheduler::NONE) {
+		sender->GetSerial()->println("Script full");
+		return;
+	}
+	sender->GetSerial()->printf("script %u: %s\n", id, command);
+}
+// seconds with millisecond resolution, optionally with "s" suffix (or an "s" token after it, see schedule())
+bool parseDelayMs(const char* secondsStr, uint32_t& result) {
+	char* end = nullptr;
+	auto seconds = strtod(secondsStr, &end);
+	if (end != secondsStr && *end == 's') {
+		++end;
+	}
+	if (end == secondsStr || *end != '\0' || seconds < 0 || seconds * 1000 > UINT32_MAX / 2) {
+		return false;
+	}
+	result = static_cast<uint32_t>(seconds * 1000 + 0.5);
+	return true;
+}
+void atCmdCb(SerialCommands* sender) {
+	auto timeStr = sender->Next();
+	if (timeStr == nullptr) {
+		sender->GetSerial()->println("Missing UTC time hh:mm:ss");
+		return;
+	}
+	coords::Sexagesimal time;
+	double now = 0;
+	if (coords::parseSexagesimal(timeStr, time) != coords::ParseError::NONE || time.negative
+		|| time.fields[0] >= 24 || time.fields[1] >= 60 || time.fields[2] >= 60) {
+		sender->GetSerial()->println("Invalid time");
+		return;
+	}
+	if (!mount.clockSet() || !scope::Mount::getTimeOfDaySeconds(now)) {
+		sender->GetSerial()->println("Set time first");
+		return;
+	}
+	auto delaySeconds = time.fields[0] * 3600 + time.fields[1] * 60 + time.fields[2] - std::fmod(now, 86400.0);
+	if (delaySeconds < 0) {
+		delaySeconds += 86400;
+	}
+	schedule(sender, static_cast<uint32_t>(delaySeconds * 1000 + 0.5), 0, nullptr);
+}
+SerialCommand atCmd("at", &atCmdCb);
+void inCmdCb(SerialCommands* sender) {
+	auto secondsStr = sender->Next();
+	uint32_t delayMs = 0;
+	if (secondsStr == nullptr || !parseDelayMs(secondsStr, delayMs)) {
+		sender->GetSerial()->println("Missing or invalid delay (s)");
+		return;
+	}
+	schedule(sender, delayMs, 0, secondsStr);
+}
+SerialCommand inCmd("in", &inCmdCb);
+void everyCmdCb(SerialCommands* sender) {
+	auto secondsStr = sender->Next();
+	uint32_t periodMs = 0;
+	if (secondsStr == nullptr || !parseDelayMs(secondsStr, periodMs) || periodMs == 0) {
+		sender->GetSerial()->println("Missing or invalid period (s)");
+		return;
+	}
+	schedule(sender, periodMs, periodMs, secondsStr);
+}
+SerialCommand everyCmd("every", &everyCmdCb);
+void scriptCmdCb(SerialCommands* sender) {
+	auto serial = sender->GetSerial();
+	auto argStr = sender->Next();
+	if (argStr != nullptr && strcmp(argStr, "clear") == 0) {
+		scheduler.clear();
+		return;
+	}
+	if (argStr != nullptr && strcmp(argStr, "cancel") == 0) {
+		auto idStr = sender->Next();
+		if (idStr == nullptr || !scheduler.cancel(atoi(idStr))) {
+			serial->println("Unknown script entry");
+		}
+		return;
+	}
+	auto now = millis();
+	for (uint8_t id = 0; id < scope::ScriptScheduler::MAX_ENTRIES; ++id) {
+		if (!scheduler.used(id)) {
+			continue;
+		}
+		const auto& entry = scheduler.entry(id);
+		auto dueMs = static_cast<int32_t>(entry.deadlineMs - now);
+		serial->printf("script %u: in %.3f s, every %.3f s, fired %lu: %s\n", id, dueMs / 1000.0, entry.periodMs / 1000.0,
+			static_cast<unsigned long>(entry.fired), entry.command.data());
+	}
+}
+SerialCommand scriptCmd("script", &scriptCmdCb);
+// PS4 stick changes below this are not posted, dead zone must not be smaller
+constexpr int STICK_RESOLUTION = 2;
+ui::InputPipeline input(screen, mount);
+void jogCmdCb(SerialCommands* sender) {
+	auto serial = sender->GetSerial();
+	auto argStr = sender->Next();
+	if (argStr == nullptr) {
+		const auto& curve = input.curve();
+		auto stats = input.stats();
+		serial->printf("jog: dead zone %u, expo %.2f, fine %.2f (%s)\n", curve.deadZone, curve.expo, curve.fineScale, input.fine() ? "fine" : "coarse");
+		serial->printf("input: events %lu dropped %lu, latency %lu us (max %lu)\n",
+			static_cast<unsigned long>(stats.events), static_cast<unsigned long>(stats.dropped),
+			static_cast<unsigned long>(stats.lastLatencyUs), static_cast<unsigned long>(stats.maxLatencyUs));
+		return;
+	}
+	if (strcmp(argStr, "reset") == 0) {
+		input.resetStats();
+		return;
+	}
+	auto valueStr = sender->Next();
+	if (valueStr == nullptr) {
+		serial->println("Usage: jog [deadzone <0-100>|expo <0-1>|fine <0-1>|reset]");
+		return;
+	}
+	auto value = atof(valueStr);
+	auto curve = input.curve();
+	if (strcmp(argStr, "deadzone") == 0 && value >= STICK_RESOLUTION && value <= 100) {
+		curve.deadZone = value;
+	} else if (strcmp(argStr, "expo") == 0 && value >= 0 && value <= 1) {
+		curve.expo = value;
+	} else if (strcmp(argStr, "fine") == 0 && value > 0 && value <= 1) {
+		curve.fineScale = value;
+	} else {
+		serial->println("Invalid jog setting");
+		return;
+	}
+	input.setCurve(curve);
+}
+SerialCommand jogCmd("jog", &jogCmdCb);
+void guideCmdCb(SerialCommands* sender) {
+	auto serial = sender->GetSerial();
+	auto argStr = sender->Next();
+	if (argStr == nullptr) {
+		auto state = mount.state();
+		auto stats = state.guideStats;
+		serial->printf("guide: rate %.2f, pulsing %s%s, offset %.2f, %.2f steps\n", state.guideRate,
+			state.guidingX ? "X" : "", state.guidingY ? "Y" : "", state.guideOffsetX, state.guideOffsetY);
+		serial->printf("guide: pulses %lu dropped %lu ignored %lu\n", static_cast<unsigned long>(stats.pulses),
+			static_cast<unsigned long>(stats.dropped), static_cast<unsigned long>(stats.ignored));
+		return;
+	}
+	if (strcmp(argStr, "reset") == 0) {
+		if (!mount.resetGuideStats()) {
+			serial->println("Motion queue full");
+		}
+		return;
+	}
+	auto valueStr = sender->Next();
+	if (valueStr == nullptr) {
+		serial->println("Usage: guide [n|s|e|w <ms>|rate <0-1>|reset]");
+		return;
+	}
+	auto value = atof(valueStr);
+	if (strcmp(argStr, "rate") == 0) {
+		if (value <= 0 || value > 1 || !mount.setGuideRate(value)) {
+			serial->println("Invalid guide rate");
+		}
+		return;
+	}
+	const char* const directions[] = {"n", "s", "e", "w"};
+	auto direction = findName(directions, argStr);
+	if (direction < 0 || value <= 0 || value > scope::Mount::MAX_GUIDE_PULSE_MS) {
+		serial->println("Invalid guide pulse");
+		return;
+	}
+	// fractional ms keep microsecond precision
+	if (!mount.guide(static_cast<scope::Mount::GuideDirection>(direction), std::lround(value * 1000))) {
+		serial->println("Motion queue full");
+	}
+}
+SerialCommand guideCmd("guide", &guideCmdCb);
+// Trace of serial, controller and clock input, see Trace.h. TRACE_MODE_PATH holds "record" to record every
+// boot, keeping the previous boot's trace, or "replay <path>" to replay once on the next boot.
+constexpr const char* TRACE_MODE_PATH = "/trace.mode";
+constexpr const char* TRACE_PATH = "/trace.bin";
+constexpr const char* PREVIOUS_TRACE_PATH = "/trace.prev.bin";
+constexpr std::size_t TRACE_MODE_SIZE = 48;
+trace::Replayer replayer;
+// UI task only
+bool replaying = false;
+bool readTraceMode(char (&mode)[TRACE_MODE_SIZE]) {
+	mode[0] = '\0';
+	if (!LittleFS.exists(TRACE_MODE_PATH)) {
+		return false;
+	}
+	auto file = LittleFS.open(TRACE_MODE_PATH, "r");
+	if (!file) {
+		return false;
+	}
+	std::size_t length = 0;
+	for (int byte = file.read(); byte >= 0 && byte != '\n' && length + 1 < TRACE_MODE_SIZE; byte = file.read()) {
+		mode[length++] = byte;
+	}
+	mode[length] = '\0';
+	return length > 0;
+}
+bool writeTraceMode(const char* mode) {
+	auto file = LittleFS.open(TRACE_MODE_PATH, "w");
+	return file && file.printf("%s\n", mode) > 0;
+}
+void printReplayStats(Stream* serial) {
+	const auto& stats = replayer.stats();
+	serial->printf("trace: replayed %lu records, checkpoints %lu diverged %lu", static_cast<unsigned long>(stats.records),
+		static_cast<unsigned long>(stats.checkpoints), static_cast<unsigned long>(stats.diverged));
+	if (stats.diverged > 0) {
+		serial->printf(" (first at %.3f s, max %lu steps)", stats.firstDivergenceMs / 1000.0, static_cast<unsigned long>(stats.maxDivergenceSteps));
+	}
+	serial->printf(", lost %lu%s\n", static_cast<unsigned long>(stats.lost), stats.corrupt ? ", trace damaged" : "");
+}
+// UI task, before input is read: hands the records due now to the firmware
+void replayDue() {
+	if (!replaying) {
+		return;
+	}
+	trace::Record record;
+	while (replayer.poll(micros(), record)) {
+		switch (record.kind) {
+			case trace::Kind::CLOCK: {
+				// the recorded clock, moved on by the time the record waited for this poll
+				auto epochUs = record.values[0] + static_cast<uint32_t>(micros() - record.timestampUs);
+				timeval tv;
+				tv.tv_sec = static_cast<time_t>(epochUs / 1000000);
+				tv.tv_usec = static_cast<suseconds_t>(epochUs % 1000000);
+				settimeofday(&tv, nullptr);
+				break;
+			}
+			case trace::Kind::INPUT_EVENT:
+				input.post(record.input());
+				break;
+			case trace::Kind::CHECKPOINT: {
+				auto state = mount.state();
+				replayer.verify(record, state.positionX, state.positionY);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+	if (!replayer.active()) {
+		replaying = false;
+		serialTap.replayFrom(nullptr);
+		printReplayStats(&Serial);
+	}
+}
+// setup(), before the controller and the UI task start
+void startTrace() {
+	// formats the partition on first use, takes a few seconds
+	if (!LittleFS.begin(true)) {
+		Serial.println("LittleFS not mounted, no trace");
+		return;
+	}
+	char mode[TRACE_MODE_SIZE];
+	if (!readTraceMode(mode)) {
+		return;
+	}
+	if (strcmp(mode, "record") == 0) {
+		if (LittleFS.exists(TRACE_PATH)) {
+			LittleFS.remove(PREVIOUS_TRACE_PATH);
+			LittleFS.rename(TRACE_PATH, PREVIOUS_TRACE_PATH);
+		}
+		timeval now;
+		gettimeofday(&now, nullptr);
+		auto file = LittleFS.open(TRACE_PATH, "w");
+		if (!file || !trace::recorder().begin(file, micros(), static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_usec)) {
+			Serial.println("Trace recording not started");
+		}
+	} else if (strncmp(mode, "replay ", 7) == 0) {
+		// once, a replay that brings the board down must not do it again
+		LittleFS.remove(TRACE_MODE_PATH);
+		auto file = LittleFS.open(mode + 7, "r");
+		if (!file || !replayer.begin(file, micros())) {
+			Serial.printf("Trace replay of %s not started\n", mode + 7);
+			return;
+		}
+		replaying = true;
+		serialTap.replayFrom(&replayer);
+		replayDue();
+	}
+}
+void traceCmdCb(SerialCommands* sender) {
+	auto serial = sender->GetSerial();
+	auto& recorder = trace::recorder();
+	auto argStr = sender->Next();
+	if (argStr == nullptr) {
+		char mode[TRACE_MODE_SIZE];
+		serial->printf("trace: next boot %s\n", readTraceMode(mode) ? mode : "off");
+		if (recorder.active() || recorder.records() > 0) {
+			serial->printf("trace: %s, records %lu bytes %lu dropped %lu%s\n", recorder.active() ? "recording" : "stopped",
+				static_cast<unsigned long>(recorder.records()), static_cast<unsigned long>(recorder.bytes()),
+				static_cast<unsigned long>(recorder.dropped()), recorder.full() ? ", file full" : "");
+		}
+		if (replaying || replayer.stats().records > 0) {
+			printReplayStats(serial);
+		}
+		return;
+	}
+	// the replayed trace may hold trace commands, they must not change what it replays
+	if (replaying) {
+		serial->println("Replay running");
+		return;
+	}
+	if (strcmp(argStr, "record") == 0) {
+		if (!writeTraceMode("record")) {
+			serial->println("Can not write trace mode");
+			return;
+		}
+		serial->println("trace: recording from next boot");
+	} else if (strcmp(argStr, "replay") == 0) {
+		auto which = sender->Next();
+		auto path = which != nullptr && strcmp(which, "prev") == 0 ? PREVIOUS_TRACE_PATH : TRACE_PATH;
+		char mode[TRACE_MODE_SIZE];
+		snprintf(mode, sizeof(mode), "replay %s", path);
+		if (!LittleFS.exists(path)) {
+			serial->printf("No trace %s\n", path);
+			return;
+		}
+		if (!writeTraceMode(mode)) {
+			serial->println("Can not write trace mode");
+			return;
+		}
+		serial->printf("trace: replaying %s on next boot\n", path);
+	} else if (strcmp(argStr, "off") == 0) {
+		LittleFS.remove(TRACE_MODE_PATH);
+		recorder.stop();
+	} else {
+		serial->println("Usage: trace [record|replay [prev]|off]");
+	}
+}
+SerialCommand traceCmd("trace", &traceCmdCb);
+// Runs the benchmark suite on the UI task, input and display wait until it finishes (about a second)
+void benchCmdCb(SerialCommands* sender) {
+	// the suite moves its mount, these steppers drive no pins
+	static AccelStepper benchStepperX([]() {}, []() {});
+	static AccelStepper benchStepperY([]() {}, []() {});
+	static scope::Mount benchMount(benchStepperX, benchStepperY);
+	bench::Fixture fixture = {u8g2, benchMount, sky, screen};
+	bench::Runner::Options options;
+	options.platform = "esp32";
+	options.clock = []() -> uint32_t { return ESP.getCycleCount(); };
+	options.nsPerTick = 1000.0 / ESP.getCpuFreqMHz();
+	options.filter = sender->Next();
+	// lets the idle task feed the watchdog
+	options.pause = []() { vTaskDelay(1); };
+	bench::Runner runner(*sender->GetSerial(), options);
+	bench::runSuite(runner, fixture);
+	screen.invalidate();
+	if (runner.completed() == 0) {
+		sender->GetSerial()->println("No benchmark matches");
+	}
+}
+SerialCommand benchCmd("bench", &benchCmdCb);
+// Bluetooth task. The controller is not listened to during a replay, its events come from the trace.
+bool postInput(ui::InputEvent event) {
+	if (replayer.active() || !input.post(event)) {
+		return false;
+	}
+	trace::recorder().input(micros(), event);
+	return true;
+}
+void postButton(ui::Button button, bool down, bool up) {
+	if (down) {
+		postInput({ui::InputEvent::Kind::BUTTON_DOWN, button});
+	}
+	if (up) {
+		postInput({ui::InputEvent::Kind::BUTTON_UP, button});
+	}
+}
+// Bluetooth task, for every controller report
+void onPs4Report() {
+	profile::Scope scope(profile::Probe::PS4);
+	const auto& down = PS4.event.button_down;
+	const auto& up = PS4.event.button_up;
+	postButton(ui::Button::UP, down.up, up.up);
+	postButton(ui::Button::DOWN, down.down, up.down);
+	postButton(ui::Button::CROSS, down.cross, up.cross);
+	postButton(ui::Button::CIRCLE, down.circle, up.circle);
+	postButton(ui::Button::L1, down.l1, up.l1);
+
+	static int8_t lastX = 0;
+	static int8_t lastY = 0;
+	int8_t x = PS4.LStickX();
+	int8_t y = PS4.RStickY();
+	auto changed = [](int8_t value, int8_t last) {
+		return value != last && (value == 0 || abs(value - last) >= STICK_RESOLUTION);
+	};
+	if ((changed(x, lastX) || changed(y, lastY)) && postInput({ui::InputEvent::Kind::STICKS, ui::Button::count, x, y})) {
+		lastX = x;
+		lastY = y;
+	}
+}
+void onPs4Disconnect() {
+	postInput({ui::InputEvent::Kind::DISCONNECTED, ui::Button::count});
+}
+
+
+// serial, PS4, screen and sky timers
+constexpr uint32_t UI_TASK_STACK_SIZE = 8192;
+constexpr UBaseType_t UI_TASK_PRIORITY = 1;
+constexpr BaseType_t UI_TASK_CORE = 0;
+void uiTaskMain(void*) {
+	for (;;) {
+		replayDue();
+		{
+			profile::Scope scope(profile::Probe::INPUT_EVENTS);
+			heap::Region region(heap::RegionId::INPUT_EVENTS);
+			input.process(millis());
+		}
+		{
+			profile::Scope scope(profile::Probe::SCRIPTS);
+			heap::Region region(heap::RegionId::SCRIPTS);
+			// fired commands are read as typed lines below
+			scheduler.run(millis(), [](uint8_t id, const char* command) {
+				if (!serialDemux.inject(command)) {
+					return false;
+				}
+				LOG(SCRIPT_FIRED, id);
+				return true;
+			});
+		}
+		{
+			profile::Scope scope(profile::Probe::SERIAL_READ);
+			heap::Region region(heap::RegionId::COMMAND);
+			// every tick, LX200 clients expect a quick reply
+			serialCommands.ReadSerial();
+			serialTap.commit();
+		}
+		timer.tick();
+		// lets the idle task on this core feed the watchdog
+		vTaskDelay(1);
+	}
+}
 
 
 void setup() {
 	Serial.begin(115200);
+	if (!logging::logger().begin(Serial)) {
+		Serial.println("Log task not started");
+	}
+	if (!telemetry::recorder().begin(Serial)) {
+		Serial.println("Telemetry task not started");
+	}
+	startTrace();
 	u8g2.begin();
+	if (!display.begin()) {
+		Serial.println("Display task not started");
+	}
 	// Sometimes it happens that PS4 will blink couple times and switchoff - this means flash needs to be cleared
 	// $ python -m esptool --port COM3 erase_flash
+	PS4.attach(&onPs4Report);
+	PS4.attachOnDisconnect(&onPs4Disconnect);
 	PS4.begin("d8:fb:5e:69:d4:6a");
 	stepper1.setPinsInverted(true, false, false);
 	stepper2.setPinsInverted(true, false, false);
 
-	// Read serial
-	timer.every(20, [](void*) -> bool {
-		serialCommands.ReadSerial();
-		return true;
-	});
-
-	timer.every(50, [&u8g2, &screen](void*) -> bool {
-		u8g2.clearBuffer();
+	// polling is cheap, frame is drawn only when something on the screen changed
+	timer.every(20, [&display, &screen](void*) -> bool {
+		heap::Region region(heap::RegionId::SCREEN);
+		if (!screen.needsRedraw(millis())) {
+			return true;
+		}
+		profile::Scope scope(profile::Probe::DRAW);
+		display.beginFrame();
 		screen.draw();
-		u8g2.sendBuffer();
+		if (!display.submit()) {
+			screen.invalidate();
+		}
 		return true;
 	});
 
-	timer.every(ButtonProcessor::PS4_READ_INTERVAL_MS, [&mount](void*) -> bool {
-		if (!PS4.isConnected()) {
-			return true;
-		}
-		if (ps4ButtonDown()) { screen.down(); }
-		if (ps4ButtonUp()) { screen.up(); }
-		if (ps4ButtonCross()) { screen.enter(); }
-		if (ps4ButtonCircle()) { screen.exit(); }
-
-		// set speed with deadzone
-		auto speedX = abs(PS4.LStickX()) >= 10 ? PS4.LStickX() : 0;
-		auto speedY = abs(PS4.RStickY()) >= 10 ? PS4.RStickY() : 0;
-		mount.manualControlSetSpeed({speedX, speedY});
-
+	timer.every(100, [](void*) -> bool {
+		profile::Scope scope(profile::Probe::SKY);
+		heap::Region region(heap::RegionId::TIMER);
+		sky.tick();
 		return true;
 	});
 
-	timer.every(200, [&mount](void*) -> bool {
-		mount.computeAutoTrackCoords();
+	// replay compares its positions with these
+	timer.every(1000, [](void*) -> bool {
+		heap::Region region(heap::RegionId::TIMER);
+		if (trace::recorder().recording()) {
+			auto state = mount.state();
+			trace::recorder().checkpoint(micros(), state.positionX, state.positionY);
+		}
 		return true;
 	});
 
@@ -206,10 +1001,36 @@ void setup() {
 	serialCommands.AddCommand(&moveToCmd);
 	serialCommands.AddCommand(&moveToDegCmd);
 	serialCommands.AddCommand(&moveToRADecCmd);
+	serialCommands.AddCommand(&stopCmd);
 	serialCommands.AddCommand(&menuCmd);
+	serialCommands.AddCommand(&siteCmd);
+	serialCommands.AddCommand(&setTimeCmd);
+	serialCommands.AddCommand(&horizonCmd);
+	serialCommands.AddCommand(&tonightCmd);
+	serialCommands.AddCommand(&displayStatsCmd);
+	serialCommands.AddCommand(&heapCmd);
+	serialCommands.AddCommand(&motionStatsCmd);
+	serialCommands.AddCommand(&statsCmd);
+	serialCommands.AddCommand(&allocsCmd);
+	serialCommands.AddCommand(&trackingStatsCmd);
+	serialCommands.AddCommand(&logCmd);
+	serialCommands.AddCommand(&telemetryCmd);
+	serialCommands.AddCommand(&atCmd);
+	serialCommands.AddCommand(&inCmd);
+	serialCommands.AddCommand(&everyCmd);
+	serialCommands.AddCommand(&scriptCmd);
+	serialCommands.AddCommand(&jogCmd);
+	serialCommands.AddCommand(&guideCmd);
+	serialCommands.AddCommand(&traceCmd);
+	serialCommands.AddCommand(&benchCmd);
+
+	// loop() keeps core 1 for stepping, everything else talks to the mount through its command queue
+	if (xTaskCreatePinnedToCore(&uiTaskMain, "ui", UI_TASK_STACK_SIZE, nullptr, UI_TASK_PRIORITY, nullptr, UI_TASK_CORE) != pdPASS) {
+		Serial.println("UI task not started");
+	}
 }
 
 void loop() {
+	heap::Region region(heap::RegionId::MOTION);
 	mount.tick();
-	timer.tick();
 }
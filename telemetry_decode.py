@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+# Decodes telemetry frames (`telemetry subscribe <channel> <rate>` serial command) using the channel table in
+# Telemetry.h. Other bytes on the link (command replies, log) are skipped.
+#
+# python telemetry_decode.py capture.bin
+# python telemetry_decode.py capture.bin --csv tuning     (tuning_position.csv, tuning_velocity.csv, ...)
+# python telemetry_decode.py /dev/ttyUSB0 --plot          (needs pyserial and matplotlib, plots on Ctrl-C)
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+FRAME_START = 0x5A
+HEADER_SIZE = 1 + 1 + 4
+VALUE_SIZE = 4
+MAX_VALUES = 4
+CHANNEL = re.compile(r'X\((\w+),\s*"(\w+)",\s*"([if]*)",\s*"([\w ]*)"\)')
+
+
+def load_channels(path):
+    with open(path, encoding='utf-8') as f:
+        text = f.read()
+    table = text[text.index('#define TELEMETRY_CHANNELS(X)'):]
+    table = table[:table.index('\n\n')]
+    return [(name, types, values.split()) for _, name, types, values in CHANNEL.findall(table)]
+
+
+def decode(data, channels, on_sample):
+    """Calls on_sample(channel index, timestamp us, values) for complete frames, returns bytes not consumed yet."""
+    i = 0
+    while i < len(data):
+        if data[i] != FRAME_START:
+            i += 1
+            continue
+        if len(data) - i < 1 + HEADER_SIZE:
+            break
+        channel, count, timestamp = struct.unpack_from('<BBI', data, i + 1)
+        if channel >= len(channels) or count != len(channels[channel][1]) or count > MAX_VALUES:
+            i += 1
+            continue
+        size = 1 + HEADER_SIZE + count * VALUE_SIZE + 1
+        if len(data) - i < size:
+            break
+        frame = data[i:i + size]
+        if sum(frame[1:-1]) & 0xFF != frame[-1]:
+            i += 1
+            continue
+        types = channels[channel][1]
+        values = struct.unpack_from('<' + types, frame, 1 + HEADER_SIZE)
+        on_sample(channel, timestamp, values)
+        i += size
+    return data[i:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode telemetry frames')
+    parser.add_argument('input', help='capture file, serial port or - for stdin')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--table', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'Telemetry.h'))
+    parser.add_argument('--csv', metavar='PREFIX', help='write <PREFIX>_<channel>.csv instead of printing')
+    parser.add_argument('--plot', action='store_true', help='plot received channels when input ends')
+    args = parser.parse_args()
+
+    channels = load_channels(args.table)
+    samples = [[] for _ in channels]
+    csv_files = {}
+
+    def on_sample(channel, timestamp, values):
+        name, _, value_names = channels[channel]
+        samples[channel].append((timestamp, values))
+        if args.csv:
+            if channel not in csv_files:
+                csv_files[channel] = open('%s_%s.csv' % (args.csv, name), 'w')
+                csv_files[channel].write('timestamp_us,' + ','.join(value_names) + '\n')
+            csv_files[channel].write('%d,' % timestamp + ','.join(str(v) for v in values) + '\n')
+        elif not args.plot:
+            print('%10.6f %-9s %s' % (timestamp / 1e6, name, ' '.join('%s=%s' % (n, v) for n, v in zip(value_names, values))))
+
+    is_file = args.input == '-' or os.path.isfile(args.input)
+    if args.input == '-':
+        source = sys.stdin.buffer
+    elif is_file:
+        source = open(args.input, 'rb')
+    else:
+        import serial
+        source = serial.Serial(args.input, args.baud, timeout=0.1)
+
+    pending = b''
+    try:
+        while True:
+            chunk = source.read(256)
+            if not chunk:
+                if is_file:
+                    break
+                continue
+            pending = decode(pending + chunk, channels, on_sample)
+    except KeyboardInterrupt:
+        pass
+    for f in csv_files.values():
+        f.close()
+
+    if args.plot:
+        import matplotlib.pyplot as plt
+        received = [n for n, s in enumerate(samples) if s]
+        if not received:
+            return
+        _, axes = plt.subplots(len(received), 1, sharex=True, squeeze=False)
+        for axis, channel in zip(axes[:, 0], received):
+            name, _, value_names = channels[channel]
+            times = [t / 1e6 for t, _ in samples[channel]]
+            for n, value_name in enumerate(value_names):
+                axis.plot(times, [v[n] for _, v in samples[channel]], label=value_name)
+            axis.set_ylabel(name)
+            axis.legend(loc='upper right')
+        axes[-1, 0].set_xlabel('time (s)')
+        plt.show()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+# Prints a trace of the firmware's input (`trace record` serial command, see Trace.h). Fetch /trace.bin or
+# /trace.prev.bin from the board's LittleFS partition, or record one with the simulator (sim/README.md).
+#
+# python trace_decode.py trace.bin
+# python trace_decode.py trace.bin --serial     (serial input only, as typed)
+
+import argparse
+import datetime
+import sys
+
+MAGIC = b'STRC'
+VERSION = 1
+KINDS = ['clock', 'serial', 'input', 'checkpoint', 'lost']
+# ui::InputEvent::Kind and ui::Button in InputEvents.h
+INPUT_KINDS = ['down', 'up', 'sticks', 'disconnected']
+BUTTONS = ['up', 'down', 'cross', 'circle', 'l1']
+
+
+def read_varint(data, i):
+    value = 0
+    shift = 0
+    while True:
+        if i >= len(data):
+            raise ValueError('truncated varint')
+        byte = data[i]
+        i += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, i
+
+
+def read_signed(data, i):
+    value, i = read_varint(data, i)
+    return (value >> 1) ^ -(value & 1), i
+
+
+def records(data):
+    """Yields (time us since start, kind name, payload), raises ValueError on a damaged trace."""
+    if data[:len(MAGIC)] != MAGIC or len(data) <= len(MAGIC) or data[len(MAGIC)] != VERSION:
+        raise ValueError('not a trace of version %d' % VERSION)
+    i = len(MAGIC) + 1
+    time_us = 0
+    while i < len(data):
+        kind = data[i]
+        if kind >= len(KINDS):
+            raise ValueError('unknown record kind %d at offset %d' % (kind, i))
+        delta, i = read_signed(data, i + 1)
+        time_us += delta
+        name = KINDS[kind]
+        if name == 'clock':
+            payload, i = read_signed(data, i)
+        elif name == 'serial':
+            length = data[i]
+            payload = bytes(data[i + 1:i + 1 + length])
+            i += 1 + length
+        elif name == 'input':
+            payload = tuple(data[i:i + 4])
+            i += 4
+        elif name == 'checkpoint':
+            x, i = read_signed(data, i)
+            y, i = read_signed(data, i)
+            payload = (x, y)
+        else:
+            payload, i = read_varint(data, i)
+        if i > len(data):
+            raise ValueError('truncated record')
+        yield time_us, name, payload
+
+
+def describe(name, payload):
+    if name == 'clock':
+        return datetime.datetime.fromtimestamp(payload / 1e6, datetime.timezone.utc).isoformat()
+    if name == 'serial':
+        return repr(payload.decode('latin-1'))
+    if name == 'input':
+        kind, button, x, y = payload
+        signed = lambda v: v - 256 if v > 127 else v
+        if INPUT_KINDS[kind] == 'sticks':
+            return 'sticks x=%d y=%d' % (signed(x), signed(y))
+        if INPUT_KINDS[kind] == 'disconnected':
+            return 'disconnected'
+        return '%s %s' % (BUTTONS[button] if button < len(BUTTONS) else button, INPUT_KINDS[kind])
+    if name == 'checkpoint':
+        return 'x=%d y=%d' % payload
+    return '%d records dropped' % payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Print a firmware input trace')
+    parser.add_argument('input', help='trace file')
+    parser.add_argument('--serial', action='store_true', help='write the serial input only')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    try:
+        for time_us, name, payload in records(data):
+            if args.serial:
+                if name == 'serial':
+                    sys.stdout.buffer.write(payload)
+            else:
+                print('%12.6f %-10s %s' % (time_us / 1e6, name, describe(name, payload)))
+    except ValueError as e:
+        sys.exit('%s: %s' % (args.input, e))
+
+
+if __name__ == '__main__':
+    main()